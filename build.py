@@ -28,6 +28,7 @@ def parse_arg():
   parser.add_option("--power", action="store_true", dest="power", default=False, help="EI Power")
   parser.add_option("--iris", action="store_true", dest="iris", default=False, help="IRIS")
   parser.add_option("--ramulator", action="store_true", dest="ramulator", default=False, help="Ramulator")
+  parser.add_option("--knob-params", action="store", dest="knob_params", default="", help="fix knob values of the params file at build time")
 
   return parser
 
@@ -82,6 +83,9 @@ def main():
   if options.val:
     cmd += 'val=1 '
 
+  if options.knob_params:
+    cmd += 'knob_params=%s ' % options.knob_params
+
   ## External libraries (dramsim, ei, iris)
   # DRAMSim2
   if options.dramsim:
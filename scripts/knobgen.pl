@@ -1,5 +1,7 @@
 #!/usr/bin/perl -w
 #knobgen.pl for use with componentMACSIM
+#usage: perl knobgen.pl [params file]
+#  with a params file, its (non-string) knob values become compile-time constants
 
 use File::stat;
 use Time::localtime;
@@ -18,6 +20,12 @@ my @headerDeclares = ();
 my @constructors = ();
 my @registerCalls = ();
 my @deconstructs = ();
+my @fixedDefines = ();
+my @fixedChecks = ();
+
+# knobs fixed at build time (perl knobgen.pl <params file>)
+my $fixedFile = (scalar(@ARGV) > 0) ? $ARGV[0] : "";
+my %fixedValues = ();
 
 ##### START #####
 
@@ -41,6 +49,20 @@ if (-e $allknobs_c) {
     }
   }
 
+  # rebuild when fixed knobs are switched on/off or their params file changed
+  if ($fixedFile ne "" && $timestamp < stat($fixedFile)->mtime) {
+    $def_file_changed = 1;
+  }
+
+  if (-e $allknobs_h) {
+    open(ALLKNOBS_H, "<$allknobs_h") || die("Can not open file $allknobs_h\n");
+    my @header = <ALLKNOBS_H>;
+    close(ALLKNOBS_H);
+    if (!grep(/^\/\/ fixed knobs: \Q$fixedFile\E$/, @header)) {
+      $def_file_changed = 1;
+    }
+  }
+
   if ($def_file_changed == 0) {
     exit 0;
   }
@@ -56,6 +78,10 @@ open(ALLKNOBS_H, ">$allknobs_h") || die("Can not open file $allknobs_h\n");
 
 
 
+if ($fixedFile ne "") {
+  parseFixedFile($fixedFile);
+}
+
 foreach my $file (@files) {
   parseFile($file);
 }
@@ -124,6 +150,48 @@ sub parseFile
 }
 
 
+################################################################################
+# read knob values to fix at build time, in the params.in format
+# (first value wins, same as KnobsContainer::createEntryFromtext)
+sub parseFixedFile
+{
+  my ($file) = @_;
+
+  print "fixing knobs from: $file\n";
+
+  open(FIXEDFILE, "<$file") || die("Can not open file $file\n");
+  foreach my $line (<FIXEDFILE>) {
+    my @tokens = split(' ', $line);
+    if (scalar(@tokens) < 2 || $tokens[0] =~ /^#/) {
+      next;
+    }
+    if (!exists($fixedValues{$tokens[0]})) {
+      $fixedValues{$tokens[0]} = $tokens[1];
+    }
+  }
+  close(FIXEDFILE);
+}
+
+
+################################################################################
+# C++ literal for a fixed knob value, parsed as KnobTemplate::initFromString does
+sub fixedLiteral
+{
+  my ($datatype, $value) = @_;
+
+  if ($datatype =~ /^(float|double)$/) {
+    if ($value =~ /^([-+]?(\d+\.?\d*|\.\d+)([eE][-+]?\d+)?)/) {
+      return $1;
+    }
+  }
+  elsif ($value =~ /^([-+]?\d+)/) {
+    return $1;
+  }
+
+  return "";
+}
+
+
 ################################################################################
 sub processLine
 {
@@ -162,7 +230,28 @@ sub processLine
     push(@names, "knob_".$elements[0]);
     push(@values, $defaultvalue);
 
-    
+    # fixed knob : constant value, runtime knob kept only to detect overrides
+    my $literal = "";
+    if (exists($fixedValues{$paramfileentry}) && $datatype ne "string") {
+      $literal = fixedLiteral($datatype, $fixedValues{$paramfileentry});
+      if ($literal eq "") {
+        print "knob $paramfileentry: cannot fix value $fixedValues{$paramfileentry}\n";
+      }
+    }
+
+    if ($literal ne "") {
+      my $constType = "KnobConstant< $datatype >";
+      push(@headerDeclares, "static constexpr $constType ${KnobName}_VALUE = $constType(static_cast< $datatype >($literal));\n");
+      push(@headerDeclares, "static constexpr const $constType* $KnobName = &${KnobName}_VALUE;\n");
+      push(@fixedDefines,   "constexpr $constType all_knobs_c::${KnobName}_VALUE;\n");
+      push(@fixedDefines,   "constexpr const $constType* all_knobs_c::$KnobName;\n");
+      push(@fixedChecks,    "if (${KnobName}_RUNTIME->getValue() != $KnobName->getValue()) {\n");
+      push(@fixedChecks,    "\tcout << \"Knob '${paramfileentry}' is fixed to $fixedValues{$paramfileentry} in this build\" << endl;\n");
+      push(@fixedChecks,    "\tresult = false;\n");
+      push(@fixedChecks,    "}\n");
+      $KnobName = $KnobName."_RUNTIME";
+    }
+
     push(@headerDeclares, "KnobTemplate< $datatype >* $KnobName;\n");
     push(@registerCalls,  "container->insertKnob( $KnobName );\n");
     push(@deconstructs,   "delete $KnobName;\n");
@@ -192,6 +281,14 @@ sub writeSource
 {
   print ALLKNOBS_C "#include \"all_knobs.h\"\n\n";
   print ALLKNOBS_C "#include <string>\n\n";
+
+  #fixed knob definitions
+  foreach $define (@fixedDefines) {
+    print ALLKNOBS_C "$define";
+  }
+  if (scalar(@fixedDefines) > 0) {
+    print ALLKNOBS_C "\n";
+  }
   
   #constructor
   print ALLKNOBS_C "all_knobs_c::all_knobs_c() {\n";
@@ -215,6 +312,16 @@ sub writeSource
     print ALLKNOBS_C "\t$registerCall";
   }
   print ALLKNOBS_C "}\n\n";
+
+
+  #checkFixedKnobs function
+  print ALLKNOBS_C "bool all_knobs_c::checkFixedKnobs() {\n";
+  print ALLKNOBS_C "\tbool result = true;\n";
+  foreach $fixedCheck (@fixedChecks) {
+    print ALLKNOBS_C "\t$fixedCheck";
+  }
+  print ALLKNOBS_C "\treturn result;\n";
+  print ALLKNOBS_C "}\n\n";
   
 }
 ################################################################################
@@ -224,6 +331,7 @@ sub writeHeader
 {
   print ALLKNOBS_H "#ifndef __ALL_KNOBS_H_INCLUDED__\n";
   print ALLKNOBS_H "#define __ALL_KNOBS_H_INCLUDED__\n\n";
+  print ALLKNOBS_H "// fixed knobs: $fixedFile\n\n";
   
   print ALLKNOBS_H "#include \"global_types.h\"\n";
   print ALLKNOBS_H "#include \"knob.h\"\n\n";
@@ -249,6 +357,10 @@ sub writeHeader
   print ALLKNOBS_H "\t\t * Register Knob Variables\n";
   print ALLKNOBS_H "\t\t */\n";
   print ALLKNOBS_H "\t\tvoid registerKnobs(KnobsContainer *container);\n\n";
+  print ALLKNOBS_H "\t\t/**\n";
+  print ALLKNOBS_H "\t\t * Check that knobs fixed at build time were not overridden\n";
+  print ALLKNOBS_H "\t\t */\n";
+  print ALLKNOBS_H "\t\tbool checkFixedKnobs();\n\n";
   
   print ALLKNOBS_H "\tpublic:\n";
   foreach $vardef (@headerDeclares) {
@@ -350,7 +350,7 @@ sub processLine
 					defineDistributionMember($StatName);
 				}
 				else {
-					if(($StatType eq "RATIO") or ($StatType eq "PERCENT")) {
+					if(($StatType eq "RATIO") or ($StatType eq "PERCENT") or ($StatType eq "PER_1000_INST")) {
 						$field_3 = $elements[2];
 						$field_3 =~ s/\s*//g;
 
@@ -373,7 +373,7 @@ sub processLine
 					defineDistributionMember($StatName);
 				}
 				else {
-					if (($StatType eq "RATIO") or ($StatType eq "PERCENT")) {
+					if (($StatType eq "RATIO") or ($StatType eq "PERCENT") or ($StatType eq "PER_1000_INST")) {
 						$field_3 = $elements[2];
 						$field_3 =~ s/\s*//g;
 
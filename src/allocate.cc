@@ -99,6 +99,84 @@ allocate_c::allocate_c(int core_id, pqueue_c<int *> *q_frontend, pqueue_c<int> *
 }
 
 
+// check rob and other physical resources of an uop : returns the allocation queue type,
+// or -1 if resources are not available
+int allocate_c::check_resources(uop_c* uop, int* req_sb, int* req_lb, int* req_int_reg, 
+    int* req_fp_reg)
+{
+  int req_rob      = 1;        // require rob entries
+  int req_simd_reg = 0;        // require simd register
+  int q_type      = *m_simBase->m_knobs->KNOB_GEN_ALLOCQ_INDEX;
+
+  *req_sb      = 0;            // require store buffer entries
+  *req_lb      = 0;            // require load buffer entries
+  *req_int_reg = 0;            // require integer register
+  *req_fp_reg  = 0;            // require fp register
+
+  if (uop->m_mem_type == MEM_LD) // load queue
+    *req_lb = 1;
+  else if (uop->m_mem_type == MEM_ST) // store queue
+    *req_sb = 1;
+  else if (uop->m_uop_type == UOP_IADD || // integer register
+      uop->m_uop_type == UOP_IMUL || 
+      uop->m_uop_type == UOP_ICMP) 
+    *req_int_reg = 1;
+  else if (uop->m_uop_type == UOP_FCVT || uop->m_uop_type == UOP_FADD) // fp register
+    *req_fp_reg = 1;
+  else if (uop->m_uop_type == UOP_SIMD) // simd register
+    req_simd_reg = 1;
+
+  // single allocation queue
+  if (m_num_queues == 1) {
+    q_type = *m_simBase->m_knobs->KNOB_GEN_ALLOCQ_INDEX;
+  }
+  // multiple allocation queues
+  else { 
+    if (*req_fp_reg) 
+      q_type = *m_simBase->m_knobs->KNOB_FLOAT_ALLOCQ_INDEX;
+    else if (req_simd_reg)
+      q_type = *m_simBase->m_knobs->KNOB_SIMD_ALLOCQ_INDEX;
+    else if (*req_sb || *req_lb) 
+      q_type = *m_simBase->m_knobs->KNOB_MEM_ALLOCQ_INDEX;
+    else 
+      q_type = *m_simBase->m_knobs->KNOB_GEN_ALLOCQ_INDEX;
+  }  
+
+  pqueue_c<int> *alloc_q = m_alloc_q[q_type];
+
+  // check rob and other physical resources
+  if (m_rob->space() < req_rob || 
+      m_resource->get_num_sb() < *req_sb || 
+      m_resource->get_num_lb() < *req_lb || 
+      alloc_q->space() < 1 || 
+      m_resource->get_num_int_regs () < *req_int_reg || 
+      m_resource->get_num_fp_regs() < *req_fp_reg) {
+    DEBUG_CORE(m_core_id,"not enough physical resources: rob_space:%d num_sb:%d num_lb:%d alloc_q:%d int_reg:%d fp_reg:%d \n",
+        m_rob->space(), m_resource->get_num_sb(), m_resource->get_num_lb(), alloc_q->space(), m_resource->get_num_int_regs(), m_resource->get_num_fp_regs()); 
+    return -1;
+  }
+
+  return q_type;
+}
+
+
+// cycle skipping : the next cycle allocates nothing when the frontend queue has no ready
+// uop or its resources are not available
+bool allocate_c::check_stall(void)
+{
+  // pipeline is not running
+  if (!m_allocate_running)
+    return true;
+
+  if (!m_frontend_q->ready())
+    return true;
+
+  int req_sb, req_lb, req_int_reg, req_fp_reg;
+  return check_resources((uop_c *)m_frontend_q->peek(0), &req_sb, &req_lb, &req_int_reg, 
+      &req_fp_reg) == -1;
+}
+
+
 // Allocate rob entries for instructions from frontend queue every cycle
 void allocate_c::run_a_cycle(void)
 {
@@ -122,57 +200,13 @@ void allocate_c::run_a_cycle(void)
     // -------------------------------------
     // check resource requirement
     // -------------------------------------
-    int req_rob      = 1;        // require rob entries
-    int req_sb       = 0;        // require store buffer entries
-    int req_lb       = 0;        // require load buffer entries
-    int req_int_reg  = 0;        // require integer register
-    int req_fp_reg   = 0;        // require fp register
-    int req_simd_reg = 0;        // require simd register
-    int q_type      = *m_simBase->m_knobs->KNOB_GEN_ALLOCQ_INDEX;
-
-    if (uop->m_mem_type == MEM_LD) // load queue
-      req_lb = 1;
-    else if (uop->m_mem_type == MEM_ST) // store queue
-      req_sb = 1;
-    else if (uop->m_uop_type == UOP_IADD || // integer register
-        uop->m_uop_type == UOP_IMUL || 
-        uop->m_uop_type == UOP_ICMP) 
-      req_int_reg = 1;
-    else if (uop->m_uop_type == UOP_FCVT || uop->m_uop_type == UOP_FADD) // fp register
-      req_fp_reg = 1;
-    else if (uop->m_uop_type == UOP_SIMD) // simd register
-      req_simd_reg = 1;
-
-    // single allocation queue
-    if (m_num_queues == 1) {
-      q_type = *m_simBase->m_knobs->KNOB_GEN_ALLOCQ_INDEX;
-    }
-    // multiple allocation queues
-    else { 
-      if (req_fp_reg) 
-        q_type = *m_simBase->m_knobs->KNOB_FLOAT_ALLOCQ_INDEX;
-      else if (req_simd_reg)
-        q_type = *m_simBase->m_knobs->KNOB_SIMD_ALLOCQ_INDEX;
-      else if (req_sb || req_lb) 
-        q_type = *m_simBase->m_knobs->KNOB_MEM_ALLOCQ_INDEX;
-      else 
-        q_type = *m_simBase->m_knobs->KNOB_GEN_ALLOCQ_INDEX;
-    }  
+    int req_sb, req_lb, req_int_reg, req_fp_reg;
+    int q_type = check_resources(uop, &req_sb, &req_lb, &req_int_reg, &req_fp_reg);
+    if (q_type == -1) 
+      break;
 
     pqueue_c<int> *alloc_q = m_alloc_q[q_type];
 
-    // check rob and other physical resources
-    if (m_rob->space() < req_rob || 
-        m_resource->get_num_sb() < req_sb || 
-        m_resource->get_num_lb() < req_lb || 
-        alloc_q->space() < 1 || 
-        m_resource->get_num_int_regs () < req_int_reg || 
-        m_resource->get_num_fp_regs() < req_fp_reg) {
-			DEBUG_CORE(m_core_id,"not enough physical resources: rob_space:%d num_sb:%d num_lb:%d alloc_q:%d int_reg:%d fp_reg:%d \n",
-								 m_rob->space(), m_resource->get_num_sb(), m_resource->get_num_lb(), alloc_q->space(), m_resource->get_num_int_regs(), m_resource->get_num_fp_regs()); 
-      break;
-    }
-
     // no stall allocate resources 
     uop->m_alloc_cycle = m_simBase->m_core_cycle[m_core_id];
 
@@ -180,7 +180,22 @@ class allocate_c
       return m_allocate_running; 
     }
 
+    /*! \fn check_stall()
+     *  \brief Cycle skipping : check whether the next cycle allocates nothing
+     *  \return bool - True if the next cycle is a stall
+     */
+    bool check_stall(void);
+
   private:
+    /*! \fn check_resources()
+     *  \brief Check rob and other physical resources required by an uop
+     *  \param uop - uop to allocate
+     *  \param req_sb, req_lb, req_int_reg, req_fp_reg - set to the required resources
+     *  \return int - Allocation queue type, -1 if resources are not available
+     */
+    int check_resources(uop_c* uop, int* req_sb, int* req_lb, int* req_int_reg, 
+        int* req_fp_reg);
+
     int             m_core_id; /**< core id */
     pqueue_c<int*>* m_frontend_q; /**< frontend queue */
     pqueue_c<int>** m_alloc_q;  /**< allocation queue */
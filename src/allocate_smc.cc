@@ -220,6 +220,8 @@ void smc_allocate_c::run_a_cycle(void)
     uop->m_allocq_num = gpu_alloc_q_type;
     uop->m_state      = OS_ALLOCATE;
     thread_rob->push(uop);
+    if (thread_rob->entries() == 1)
+      m_gpu_rob->update_head(uop->m_thread_id);
 
     
     // dequeue from frontend queue
@@ -0,0 +1,122 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : arena.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : slab arena for fixed-size objects and list nodes
+ *********************************************************************************************/
+
+#include <cstdlib>
+#include <mutex>
+
+#include "arena.h"
+
+
+/** Bytes per slab */
+#define ARENA_SLAB_SIZE 65536
+
+
+/** All arenas created so far (arenas live until the process exits) */
+static vector<arena_c*> g_arena;
+static mutex g_arena_mutex;
+
+macsim_c* arena_c::m_simBase = NULL;
+
+
+arena_c::arena_c(size_t block_size)
+{
+  const size_t align = alignof(max_align_t);
+  if (block_size < sizeof(free_block_s))
+    block_size = sizeof(free_block_s);
+
+  m_block_size = (block_size + align - 1) & ~(align - 1);
+
+  // the first block of a slab holds the slab header
+  m_slab_size = ARENA_SLAB_SIZE;
+  while (m_slab_size / m_block_size < 2)
+    m_slab_size *= 2;
+  m_slab_blocks = m_slab_size / m_block_size - 1;
+
+  m_free = NULL;
+  m_remote_free = NULL;
+  m_num_heap_alloc = 0;
+}
+
+
+arena_c* arena_c::create(size_t block_size)
+{
+  arena_c* arena = new arena_c(block_size);
+
+  lock_guard<mutex> lock(g_arena_mutex);
+  g_arena.push_back(arena);
+
+  return arena;
+}
+
+
+void arena_c::refill(void)
+{
+  // blocks released by other host threads come first
+  m_free = m_remote_free.exchange(NULL, memory_order_acquire);
+  if (m_free != NULL)
+    return;
+
+  ++m_num_heap_alloc;
+
+  char* slab = static_cast<char*>(aligned_alloc(m_slab_size, m_slab_size));
+  reinterpret_cast<slab_header_s*>(slab)->m_owner = this;
+  for (int ii = m_slab_blocks; ii >= 1; --ii) {
+    free_block_s* block = reinterpret_cast<free_block_s*>(slab + ii * m_block_size);
+    block->m_next = m_free;
+    m_free = block;
+  }
+}
+
+
+// lock-free push; the owner takes the whole list at once, so there is no ABA problem
+void arena_c::release_remote(free_block_s* block)
+{
+  block->m_next = m_remote_free.load(memory_order_relaxed);
+  while (!m_remote_free.compare_exchange_weak(block->m_next, block, memory_order_release, 
+        memory_order_relaxed));
+}
+
+
+Counter arena_c::get_num_heap_alloc(void)
+{
+  lock_guard<mutex> lock(g_arena_mutex);
+
+  Counter total = 0;
+  for (auto arena : g_arena)
+    total += arena->m_num_heap_alloc;
+
+  return total;
+}
@@ -0,0 +1,235 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : arena.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : slab arena for fixed-size objects and list nodes
+ *********************************************************************************************/
+
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include "macsim.h"
+#include "global_defs.h"
+#include "global_types.h"
+#include "statistics.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Slab arena of fixed-size blocks
+///
+/// Blocks are carved from contiguous slabs and recycled through an intrusive free list that
+/// is threaded through the free blocks themselves, so that a steady-state allocation is a
+/// pointer pop and never reaches the heap. Each host thread has its own arena per object
+/// type (get). Slabs are aligned to their size and start with the owning arena, so a block
+/// released on another host thread is handed back to the arena it came from (remote free
+/// list, taken over by the owner before it refills from the heap). Slabs stay allocated until
+/// the process exits, but an arena never holds more slabs than its peak number of live blocks
+/// requires.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class arena_c
+{
+  public:
+    /**
+     * Constructor
+     * @param block_size - size of a block in bytes
+     */
+    arena_c(size_t block_size);
+
+    /**
+     * Allocate a block
+     */
+    void* allocate(void)
+    {
+      STAT_EVENT(ARENA_ALLOC);
+      if (m_free == NULL)
+        refill();
+
+      free_block_s* block = m_free;
+      m_free = block->m_next;
+      return block;
+    }
+
+    /**
+     * Release a block (to the arena that allocated it)
+     */
+    void release(void* ptr)
+    {
+      free_block_s* block = static_cast<free_block_s*>(ptr);
+      slab_header_s* slab = reinterpret_cast<slab_header_s*>(
+          reinterpret_cast<uintptr_t>(ptr) & ~(m_slab_size - 1));
+      if (slab->m_owner != this) {
+        slab->m_owner->release_remote(block);
+        return;
+      }
+
+      block->m_next = m_free;
+      m_free = block;
+    }
+
+    /**
+     * Arena of the current host thread for objects of type T
+     */
+    template <class T>
+    static arena_c* get(void)
+    {
+      static thread_local arena_c* arena = NULL;
+      if (arena == NULL)
+        arena = create(sizeof(T));
+      return arena;
+    }
+
+    /**
+     * Set the simulation whose stats count arena allocations
+     */
+    static void init(macsim_c* simBase) { m_simBase = simBase; }
+
+    /**
+     * Number of slabs allocated from the heap by all arenas. Each host thread refills its own
+     * arenas, so the count depends on the number of host threads and is not a stat.
+     */
+    static Counter get_num_heap_alloc(void);
+
+  private:
+    arena_c(); // do not implement
+
+    /**
+     * Create and register a new arena
+     */
+    static arena_c* create(size_t block_size);
+
+    /**
+     * Take over blocks released by other host threads, or add a new slab to the free list
+     */
+    void refill(void);
+
+    /**
+     * Free block (intrusive free list)
+     */
+    typedef struct free_block_s {
+      free_block_s* m_next; /**< next free block */
+    } free_block_s;
+
+    /**
+     * Slab header (first block of a slab)
+     */
+    typedef struct slab_header_s {
+      arena_c* m_owner; /**< arena that allocated the slab */
+    } slab_header_s;
+
+    /**
+     * Release a block of this arena from another host thread
+     */
+    void release_remote(free_block_s* block);
+
+  private:
+    size_t        m_block_size; /**< block size (aligned) */
+    size_t        m_slab_size; /**< slab size and alignment (power of two) */
+    int           m_slab_blocks; /**< blocks per slab */
+    free_block_s* m_free; /**< free list */
+    atomic<free_block_s*> m_remote_free; /**< blocks released by other host threads */
+    Counter       m_num_heap_alloc; /**< allocated slabs */
+
+    static macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief STL allocator drawing single objects (list and hash nodes) from arena_c
+///////////////////////////////////////////////////////////////////////////////////////////////
+template <class T>
+class arena_allocator_c
+{
+  public:
+    typedef T value_type; /**< allocated type */
+
+    /**
+     * Constructor
+     */
+    arena_allocator_c() {}
+
+    /**
+     * Copy constructor from an allocator of another type
+     */
+    template <class U>
+    arena_allocator_c(const arena_allocator_c<U>&) {}
+
+    /**
+     * Allocate n objects
+     */
+    T* allocate(size_t n)
+    {
+      if (n == 1)
+        return static_cast<T*>(arena_c::get<T>()->allocate());
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    /**
+     * Deallocate n objects
+     */
+    void deallocate(T* ptr, size_t n)
+    {
+      if (n == 1)
+        arena_c::get<T>()->release(ptr);
+      else
+        ::operator delete(ptr);
+    }
+};
+
+
+/**
+ * All arena allocators are interchangeable
+ */
+template <class T, class U>
+bool operator==(const arena_allocator_c<T>&, const arena_allocator_c<U>&) { return true; }
+
+
+/**
+ * All arena allocators are interchangeable
+ */
+template <class T, class U>
+bool operator!=(const arena_allocator_c<T>&, const arena_allocator_c<U>&) { return false; }
+
+
+/**
+ * List whose nodes are allocated from arenas
+ */
+template <class T>
+using arena_list_c = list<T, arena_allocator_c<T> >;
+
+#endif
@@ -48,6 +48,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "uop.h"
 #include "factory_class.h"
 #include "assert.h"
+#include "checkpoint.h"
 
 #include "all_knobs.h"
 
@@ -98,6 +99,13 @@ bp_data_c::~bp_data_c()
 }
 
 
+void bp_data_c::checkpoint(checkpoint_c* ckpt)
+{
+  m_bp->checkpoint(ckpt);
+  m_bp_targ_pred->checkpoint(ckpt);
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -116,3 +124,10 @@ bp_dir_base_c::~bp_dir_base_c()
 }
 
 
+void bp_dir_base_c::checkpoint(checkpoint_c* ckpt)
+{
+  ckpt->io(m_global_hist);
+  ckpt->io(m_global_hist_64);
+}
+
+
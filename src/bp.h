@@ -112,6 +112,11 @@ class bp_dir_base_c
      */
     virtual void recover (recovery_info_c *) = 0; 
 
+    /**
+     * Save or restore the predictor state (global history)
+     */
+    virtual void checkpoint(checkpoint_c* ckpt);
+
   public:
     uns8       *m_pht; /**< branch history table */
     uns64       m_global_hist_64; /**< global branch history (64-bit) */
@@ -154,6 +159,11 @@ class bp_data_c
      */
     ~bp_data_c(void);
 
+    /**
+     * Save or restore the direction predictor and the BTB
+     */
+    void checkpoint(checkpoint_c* ckpt);
+
     int                m_core_id; /**< core id */
     bp_dir_base_c     *m_bp; /**< branch predictor */
     bp_targ_c         *m_bp_targ_pred;   /**< BTB */ 
@@ -43,6 +43,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "utils.h"
 #include "debug_macros.h"
 #include "uop.h"
+#include "checkpoint.h"
 
 #include "all_knobs.h"
 
@@ -130,3 +131,9 @@ void bp_gshare_c::recover(recovery_info_c *recovery_info)
   m_global_hist_64 = recovery_info->m_global_hist_64;
 }
 
+
+void bp_gshare_c::checkpoint(checkpoint_c* ckpt)
+{
+  bp_dir_base_c::checkpoint(ckpt);
+  ckpt->io(m_pht, sizeof(uns8) * (0x1 << *KNOB(KNOB_BP_HIST_LENGTH)));
+}
@@ -77,6 +77,11 @@ class bp_gshare_c : public bp_dir_base_c
      */
     void recover(recovery_info_c* recovery_info); 
 
+    /**
+     * Save or restore the global history and the pattern history table
+     */
+    void checkpoint(checkpoint_c* ckpt);
+
   private:
     /**
      * Private constructor
@@ -133,3 +133,9 @@ void bp_targ_c::update (uop_c *uop)
       m_core_id, uop->m_thread_id, uop->m_cf_type, (btb_line) ? (Addr)(*btb_line) : -1, 
       set, tag, insert_btb);
 }
+
+
+void bp_targ_c::checkpoint(checkpoint_c* ckpt)
+{
+  btb->checkpoint(ckpt);
+}
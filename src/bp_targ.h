@@ -66,6 +66,11 @@ class bp_targ_c
       */
      void update (uop_c *uop); 
 
+     /**
+      * Save or restore the BTB
+      */
+     void checkpoint(checkpoint_c* ckpt);
+
    protected:
      macsim_c* m_simBase; /**< macsim_c base class for simulation globals */ 
 
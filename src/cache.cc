@@ -41,8 +41,11 @@ POSSIBILITY OF SUCH DAMAGE.
  */
 
 
+#include <algorithm>
+
 #include "assert_macros.h"
 #include "cache.h"
+#include "checkpoint.h"
 #include "utils.h"
 
 #include "debug_macros.h"
@@ -66,11 +69,36 @@ cache_set_c::cache_set_c(int assoc)
 {
   m_entry = new cache_entry_c[assoc];
   m_assoc = assoc;
+
+  // padding ways are never valid
+  int num_tags = (assoc + 3) & ~3;
+  m_tag = new Addr[num_tags];
+  fill_n(m_tag, num_tags, 0);
+  m_valid = new uint64_t[(assoc + 63) / 64];
+  fill_n(m_valid, (assoc + 63) / 64, 0);
 }
 
 cache_set_c::~cache_set_c()
 {
   delete [] m_entry;
+  delete [] m_tag;
+  delete [] m_valid;
+}
+
+void cache_set_c::set_tag(int way, Addr tag)
+{
+  m_entry[way].m_valid = true;
+  m_entry[way].m_tag   = tag;
+  m_tag[way]           = tag;
+  m_valid[way >> 6]   |= 1ULL << (way & 63);
+}
+
+void cache_set_c::clear_tag(int way)
+{
+  m_entry[way].m_valid = false;
+  m_entry[way].m_tag   = 0;
+  m_tag[way]           = 0;
+  m_valid[way >> 6]   &= ~(1ULL << (way & 63));
 }
 
 
@@ -131,7 +159,7 @@ cache_c::cache_c(string name, int num_set, int assoc, int line_size,
 
     // Allocating memory for all of the data elements in each line
     for (int jj = 0; jj < assoc; ++jj) {
-      m_set[ii]->m_entry[jj].m_valid          = false;
+      m_set[ii]->clear_tag(jj);
       m_set[ii]->m_entry[jj].m_access_counter = false;
       if (data_size > 0) {
         m_set[ii]->m_entry[jj].m_data = (void *)malloc(data_size);
@@ -210,26 +238,23 @@ void* cache_c::access_cache(Addr addr, Addr *line_addr, bool update_repl, int ap
   if (update_repl)
     update_cache_on_access(*line_addr, set, appl_id);
 
-  // Walk through the set
-  for (int ii = 0; ii < m_assoc; ++ii) {
-    // For each line in based on associativity
-    cache_entry_c * line = &(m_set[set]->m_entry[ii]);
-
-    // Check for matching tag and validity
-    if (line->m_valid && line->m_tag == tag) {
-      // If hit, then return  
-      assert(line->m_data);
-
-      if (update_repl) {
-        // If prefetch is set mark it as used  
-        if (line->m_pref) {
-          line->m_pref = false;
-        }
-        update_line_on_hit(line, set, appl_id);
-      }   
+  // Check for a valid line with the matching tag
+  int way = m_set[set]->find_tag(tag);
+  if (way != -1) {
+    cache_entry_c * line = &(m_set[set]->m_entry[way]);
 
-      return line->m_data;
-    }
+    // If hit, then return  
+    assert(line->m_data);
+
+    if (update_repl) {
+      // If prefetch is set mark it as used  
+      if (line->m_pref) {
+        line->m_pref = false;
+      }
+      update_line_on_hit(line, set, appl_id);
+    }   
+
+    return line->m_data;
   }
 
   if (update_repl)
@@ -343,8 +368,7 @@ cache_entry_c* cache_c::find_replacement_line_from_same_type(int set, int appl_i
 void cache_c::initialize_cache_line(cache_entry_c *ins_line, Addr tag, Addr addr, int appl_id,
     bool gpuline, int set_id, bool skip) 
 {
-  ins_line->m_valid            = true;
-  ins_line->m_tag              = tag;
+  m_set[set_id]->set_tag(ins_line - m_set[set_id]->m_entry, tag);
   ins_line->m_base             = (addr & ~m_offset_mask);
   ins_line->m_access_counter   = 0;
   ins_line->m_last_access_time = CYCLE;
@@ -431,10 +455,9 @@ void cache_c::update_set_on_replacement(Addr tag, int appl_id, int set, bool gpu
 
 
 // initialize (nullify) a cache line
-bool cache_c::null_cache_line_fields(cache_entry_c *line)
+bool cache_c::null_cache_line_fields(cache_entry_c *line, int set)
 {
-  line->m_tag   = 0;
-  line->m_valid = false;
+  m_set[set]->clear_tag(line - m_set[set]->m_entry);
   line->m_base  = 0;
   memset(line->m_data, 0, m_data_size);
   if (line->m_dirty) {
@@ -456,15 +479,10 @@ bool cache_c::invalidate_cache_line(Addr addr)
   // to the new cache line being returned
   find_tag_and_set(addr, &tag, &set);
 
-  for (int ii = 0; ii < m_assoc; ++ii) {
-    // For each line in based on associativity
-    cache_entry_c *line = &(m_set[set]->m_entry[ii]);
-
-    // Check for matching tag and validity
-    if (line->m_valid && line->m_tag == tag) {
-      // If hit, then erase the current line data and return 
-      return null_cache_line_fields(line);
-    }
+  // If hit, then erase the current line data and return 
+  int way = m_set[set]->find_tag(tag);
+  if (way != -1) {
+    return null_cache_line_fields(&(m_set[set]->m_entry[way]), set);
   }
 
   return false;
@@ -484,8 +502,7 @@ void cache_c::invalidate_cache(void)
   for (int ii = 0; ii < m_num_sets; ++ii) {
     for (int jj = 0; jj < m_assoc; ++jj) {
       cache_entry_c* line = &(m_set[ii]->m_entry[jj]);
-      line->m_valid = false;
-      line->m_tag   = 0;
+      m_set[ii]->clear_tag(jj);
       memset(line->m_data, 0, m_data_size);
     }
   }
@@ -540,3 +557,52 @@ void cache_c::print_info(int id)
     cout << "CACHE::L" << id << " cpu: " << m_num_cpu_line << " gpu: " << m_num_gpu_line << "\n";
   }
 }
+
+
+// save or restore all cache lines (line data is plain data without pointers)
+void cache_c::checkpoint(checkpoint_c* ckpt)
+{
+  int num_sets  = m_num_sets;
+  int assoc     = m_assoc;
+  int data_size = m_data_size;
+  ckpt->io(num_sets);
+  ckpt->io(assoc);
+  ckpt->io(data_size);
+  ASSERTM(num_sets == m_num_sets && assoc == m_assoc && data_size == m_data_size,
+      "checkpoint : %s geometry (%d sets, %d ways) does not match (%d sets, %d ways)\n",
+      m_name.c_str(), num_sets, assoc, m_num_sets, m_assoc);
+
+  ckpt->io(m_num_cpu_line);
+  ckpt->io(m_num_gpu_line);
+  ckpt->io(m_insert_count);
+
+  for (int ii = 0; ii < m_num_sets; ++ii) {
+    cache_set_c* set = m_set[ii];
+    ckpt->io(set->m_num_cpu_line);
+    ckpt->io(set->m_num_gpu_line);
+
+    for (int jj = 0; jj < m_assoc; ++jj) {
+      cache_entry_c* line = &set->m_entry[jj];
+      ckpt->io(line->m_valid);
+      ckpt->io(line->m_tag);
+      ckpt->io(line->m_base);
+      ckpt->io(line->m_last_access_time);
+      ckpt->io(line->m_access_counter);
+      ckpt->io(line->m_pref);
+      ckpt->io(line->m_dirty);
+      ckpt->io(line->m_appl_id);
+      ckpt->io(line->m_gpuline);
+      ckpt->io(line->m_skip);
+      if (m_data_size > 0)
+        ckpt->io(line->m_data, m_data_size);
+
+      // rebuild packed tags
+      if (!ckpt->is_saving()) {
+        if (line->m_valid)
+          set->set_tag(jj, line->m_tag);
+        else
+          set->clear_tag(jj);
+      }
+    }
+  }
+}
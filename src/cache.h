@@ -40,6 +40,9 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <string>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 #include "macsim.h"
 #include "global_types.h" 
@@ -85,8 +88,46 @@ class cache_entry_c
 };
 
 
+/**
+ * Compare packed tags against a tag. At most 64 tags are compared; the tag array must be
+ * readable up to a multiple of 4 entries.
+ * @return bit i is set if tags[i] == tag
+ */
+inline uint64_t match_cache_tags(const Addr* tags, int num_tags, Addr tag)
+{
+  uint64_t match = 0;
+#if defined(__AVX2__)
+  __m256i key = _mm256_set1_epi64x(tag);
+  for (int ii = 0; ii < num_tags; ii += 4) {
+    __m256i cmp = _mm256_cmpeq_epi64(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&tags[ii])), key);
+    match |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(cmp))) << ii;
+  }
+#elif defined(__SSE2__)
+  __m128i key = _mm_set1_epi64x(tag);
+  for (int ii = 0; ii < num_tags; ii += 2) {
+    __m128i cmp = _mm_cmpeq_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&tags[ii])), key);
+    // both 32-bit halves have to match
+    cmp = _mm_and_si128(cmp, _mm_shuffle_epi32(cmp, _MM_SHUFFLE(2, 3, 0, 1)));
+    match |= static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(cmp))) << ii;
+  }
+#else
+  for (int ii = 0; ii < num_tags; ++ii) {
+    if (tags[ii] == tag)
+      match |= 1ULL << ii;
+  }
+#endif
+  return match;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Cache set class
+///
+/// Tags and valid bits are also kept as packed arrays (structure of arrays) so that a
+/// lookup compares all ways with a few SIMD instructions. m_entry remains the view used
+/// for replacement; both are updated through set_tag() and clear_tag().
 ///////////////////////////////////////////////////////////////////////////////////////////////
 class cache_set_c
 {
@@ -103,8 +144,35 @@ class cache_set_c
      */
     ~cache_set_c();
 
+    /**
+     * Find the first valid way holding a tag
+     * @return way index, -1 on a miss
+     */
+    int find_tag(Addr tag)
+    {
+      for (int base = 0; base < m_assoc; base += 64) {
+        int num_tags = (m_assoc - base < 64) ? m_assoc - base : 64;
+        uint64_t hit = match_cache_tags(&m_tag[base], num_tags, tag) & m_valid[base >> 6];
+        if (hit)
+          return base + __builtin_ctzll(hit);
+      }
+      return -1;
+    }
+
+    /**
+     * Set the tag of a way and mark it valid
+     */
+    void set_tag(int way, Addr tag);
+
+    /**
+     * Invalidate a way
+     */
+    void clear_tag(int way);
+
   public:
     cache_entry_c* m_entry; /**< cache entries */
+    Addr* m_tag; /**< packed tags (padded to a multiple of 4 ways) */
+    uint64_t* m_valid; /**< valid bit per way, 64 ways per word */
     int m_assoc; /**< associativity */
     int m_num_cpu_line; /**< number of cpu cache line */
     int m_num_gpu_line; /**< number of gpu cache line */
@@ -256,9 +324,10 @@ class cache_c
      * \brief Function to null out all fields in the caache line 
         being invalidated 
      * \param line - Cache line being invalidated
+     * \param set - Set of the cache line
      * \return bool - Dirty flag
      */
-    bool null_cache_line_fields(cache_entry_c *line);
+    bool null_cache_line_fields(cache_entry_c *line, int set);
 
     /**
      * \brief Function to invalidate cache line. 
@@ -300,6 +369,11 @@ class cache_c
      */
     void print_info(int id);
 
+    /**
+     * Save or restore all cache lines
+     */
+    void checkpoint(checkpoint_c* ckpt);
+
   public:
     Cache_Type m_cache_type; /**< cache type */
 
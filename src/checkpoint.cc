@@ -0,0 +1,185 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : checkpoint.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : checkpoint of warmed-up simulation state
+ *********************************************************************************************/
+
+#include <cstring>
+#include <string>
+
+#include "checkpoint.h"
+#include "macsim.h"
+#include "core.h"
+#include "memory.h"
+#include "mmu.h"
+#include "process_manager.h"
+#include "trace_read.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+#include "utils.h"
+
+#include "all_knobs.h"
+
+
+// length of a section marker in the checkpoint file
+#define CHECKPOINT_SECTION_SIZE 16
+
+
+checkpoint_c::checkpoint_c(macsim_c* simBase)
+{
+  m_simBase = simBase;
+  m_file    = NULL;
+  m_saving  = false;
+}
+
+
+checkpoint_c::~checkpoint_c()
+{
+  if (m_file)
+    fclose(m_file);
+}
+
+
+void checkpoint_c::save(const string& filename)
+{
+  m_filename = filename;
+  m_saving   = true;
+  m_file     = fopen(filename.c_str(), "wb");
+  ASSERTM(m_file, "cannot create checkpoint file %s\n", filename.c_str());
+
+  checkpoint_sim();
+
+  ASSERTM(fclose(m_file) == 0, "cannot write checkpoint file %s\n", filename.c_str());
+  m_file = NULL;
+
+  report("checkpoint saved to " << filename << " at cycle " << CYCLE);
+}
+
+
+void checkpoint_c::load(const string& filename)
+{
+  m_filename = filename;
+  m_saving   = false;
+  m_file     = fopen(filename.c_str(), "rb");
+  ASSERTM(m_file, "cannot open checkpoint file %s\n", filename.c_str());
+
+  checkpoint_sim();
+
+  ASSERTM(fgetc(m_file) == EOF, "checkpoint file %s : trailing data\n", filename.c_str());
+  fclose(m_file);
+  m_file = NULL;
+
+  report("checkpoint restored from " << filename << " at cycle " << CYCLE);
+}
+
+
+void checkpoint_c::io(void* data, size_t size)
+{
+  if (size == 0)
+    return;
+
+  size_t count;
+  if (m_saving)
+    count = fwrite(data, size, 1, m_file);
+  else
+    count = fread(data, size, 1, m_file);
+
+  ASSERTM(count == 1, "checkpoint file %s : %s error\n", m_filename.c_str(), 
+      m_saving ? "write" : "read");
+}
+
+
+void checkpoint_c::section(const char* name)
+{
+  char marker[CHECKPOINT_SECTION_SIZE];
+  memset(marker, 0, CHECKPOINT_SECTION_SIZE);
+  strncpy(marker, name, CHECKPOINT_SECTION_SIZE - 1);
+
+  if (m_saving) {
+    io(marker, CHECKPOINT_SECTION_SIZE);
+  }
+  else {
+    char saved[CHECKPOINT_SECTION_SIZE];
+    io(saved, CHECKPOINT_SECTION_SIZE);
+    ASSERTM(memcmp(marker, saved, CHECKPOINT_SECTION_SIZE) == 0, 
+        "checkpoint file %s : expected section %s, found %.15s "
+        "(checkpoint taken with a different configuration?)\n", 
+        m_filename.c_str(), marker, saved);
+  }
+}
+
+
+// the same walk is used to save and to restore
+void checkpoint_c::checkpoint_sim(void)
+{
+  char magic[8];
+  memcpy(magic, CHECKPOINT_MAGIC, 8);
+  uint32_t version = CHECKPOINT_VERSION;
+  io(magic, 8);
+  io(version);
+  ASSERTM(!memcmp(magic, CHECKPOINT_MAGIC, 8) && version == CHECKPOINT_VERSION,
+      "%s is not a checkpoint file of this version\n", m_filename.c_str());
+
+  int num_cores = *KNOB(KNOB_NUM_SIM_CORES);
+  bool physical_mapping = *KNOB(KNOB_ENABLE_PHYSICAL_MAPPING);
+  io(num_cores);
+  io(physical_mapping);
+  ASSERTM(num_cores == *KNOB(KNOB_NUM_SIM_CORES) && 
+      physical_mapping == *KNOB(KNOB_ENABLE_PHYSICAL_MAPPING),
+      "checkpoint file %s : number of cores or physical mapping does not match\n",
+      m_filename.c_str());
+
+  // cache lines keep their last access cycle for replacement
+  io(m_simBase->m_simulation_cycle);
+
+  section("process");
+  m_simBase->m_process_manager->checkpoint(this);
+
+  for (int ii = 0; ii < num_cores; ++ii) {
+    section("core");
+    m_simBase->m_core_pointers[ii]->checkpoint(this);
+  }
+
+  section("memory");
+  m_simBase->m_memory->checkpoint(this);
+
+  if (physical_mapping) {
+    section("mmu");
+    m_simBase->m_MMU->checkpoint(this);
+
+    section("page_mapping");
+    m_simBase->m_trace_reader->checkpoint(this);
+  }
+
+  section("end");
+}
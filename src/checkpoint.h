@@ -0,0 +1,130 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : checkpoint.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : checkpoint of warmed-up simulation state
+ *********************************************************************************************/
+
+#ifndef CHECKPOINT_H_INCLUDED
+#define CHECKPOINT_H_INCLUDED
+
+
+#include <cstdio>
+#include <string>
+
+#include "global_defs.h"
+#include "global_types.h"
+
+
+#define CHECKPOINT_MAGIC "MSIMCKPT"
+#define CHECKPOINT_VERSION 1
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checkpoint file of the warmed-up simulation state
+///
+/// A checkpoint holds the long-lived state that takes a long time to warm up: caches, branch
+/// predictors, TLBs, page tables and the position of every thread in its trace. In-flight
+/// state (pipelines, MSHRs, NoC, DRAM controller queues) is not saved; it is rebuilt after
+/// restore within a few thousand cycles (drained checkpoint). Each thread restarts at its
+/// first unretired instruction, and a GPU kernel restarts with the blocks that had not
+/// retired at the checkpoint.
+///
+/// Saving and loading walk the components in the same order. Each component implements
+/// checkpoint(checkpoint_c*), which calls io() on its fields in both directions and checks
+/// is_saving() only where restoring needs extra work (e.g. rebuilding derived state).
+///////////////////////////////////////////////////////////////////////////////////////////////
+class checkpoint_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    checkpoint_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~checkpoint_c();
+
+    /**
+     * Save the simulation state to a file
+     */
+    void save(const string& filename);
+
+    /**
+     * Restore the simulation state from a file. Called before traces are opened.
+     */
+    void load(const string& filename);
+
+    /**
+     * Checkpoint is being saved (false : being loaded)
+     */
+    bool is_saving(void) { return m_saving; }
+
+    /**
+     * Write (save) or read (load) raw data
+     */
+    void io(void* data, size_t size);
+
+    /**
+     * Write (save) or read (load) a plain value
+     */
+    template <typename T>
+    void io(T& data)
+    {
+      io(&data, sizeof(T));
+    }
+
+    /**
+     * Write (save) or verify (load) a section marker, so that a checkpoint taken with a
+     * different configuration fails at the first mismatching component
+     */
+    void section(const char* name);
+
+  private:
+    checkpoint_c(); // do not implement
+
+    /**
+     * Walk all checkpointed components
+     */
+    void checkpoint_sim(void);
+
+  private:
+    FILE*     m_file; /**< checkpoint file */
+    string    m_filename; /**< checkpoint file name */
+    bool      m_saving; /**< saving or loading */
+    macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
+};
+
+
+#endif
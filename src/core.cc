@@ -90,6 +90,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "readonly_cache.h"
 #include "sw_managed_cache.h"
 #include "network.h"
+#include "parallel_engine.h"
 #include "dram.h"
 #include "resource.h"
 
@@ -131,6 +132,8 @@ void core_c::init(void)
   m_heartbeat_printed_inst_count_core = 0;
   m_last_inst_count                   = 0;
   m_appl_id                           = 0;
+  m_stall_end                         = 0;
+  m_stall_checked                     = false;
 
   m_fetch_ended.clear();
   m_thread_reach_end.clear();
@@ -227,6 +230,10 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
   // branch predictor
   m_bp_data = new bp_data_c(c_id, m_simBase); 
 
+  // functional warmup
+  m_warmup_uop = new uop_c(m_simBase);
+  m_warmup_fetch_line = 0;
+
 	m_resource = new resource_c (type, m_simBase); 
 
   // frontend stage
@@ -307,6 +314,15 @@ core_c::core_c (int c_id, macsim_c* simBase, Unit_Type type)
 
   // clock cycle
   m_cycle = 0;
+
+  // cycle skipping (dyfr samples every cycle)
+#if !defined(USING_SST) && !defined(IRIS)
+  m_cycle_skip = *KNOB(KNOB_ENABLE_CYCLE_SKIP) && !*KNOB(KNOB_ENABLE_DYFR);
+#else
+  m_cycle_skip = false;
+#endif
+  m_stall_end     = 0;
+  m_stall_checked = false;
 }
 
 
@@ -335,6 +351,7 @@ core_c::~core_c()
   }
   delete m_map;
   delete m_bp_data;
+  delete m_warmup_uop;
 	delete m_resource; 
   delete m_exec;
   delete m_schedule;
@@ -422,6 +439,107 @@ void core_c::run_a_cycle(bool pll_lock)
   m_frontend->run_a_cycle();
 
   ++m_cycle;
+
+  if (m_cycle_skip) 
+    check_stall();
+}
+
+
+// cycle skipping : check whether the following cycles are stalls, i.e. every stage is
+// blocked until a known completion cycle (rob head, source operand, branch recovery) or
+// until a memory response, which calls wake_up(). A stall is only taken once a cycle has
+// left the pipeline state unchanged.
+void core_c::check_stall(void)
+{
+  Counter next_event = ULLONG_MAX;
+  m_stall_state.clear();
+
+  // GPU pipelines are not modeled
+  bool stall = m_allocate != NULL && m_running_thread_num > 0 &&
+    m_retire->check_stall(&m_stall_state, &next_event) &&
+    m_allocate->check_stall() &&
+    m_q_frontend->is_settled() &&
+    m_frontend->check_stall(&m_stall_state, &next_event) &&
+    m_schedule->check_stall(&m_stall_state, &next_event);
+
+  for (int ii = 0; ii < max_ALLOCQ && stall; ++ii) {
+    stall = m_q_iaq[ii]->is_settled();
+  }
+
+  if (stall && *m_simBase->m_knobs->KNOB_PREF_FRAMEWORK_ON && m_knob_enable_pref) 
+    stall = m_hw_pref->is_idle();
+
+  if (!stall || is_heartbeat_pending()) {
+    m_stall_checked = false;
+    return;
+  }
+
+  m_stall_state.push_back(m_unique_scheduled_thread_num);
+  m_stall_state.push_back(m_running_thread_num);
+  m_stall_state.push_back(m_fetching_thread_num);
+
+  if (m_stall_checked && m_stall_state == m_stall_prev_state) 
+    m_stall_end = next_event;
+
+  m_stall_prev_state.swap(m_stall_state);
+  m_stall_checked = true;
+}
+
+
+// heartbeat messages are printed from retired instruction counts (see core_heartbeat)
+bool core_c::is_heartbeat_pending(void)
+{
+  Counter interval = *KNOB(KNOB_HEARTBEAT_INTERVAL);
+  if (!interval)
+    return false;
+
+  if (m_retire->get_total_insts_retired() >= m_heartbeat_printed_inst_count_core + interval)
+    return true;
+
+  if (!*m_simBase->m_knobs->KNOB_PRINT_HEARTBEAT)
+    return false;
+
+  for (int ii = m_last_terminated_tid; ii < m_unique_scheduled_thread_num; ++ii) { 
+    auto itr = m_heartbeat.find(ii);
+    if (itr != m_heartbeat.end() && !itr->second->m_check_done &&
+        m_retire->get_instrs_retired(ii) >= itr->second->m_printed_inst_count + interval)
+      return true;
+  }
+
+  return false;
+}
+
+
+// number of stalled cycles following the current core cycle
+Counter core_c::get_num_idle_cycles(void)
+{
+  if (m_stall_end == ULLONG_MAX)
+    return ULLONG_MAX;
+
+  Counter cycle = m_simBase->m_core_cycle[m_core_id] + 1;
+  return (m_stall_end > cycle) ? m_stall_end - cycle : 0;
+}
+
+
+// account stalled cycles without running the pipeline stages
+void core_c::skip_cycles(Counter num_cycles)
+{
+  m_frontend->skip_cycles(num_cycles);
+  m_schedule->skip_cycles(num_cycles);
+  m_retire->skip_cycles(num_cycles);
+
+  if (*m_simBase->m_knobs->KNOB_PREF_FRAMEWORK_ON && m_knob_enable_pref) 
+    m_hw_pref->skip_cycles(num_cycles);
+
+  m_cycle += num_cycles;
+}
+
+
+// end the current stall : the state of a stage has been changed from outside the core
+void core_c::wake_up(void)
+{
+  m_stall_end     = 0;
+  m_stall_checked = false;
 }
 
 
@@ -487,6 +605,9 @@ void core_c::thread_heartbeat(int tid, bool final)
 
   /* print heartbeat message if necessary */
   if ((*KNOB(KNOB_HEARTBEAT_INTERVAL) && inst_diff >= *KNOB(KNOB_HEARTBEAT_INTERVAL)) || final) {
+    // print in serial core order
+    parallel_engine_c::order();
+
     time_t cur_time = time(NULL);
     double int_ipc = (double)(m_inst_count - m_heartbeat[tid]->m_last_inst_count) / 
                              (m_core_cycle_count - m_heartbeat[tid]->m_last_cycle_count);
@@ -531,6 +652,9 @@ void core_c::core_heartbeat(bool final)
 
   /* print heartbeat message if necessary */
   if ((*KNOB(KNOB_HEARTBEAT_INTERVAL) && inst_diff >= *KNOB(KNOB_HEARTBEAT_INTERVAL)) || final) { 
+    // print in serial core order
+    parallel_engine_c::order();
+
     time_t cur_time = time(NULL);
     double int_ipc = (double)(m_inst_count - m_heartbeat_last_inst_count_core) / 
                              (m_core_cycle_count - m_heartbeat_last_cycle_count_core); 
@@ -578,6 +702,7 @@ void core_c::check_forward_progress()
   // raise forward progress exception
   if (m_core_cycle_count - m_last_forward_progress > *KNOB(KNOB_FORWARD_PROGRESS_LIMIT)) {
     STAT_EVENT(PROGRESS_ERROR);
+    parallel_engine_c::order();
 
     // print all mshr entries
     m_simBase->m_memory->print_mshr();
@@ -666,6 +791,8 @@ void core_c::deallocate_thread_data(int tid)
     m_simBase->m_bp_recovery_info_pool->release_entry(bp_recovery_info);
   }
 
+  m_main_threads.erase(tid);
+
   // deallocate dependence map
   m_map->delete_map(tid);
 
@@ -680,6 +807,7 @@ void core_c::deallocate_thread_data(int tid)
     m_terminated_tid.erase(t_id);
     m_last_terminated_tid = ++t_id;
   }
+  wake_up();
 
   if (m_core_type == "ptx" || m_core_type == "igpu") 
     m_gpu_rob->free_rob(tid);
@@ -694,6 +822,28 @@ void core_c::deallocate_thread_data(int tid)
 }
 
 
+
+// check whether the next cycle may call the process manager
+bool core_c::is_parallel_safe(void)
+{
+  // last uop of a thread can be retired
+  if (m_fetching_thread_num != m_running_thread_num)
+    return false;
+
+  // a thread can be terminated at max_insts
+  if (m_max_inst_fetched >= *KNOB(KNOB_MAX_INSTS))
+    return false;
+
+  // a main thread can create other threads
+  for (auto itr = m_main_threads.begin(); itr != m_main_threads.end(); ++itr) {
+    process_s* process = itr->second->m_process;
+    if (process->m_no_of_threads_created < process->m_no_of_threads)
+      return false;
+  }
+
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 // hardware prefetchers
@@ -779,17 +929,151 @@ thread_s* core_c::get_trace_info(int tid)
 void core_c::create_trace_info(int tid, thread_s* thread)
 {
   m_thread_trace_info[tid] = thread;
+  if (thread->m_main_thread)
+    m_main_threads[tid] = thread;
 
   allocate_thread_data(tid);
   ++m_unique_scheduled_thread_num;
   ++m_running_thread_num;
   ++m_fetching_thread_num;
+  wake_up();
 
   // to prevent from unnecessary forward progress error for a newely launched cores 
   m_last_forward_progress = m_core_cycle_count; 
 }
 
 
+// retired instructions of running threads (a thread resumes from here after a checkpoint)
+void core_c::get_thread_progress(unordered_map<thread_s*, Counter>* progress)
+{
+  for (auto I = m_thread_trace_info.begin(), E = m_thread_trace_info.end(); I != E; ++I) {
+    if (!m_thread_finished[I->first])
+      (*progress)[I->second] = m_retire->get_instrs_retired(I->first);
+  }
+}
+
+
+// GPU shared memory is not saved : its contents do not outlive a block
+void core_c::checkpoint(checkpoint_c* ckpt)
+{
+  m_icache->checkpoint(ckpt);
+  m_bp_data->checkpoint(ckpt);
+
+  if (m_const_cache) {
+    m_const_cache->checkpoint(ckpt);
+    m_texture_cache->checkpoint(ckpt);
+  }
+}
+
+
+// functional warmup : instruction cache
+// the frontend fetches a line once for consecutive instructions, so do we
+void core_c::warmup_fetch(int tid, Addr pc, Counter inst_num)
+{
+  // prefetchers trained once per instruction use the instruction number
+  m_warmup_uop->m_inst_num  = inst_num;
+  m_warmup_uop->m_thread_id = tid;
+  m_warmup_uop->m_core_id   = m_core_id;
+
+  if (*m_simBase->m_knobs->KNOB_PERFECT_ICACHE)
+    return ;
+
+  Addr fetch_addr = pc + m_icache->base_cache_line((unsigned long)UINT_MAX *
+      (get_trace_info(tid)->m_process->m_process_id) * 10ul);
+  Addr line_addr = m_icache->base_cache_line(fetch_addr);
+  if (line_addr == m_warmup_fetch_line)
+    return ;
+  m_warmup_fetch_line = line_addr;
+
+  Addr repl_line_addr;
+  int appl_id = get_appl_id(tid);
+  if (m_icache->access_cache(fetch_addr, &line_addr, true, appl_id))
+    return ;
+
+  m_simBase->m_memory->warmup(MEM_L2, MRT_IFETCH, line_addr, pc, NULL, m_core_id, tid, 
+      m_core_type == "ptx");
+  m_icache->insert_cache(fetch_addr, &line_addr, &repl_line_addr, appl_id, 
+      m_core_type == "ptx");
+}
+
+
+// functional warmup : branch predictors
+// same sequence as the frontend (prediction) and exec (update/recovery), but the branch
+// is resolved right away
+void core_c::warmup_branch(int tid, Addr pc, Cf_Type cf_type, bool dir, Addr target)
+{
+  uop_c* uop = m_warmup_uop;
+  uop->m_pc          = pc;
+  uop->m_cf_type     = cf_type;
+  uop->m_dir         = dir;
+  uop->m_target_addr = target;
+  uop->m_core_id     = m_core_id;
+  uop->m_thread_id   = tid;
+  uop->m_off_path    = false;
+
+  bool btb_miss = false;
+  if (*KNOB(KNOB_ENABLE_BTB))
+    btb_miss = (m_bp_data->m_bp_targ_pred->pred(uop) != target);
+
+  bool mispredicted = btb_miss;
+  if (cf_type == CF_BR || cf_type == CF_CBR) {
+    if (m_bp_data->m_bp->pred(uop) != dir)
+      mispredicted = true;
+  }
+
+  if (!*m_simBase->m_knobs->KNOB_USE_BRANCH_PREDICTION && m_core_type == "ptx" && 
+      *m_simBase->m_knobs->KNOB_MT_NO_FETCH_BR)
+    mispredicted = false;
+
+  if (*m_simBase->m_knobs->KNOB_PERFECT_BP)
+    mispredicted = false;
+
+  if (cf_type == CF_CBR)
+    m_bp_data->m_bp->update(uop);
+
+  if (mispredicted)
+    m_bp_data->m_bp->recover(&uop->m_recovery_info);
+
+  if (btb_miss)
+    m_bp_data->m_bp_targ_pred->update(uop);
+}
+
+
+// functional warmup : data caches
+// GPU shared memory is not warmed up (see checkpoint)
+void core_c::warmup_access(int tid, Addr pc, Addr addr, Mem_Type type)
+{
+  if (*m_simBase->m_knobs->KNOB_PERFECT_DCACHE)
+    return ;
+
+  bool ptx = (m_core_type == "ptx");
+  switch (type) {
+    case MEM_LD_SM:
+    case MEM_ST_SM:
+      return ;
+    case MEM_LD_CM:
+    case MEM_LD_TM: {
+      readonly_cache_c* cache = (type == MEM_LD_CM) ? m_const_cache : m_texture_cache;
+      if (cache->warmup(addr, get_appl_id(tid)))
+        return ;
+      m_simBase->m_memory->warmup(MEM_L2, MRT_DFETCH, addr, pc, m_warmup_uop, m_core_id, 
+          tid, ptx);
+      return ;
+    }
+    case MEM_ST:
+    case MEM_ST_LM:
+    case MEM_ST_GM:
+      m_simBase->m_memory->warmup(MEM_L1, MRT_DSTORE, addr, pc, m_warmup_uop, m_core_id, 
+          tid, ptx);
+      return ;
+    default:
+      m_simBase->m_memory->warmup(MEM_L1, MRT_DFETCH, addr, pc, m_warmup_uop, m_core_id, 
+          tid, ptx);
+      return ;
+  }
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -46,6 +46,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "macsim.h"
 #include "global_defs.h"
 #include "global_types.h"
+#include "uop.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -142,11 +143,37 @@ class core_c
      */
     Counter get_cycle_count(void) {return m_core_cycle_count;}
 
-    /*! \fn void inc_core_cycle_count(void)
+    /*! \fn void inc_core_cycle_count(Counter num_cycles)
      *  \brief Function to increment core cycle count
+     *  \param num_cycles - number of cycles
      *  \return void
      */
-    void inc_core_cycle_count(void) { m_core_cycle_count++; }
+    void inc_core_cycle_count(Counter num_cycles = 1) { m_core_cycle_count += num_cycles; }
+
+    /*! \fn bool is_stalled(void)
+     *  \brief Function to check whether the current cycle is a known pipeline stall
+     *  \return bool - true if run_a_cycle can be replaced by skip_cycles
+     */
+    bool is_stalled(void) { return m_simBase->m_core_cycle[m_core_id] < m_stall_end; }
+
+    /*! \fn Counter get_num_idle_cycles(void)
+     *  \brief Function to return the number of stalled cycles after the current cycle
+     *  \return Counter - number of cycles (ULLONG_MAX : until wake_up)
+     */
+    Counter get_num_idle_cycles(void);
+
+    /*! \fn void skip_cycles(Counter num_cycles)
+     *  \brief Function to account stalled cycles without running the pipeline
+     *  \param num_cycles - number of cycles
+     *  \return void
+     */
+    void skip_cycles(Counter num_cycles);
+
+    /*! \fn void wake_up(void)
+     *  \brief Function to end a stall when an external event changes the core state
+     *  \return void
+     */
+    void wake_up(void);
 
     /*! \fn void advance_queues(void)
      *  \brief Function to advance queues 
@@ -172,6 +199,12 @@ class core_c
      */
     frontend_c* get_frontend(void) { return m_frontend;}
 
+    /*! \fn smc_rob_c* get_gpu_rob(void)
+     *  \brief Function to get pointer to GPU reorder buffer
+     *  \return smc_rob_c* - Pointer to GPU reorder buffer (NULL for CPU cores)
+     */
+    smc_rob_c* get_gpu_rob(void) { return m_gpu_rob; }
+
     /*! \fn Counter check_heartbeat(bool final)
      *  \brief Function to check if final heartbeat for cores
      *  \param final - TRUE or FALSE
@@ -300,6 +333,49 @@ class core_c
      */
     void create_trace_info(int tid, thread_s* thread);
 
+    /**
+     * Get the number of retired instructions of each running thread
+     */
+    void get_thread_progress(unordered_map<thread_s*, Counter>* progress);
+
+    /**
+     * Save or restore the instruction cache, branch predictors and GPU read-only caches
+     */
+    void checkpoint(checkpoint_c* ckpt);
+
+    /**
+     * Functional warmup : access the instruction cache
+     * @param tid thread id
+     * @param pc pc address
+     * @param inst_num instruction number
+     */
+    void warmup_fetch(int tid, Addr pc, Counter inst_num);
+
+    /**
+     * Functional warmup : train the branch predictor and the BTB with a resolved branch
+     * @param tid thread id
+     * @param pc pc address
+     * @param cf_type branch type
+     * @param dir actual direction
+     * @param target actual target address
+     */
+    void warmup_branch(int tid, Addr pc, Cf_Type cf_type, bool dir, Addr target);
+
+    /**
+     * Functional warmup : access the data caches (and the TLB)
+     * @param tid thread id
+     * @param pc pc address
+     * @param addr memory address
+     * @param type memory type
+     */
+    void warmup_access(int tid, Addr pc, Addr addr, Mem_Type type);
+
+    /**
+     * Check whether the next core cycle can run alongside other cores, i.e. it cannot
+     * call the process manager (thread termination or creation)
+     */
+    bool is_parallel_safe(void);
+
     /**
      * Increase and return the unique uop number. Each uop will have unique uop number in a core.
      */
@@ -348,6 +424,18 @@ class core_c
     Counter                     m_max_inst_fetched; /**< maximum inst fetched */
 
   private:
+    /*! \fn void check_stall(void)
+     *  \brief Function to detect a pipeline stall after a cycle
+     *  \return void
+     */
+    void check_stall(void);
+
+    /*! \fn bool is_heartbeat_pending(void)
+     *  \brief Function to check whether a heartbeat message is due
+     *  \return bool - true if check_heartbeat prints a message
+     */
+    bool is_heartbeat_pending(void);
+
     int                      m_core_id; /**< core id */
     string                   m_core_type; /**< simulation core type (x86 or ptx) */
     Unit_Type                m_unit_type; /**< core type */
@@ -383,6 +471,8 @@ class core_c
     pool_c<uop_c>                  *m_uop_pool; /**< uop pool */
     map_c*                          m_map; /**< dependence information */
     bp_data_c*                      m_bp_data; /**< branch predictor */
+    uop_c*                          m_warmup_uop; /**< uop used by the functional warmup */
+    Addr                            m_warmup_fetch_line; /**< last icache line warmed up */
     
     // heartbeat 
     unordered_map<int, heartbeat_s*> m_heartbeat; /**< heartbeat per thread*/
@@ -402,9 +492,17 @@ class core_c
     int m_appl_id; /**< id of currently running application */
     
     unordered_map<int, thread_s*> m_thread_trace_info; /**< thread trace information */
+    unordered_map<int, thread_s*> m_main_threads; /**< running main threads */
     unordered_map<int, bp_recovery_info_c*>  m_bp_recovery_info; /**< thread bp recovery info */
 
     // clock cycle
     Counter m_cycle; /**< clock cycle */
+
+    // cycle skipping
+    bool            m_cycle_skip; /**< detect pipeline stalls */
+    Counter         m_stall_end; /**< first core cycle after the current stall */
+    bool            m_stall_checked; /**< previous cycle was a stall candidate */
+    vector<Counter> m_stall_state; /**< pipeline state of the stall candidate */
+    vector<Counter> m_stall_prev_state; /**< pipeline state of the previous candidate */
 };
 #endif   // CORE_H_INCLUDED
@@ -0,0 +1,101 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : decode_cache.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : decoded instructions shared by all threads of an application
+ *********************************************************************************************/
+
+#include "decode_cache.h"
+#include "macsim.h"
+#include "trace_read.h"
+#include "assert_macros.h"
+
+#include "all_knobs.h"
+
+
+decode_cache_c::decode_cache_c(macsim_c* simBase)
+{
+  m_simBase    = simBase;
+  m_num_bucket = *KNOB(KNOB_DECODE_CACHE_SIZE);
+  ASSERTM((m_num_bucket & (m_num_bucket - 1)) == 0, 
+      "decode_cache_size %u is not a power of two\n", m_num_bucket);
+
+  m_bucket = NULL;
+  if (m_num_bucket > 0) {
+    m_bucket = new atomic<decode_entry_s*>[m_num_bucket];
+    for (unsigned ii = 0; ii < m_num_bucket; ++ii)
+      m_bucket[ii].store(NULL, memory_order_relaxed);
+  }
+}
+
+
+decode_cache_c::~decode_cache_c()
+{
+  clear();
+  delete[] m_bucket;
+}
+
+
+decode_entry_s* decode_cache_c::create_entry(Addr addr, int num_uop)
+{
+  decode_entry_s* entry = new decode_entry_s;
+  entry->m_addr    = addr;
+  entry->m_num_uop = num_uop;
+  entry->m_uop     = new trace_uop_s[num_uop];
+  entry->m_next    = NULL;
+
+  return entry;
+}
+
+
+void decode_cache_c::insert(decode_entry_s* entry)
+{
+  // single writer (decoding is serialized), so a plain load of the head is enough
+  atomic<decode_entry_s*>& head = m_bucket[hash(entry->m_addr)];
+  entry->m_next = head.load(memory_order_relaxed);
+  head.store(entry, memory_order_release);
+}
+
+
+void decode_cache_c::clear(void)
+{
+  for (unsigned ii = 0; ii < m_num_bucket; ++ii) {
+    decode_entry_s* entry = m_bucket[ii].load(memory_order_relaxed);
+    while (entry) {
+      decode_entry_s* next = entry->m_next;
+      delete[] entry->m_uop;
+      delete entry;
+      entry = next;
+    }
+    m_bucket[ii].store(NULL, memory_order_relaxed);
+  }
+}
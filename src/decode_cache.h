@@ -0,0 +1,133 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : decode_cache.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : decoded instructions shared by all threads of an application
+ *********************************************************************************************/
+
+#ifndef DECODE_CACHE_H_INCLUDED
+#define DECODE_CACHE_H_INCLUDED
+
+
+#include <atomic>
+
+#include "global_defs.h"
+#include "global_types.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Decoded uops of one static instruction
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct decode_entry_s {
+  Addr            m_addr; /**< instruction address */
+  int             m_num_uop; /**< number of uops */
+  trace_uop_s*    m_uop; /**< uop templates (static fields only) */
+  decode_entry_s* m_next; /**< next entry in the bucket */
+} decode_entry_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PC-keyed cache of decoded instructions
+///
+/// Once an instruction has been decoded into the instruction hash table of its application,
+/// its uops are stored here as trace_uop_s templates. Later instances of the instruction, from
+/// any thread or core, copy the templates and only add their dynamic information.
+///
+/// Lookups do not lock: entries are immutable once inserted and are published with a release
+/// store at the head of their bucket. Insertions are made while decoding, which is serialized
+/// by decode_lock_c, and the cache is only cleared between kernels.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class decode_cache_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    decode_cache_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~decode_cache_c();
+
+    /**
+     * Cache is enabled
+     */
+    bool is_enabled(void) const { return m_num_bucket > 0; }
+
+    /**
+     * Find the decoded uops of an instruction (NULL if not decoded yet)
+     */
+    const decode_entry_s* lookup(Addr addr) const
+    {
+      if (m_num_bucket == 0)
+        return NULL;
+
+      decode_entry_s* entry = m_bucket[hash(addr)].load(memory_order_acquire);
+      while (entry && entry->m_addr != addr)
+        entry = entry->m_next;
+      return entry;
+    }
+
+    /**
+     * Allocate an entry to be filled and inserted
+     */
+    decode_entry_s* create_entry(Addr addr, int num_uop);
+
+    /**
+     * Publish a filled entry
+     */
+    void insert(decode_entry_s* entry);
+
+    /**
+     * Remove all entries (no lookup may be in flight)
+     */
+    void clear(void);
+
+  private:
+    decode_cache_c(); // do not implement
+
+    /**
+     * Bucket index of an instruction address
+     */
+    unsigned hash(Addr addr) const
+    {
+      return static_cast<unsigned>((addr ^ (addr >> 12)) & (m_num_bucket - 1));
+    }
+
+  private:
+    macsim_c*                     m_simBase; /**< macsim_c base class for simulation globals */
+    unsigned                      m_num_bucket; /**< number of buckets */
+    atomic<decode_entry_s*>*      m_bucket; /**< bucket heads */
+};
+
+#endif
@@ -49,3 +49,15 @@ dram_c::~dram_c()
 {
 }
 
+
+bool dram_c::is_idle(void)
+{
+  return false;
+}
+
+
+void dram_c::skip_cycles(Counter num_cycles)
+{
+  m_cycle += num_cycles;
+}
+
@@ -74,6 +74,17 @@ class dram_c
      */
     virtual void run_a_cycle(bool) = 0;
 
+    /**
+     * Check whether the controller has no pending request
+     * (conservative by default: never idle)
+     */
+    virtual bool is_idle(void);
+
+    /**
+     * Advance the clock without ticking (only when idle)
+     */
+    virtual void skip_cycles(Counter num_cycles);
+
   protected:
     /**
      * Send a packet to NOC
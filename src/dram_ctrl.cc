@@ -140,6 +140,13 @@ void drb_entry_s::reset()
   m_size      = 0;
   m_timestamp = 0;
   m_scheduled = 0;
+  m_seq       = 0;
+  m_prefetch  = false;
+
+  m_age_link.m_prev = NULL;
+  m_age_link.m_next = NULL;
+  m_row_link.m_prev = NULL;
+  m_row_link.m_next = NULL;
 }
 
 
@@ -185,8 +192,8 @@ dram_ctrl_c::dram_ctrl_c(macsim_c* simBase)
   m_bus_width            = *KNOB(KNOB_DRAM_BUS_WIDTH);
   
   // bank
-  m_buffer           = new list<drb_entry_s*>[m_num_bank];
-  m_buffer_free_list = new list<drb_entry_s*>[m_num_bank];
+  m_buffer           = new arena_list_c<drb_entry_s*>[m_num_bank];
+  m_buffer_free_list = new arena_list_c<drb_entry_s*>[m_num_bank];
   m_current_list     = new drb_entry_s*[m_num_bank];
   m_current_rid      = new uint64_t[m_num_bank];
   m_data_ready       = new Counter[m_num_bank];
@@ -255,9 +262,9 @@ dram_ctrl_c::dram_ctrl_c(macsim_c* simBase)
   m_column_latency    = *KNOB(KNOB_DRAM_COLUMN);
 
   // output buffer
-  m_output_buffer = new list<mem_req_s*>;
+  m_output_buffer = new arena_list_c<mem_req_s*>;
   if (*KNOB(KNOB_DRAM_ADDITIONAL_LATENCY)) {
-    m_tmp_output_buffer = new list<mem_req_s*>;
+    m_tmp_output_buffer = new arena_list_c<mem_req_s*>;
   } else {
     m_tmp_output_buffer = NULL;
   }
@@ -350,22 +357,40 @@ bool dram_ctrl_c::insert_new_req(mem_req_s* mem_req)
 // When the buffer is full, flush all prefetches.
 void dram_ctrl_c::flush_prefetch(int bid)
 {
-  list<drb_entry_s*> done_list;
-  for (auto I = m_buffer[bid].begin(), E = m_buffer[bid].end(); I != E; ++I) {
-    if ((*I)->m_req->m_type == MRT_DPRF) {
-      done_list.push_back((*I));
-    }
-  }
+  arena_list_c<drb_entry_s*> done_list;
+  get_prefetch_reqs(bid, &done_list);
 
   for (auto I = done_list.begin(), E  = done_list.end(); I != E; ++I) {
     MEMORY->free_req((*I)->m_req->m_core_id, (*I)->m_req);
     m_buffer_free_list[bid].push_back((*I));
-    m_buffer[bid].remove((*I));
+    remove_req_from_drb(bid, (*I));
     --m_total_req;
   }
 }
 
 
+// collect prefetches in the buffer
+void dram_ctrl_c::get_prefetch_reqs(int bid, arena_list_c<drb_entry_s*>* prefetch_list)
+{
+  for (auto I = m_buffer[bid].begin(), E = m_buffer[bid].end(); I != E; ++I) {
+    if ((*I)->m_req->m_type == MRT_DPRF) {
+      prefetch_list->push_back((*I));
+    }
+  }
+}
+
+
+// collect requests to the same address as the completed one
+void dram_ctrl_c::get_merge_reqs(int bid, drb_entry_s* done, arena_list_c<drb_entry_s*>* merge_list)
+{
+  for (auto I = m_buffer[bid].begin(), E = m_buffer[bid].end(); I != E; ++I) {
+    if ((*I)->m_addr == done->m_addr) {
+      merge_list->push_back((*I));
+    }
+  }
+}
+
+
 // insert a new request to dram request buffer (DRB)
 void dram_ctrl_c::insert_req_in_drb(mem_req_s* mem_req, uint64_t bid, uint64_t rid, uint64_t cid)
 {
@@ -377,12 +402,21 @@ void dram_ctrl_c::insert_req_in_drb(mem_req_s* mem_req, uint64_t bid, uint64_t r
   new_entry->m_timestamp = m_cycle;
 
   // insert new drb entry to drb 
-  m_buffer[bid].push_back(new_entry);
+  new_entry->m_buffer_pos = m_buffer[bid].insert(m_buffer[bid].end(), new_entry);
+  on_drb_insert(new_entry);
 
   POWER_EVENT(POWER_MC_W);
 }
 
 
+// remove an entry from dram request buffer (DRB)
+void dram_ctrl_c::remove_req_from_drb(int bid, drb_entry_s* entry)
+{
+  m_buffer[bid].erase(entry->m_buffer_pos);
+  on_drb_remove(entry);
+}
+
+
 // tick a cycle
 void dram_ctrl_c::run_a_cycle(bool pll_lock)
 {
@@ -413,6 +447,35 @@ void dram_ctrl_c::run_a_cycle(bool pll_lock)
 }
 
 
+// no pending request in the controller
+bool dram_ctrl_c::is_idle(void)
+{
+  return m_total_req == 0 && m_output_buffer->empty() && 
+    (m_tmp_output_buffer == NULL || m_tmp_output_buffer->empty());
+}
+
+
+// advance the clock of an idle controller. per-cycle statistics of
+// skipped ticks are accumulated as if run_a_cycle() had been called.
+void dram_ctrl_c::skip_cycles(Counter num_cycles)
+{
+  ASSERT(is_idle());
+
+  Counter end_cycle = m_cycle + num_cycles;
+  for (int ii = 0; ii < m_num_channel; ++ii) {
+    // data bus becomes available at m_dbus_ready and remains available
+    Counter idle_start = MAX2(m_dbus_ready[ii], m_cycle);
+    if (idle_start < end_cycle) {
+      STAT_EVENT_N(DRAM_CHANNEL0_DBUS_IDLE + ii, end_cycle - idle_start);
+    }
+  }
+
+  m_num_completed_in_last_cycle = 0;
+  m_starvation_cycle = 0;
+  m_cycle = end_cycle;
+}
+
+
 // starvation checking.
 void dram_ctrl_c::progress_check(void)
 {
@@ -497,37 +560,35 @@ void dram_ctrl_c::bank_schedule_complete(void)
 
       // find same address entries
       if (*m_simBase->m_knobs->KNOB_DRAM_MERGE_REQUESTS) {
-        list<drb_entry_s*> temp_list;
-        for (auto I = m_buffer[ii].begin(), E  = m_buffer[ii].end(); I != E; ++I) {
-          if ((*I)->m_addr == m_current_list[ii]->m_addr) {
-            on_complete(*I);
-            if ((*I)->m_req->m_type == MRT_WB) {
-              DEBUG("MC[%d] merged_req:%d addr:0x%llx type:%s done\n", \
-                  m_id, (*I)->m_req->m_id, (*I)->m_req->m_addr, \
-                  mem_req_c::mem_req_type_name[(*I)->m_req->m_type]);
-              MEMORY->free_req((*I)->m_req->m_core_id, (*I)->m_req);
-            }
-            else {
-              if (m_tmp_output_buffer) {
-                (*I)->m_req->m_rdy_cycle = m_cycle + *KNOB(KNOB_DRAM_ADDITIONAL_LATENCY);
-                m_tmp_output_buffer->push_back((*I)->m_req);
-              } else {
-                m_output_buffer->push_back((*I)->m_req);
-              }
-              (*I)->m_req->m_state = MEM_DRAM_DONE;
-              DEBUG("MC[%d] merged_req:%d addr:0x%llx typs:%s done\n", \
-                  m_id, (*I)->m_req->m_id, (*I)->m_req->m_addr, \
-                  mem_req_c::mem_req_type_name[(*I)->m_req->m_type]);
+        arena_list_c<drb_entry_s*> temp_list;
+        get_merge_reqs(ii, m_current_list[ii], &temp_list);
+        for (auto I = temp_list.begin(), E  = temp_list.end(); I != E; ++I) {
+          on_complete(*I);
+          if ((*I)->m_req->m_type == MRT_WB) {
+            DEBUG("MC[%d] merged_req:%d addr:0x%llx type:%s done\n", \
+                m_id, (*I)->m_req->m_id, (*I)->m_req->m_addr, \
+                mem_req_c::mem_req_type_name[(*I)->m_req->m_type]);
+            MEMORY->free_req((*I)->m_req->m_core_id, (*I)->m_req);
+          }
+          else {
+            if (m_tmp_output_buffer) {
+              (*I)->m_req->m_rdy_cycle = m_cycle + *KNOB(KNOB_DRAM_ADDITIONAL_LATENCY);
+              m_tmp_output_buffer->push_back((*I)->m_req);
+            } else {
+              m_output_buffer->push_back((*I)->m_req);
             }
-            temp_list.push_back((*I));
-            m_num_completed_in_last_cycle = m_cycle;
+            (*I)->m_req->m_state = MEM_DRAM_DONE;
+            DEBUG("MC[%d] merged_req:%d addr:0x%llx typs:%s done\n", \
+                m_id, (*I)->m_req->m_id, (*I)->m_req->m_addr, \
+                mem_req_c::mem_req_type_name[(*I)->m_req->m_type]);
           }
+          m_num_completed_in_last_cycle = m_cycle;
         }
 
         for (auto I = temp_list.begin(), E = temp_list.end(); I != E; ++I) {
+          remove_req_from_drb(ii, (*I));
           (*I)->reset();
           m_buffer_free_list[ii].push_back((*I));
-          m_buffer[ii].remove((*I));
           STAT_EVENT(TOTAL_DRAM_MERGE);
           --m_total_req;
         }
@@ -576,7 +637,7 @@ void dram_ctrl_c::bank_schedule_complete(void)
 
 void dram_ctrl_c::delay_packet()
 {
-  vector<mem_req_s*> temp_list;
+  arena_list_c<mem_req_s*> temp_list;
   for (auto itr = m_tmp_output_buffer->begin(), end = m_tmp_output_buffer->end(); itr != end; ++itr) {
     mem_req_s* req = *itr;
     if (req->m_rdy_cycle <= m_cycle) {
@@ -606,7 +667,7 @@ void dram_ctrl_c::send(void)
   if (*KNOB(KNOB_ENABLE_NOC_VC_PARTITION))
     max_iter = 2;
 
-  vector<mem_req_s*> temp_list;
+  arena_list_c<mem_req_s*> temp_list;
 
   // when virtual channels are partitioned for CPU and GPU requests,
   // we need to check individual buffer entries
@@ -680,7 +741,7 @@ void dram_ctrl_c::bank_schedule_new(void)
       m_current_list[ii]->m_state = DRAM_CMD;
       m_current_list[ii]->m_scheduled = m_cycle;
 
-      m_buffer[ii].remove(entry);
+      remove_req_from_drb(ii, entry);
 
       m_bank_ready[ii]     = ULLONG_MAX;
       m_bank_timestamp[ii] = m_cycle;
@@ -702,7 +763,7 @@ void dram_ctrl_c::bank_schedule_new(void)
 
 
 // select highest priority request based on the policy.
-drb_entry_s* dram_ctrl_c::schedule(list<drb_entry_s*> *buffer)
+drb_entry_s* dram_ctrl_c::schedule(arena_list_c<drb_entry_s*> *buffer)
 {
   ASSERT(!buffer->empty());
 
@@ -879,51 +940,244 @@ void dram_ctrl_c::on_run_a_cycle()
 }
 
 
+void dram_ctrl_c::on_drb_insert(drb_entry_s* entry)
+{
+  // empty
+}
+
+
+void dram_ctrl_c::on_drb_remove(drb_entry_s* entry)
+{
+  // empty
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// insert an entry to an arrival-ordered queue. new arrivals are appended at the tail;
+// a promoted prefetch walks back to its arrival position.
+static void drb_queue_insert(drb_queue_s* queue, drb_entry_s* entry, \
+    drb_link_s drb_entry_s::* link)
+{
+  drb_entry_s* prev = queue->m_tail;
+  while (prev != NULL && prev->m_seq > entry->m_seq)
+    prev = (prev->*link).m_prev;
+
+  drb_entry_s* next = (prev != NULL) ? (prev->*link).m_next : queue->m_head;
+  (entry->*link).m_prev = prev;
+  (entry->*link).m_next = next;
+
+  if (prev != NULL)
+    (prev->*link).m_next = entry;
+  else
+    queue->m_head = entry;
+
+  if (next != NULL)
+    (next->*link).m_prev = entry;
+  else
+    queue->m_tail = entry;
+}
+
+
+// remove an entry from an arrival-ordered queue
+static void drb_queue_remove(drb_queue_s* queue, drb_entry_s* entry, \
+    drb_link_s drb_entry_s::* link)
+{
+  drb_entry_s* prev = (entry->*link).m_prev;
+  drb_entry_s* next = (entry->*link).m_next;
+
+  if (prev != NULL)
+    (prev->*link).m_next = next;
+  else
+    queue->m_head = next;
+
+  if (next != NULL)
+    (next->*link).m_prev = prev;
+  else
+    queue->m_tail = prev;
+
+  (entry->*link).m_prev = NULL;
+  (entry->*link).m_next = NULL;
+}
+
+
 dc_frfcfs_c::sort_func::sort_func(dc_frfcfs_c *parent)
 {
   m_parent = parent;
 }
 
 
+// order of the buffer sorted at the previous decision of the bank: entries present then
+// by (demand first, row hit first, age), followed by later arrivals in arrival order.
 bool dc_frfcfs_c::sort_func::operator()(const drb_entry_s* req_a, const drb_entry_s* req_b)
 {
   int bid = req_a->m_bid;
-  int current_rid = m_parent->m_current_rid[bid];
 
-  if (req_a->m_req->m_type != MRT_DPRF && req_b->m_req->m_type == MRT_DPRF)
-    return true;
-  
-  if (req_a->m_req->m_type == MRT_DPRF && req_b->m_req->m_type != MRT_DPRF)
-    return false;
+  bool new_a = req_a->m_seq > m_parent->m_sort_seq[bid];
+  bool new_b = req_b->m_seq > m_parent->m_sort_seq[bid];
+  if (new_a != new_b)
+    return new_b;
 
-  if (req_a->m_rid == current_rid && req_b->m_rid != current_rid)
-    return true;
+  if (!new_a) {
+    if (req_a->m_prefetch != req_b->m_prefetch)
+      return req_b->m_prefetch;
 
-  if (req_a->m_rid != current_rid && req_b->m_rid == current_rid)
-    return false;
+    uint64_t sort_rid = m_parent->m_sort_rid[bid];
+    bool hit_a = req_a->m_rid == sort_rid;
+    bool hit_b = req_b->m_rid == sort_rid;
+    if (hit_a != hit_b)
+      return hit_a;
+  }
 
-  return req_a->m_timestamp < req_b->m_timestamp;
+  return req_a->m_seq < req_b->m_seq;
 }
 
 
 dc_frfcfs_c::dc_frfcfs_c(macsim_c* simBase): dram_ctrl_c(simBase) {
-  m_sort = new sort_func(this);
+  m_sort           = new sort_func(this);
+  m_demand_queue   = new frfcfs_queue_s[m_num_bank];
+  m_prefetch_queue = new frfcfs_queue_s[m_num_bank];
+  m_sort_seq       = new Counter[m_num_bank];
+  m_sort_rid       = new uint64_t[m_num_bank];
+  m_seq            = 0;
+
+  for (int ii = 0; ii < m_num_bank; ++ii) {
+    m_sort_seq[ii] = 0;
+    m_sort_rid[ii] = ULLONG_MAX;
+  }
 }
 
 
 dc_frfcfs_c::~dc_frfcfs_c()
 {
+  delete m_sort;
+  delete[] m_demand_queue;
+  delete[] m_prefetch_queue;
+  delete[] m_sort_seq;
+  delete[] m_sort_rid;
+}
+
+
+// the policy has always compared rows against the open row narrowed to int;
+// keep doing so, otherwise decisions change for rows above 2^31.
+uint64_t dc_frfcfs_c::open_row(int bid)
+{
+  int current_rid = m_current_rid[bid];
+  return current_rid;
+}
+
+
+void dc_frfcfs_c::enqueue(drb_entry_s* entry, bool prefetch)
+{
+  frfcfs_queue_s* queue = prefetch ? &m_prefetch_queue[entry->m_bid] : \
+    &m_demand_queue[entry->m_bid];
+
+  entry->m_prefetch = prefetch;
+  drb_queue_insert(&queue->m_age, entry, &drb_entry_s::m_age_link);
+  drb_queue_insert(&queue->m_row[entry->m_rid], entry, &drb_entry_s::m_row_link);
+}
+
+
+void dc_frfcfs_c::dequeue(drb_entry_s* entry)
+{
+  frfcfs_queue_s* queue = entry->m_prefetch ? &m_prefetch_queue[entry->m_bid] : \
+    &m_demand_queue[entry->m_bid];
+
+  drb_queue_remove(&queue->m_age, entry, &drb_entry_s::m_age_link);
+
+  auto row = queue->m_row.find(entry->m_rid);
+  ASSERT(row != queue->m_row.end());
+  drb_queue_remove(&row->second, entry, &drb_entry_s::m_row_link);
+  if (row->second.empty())
+    queue->m_row.erase(row);
+}
+
+
+void dc_frfcfs_c::on_drb_insert(drb_entry_s* entry)
+{
+  entry->m_seq = ++m_seq;
+  enqueue(entry, entry->m_req->m_type == MRT_DPRF);
 }
 
 
-drb_entry_s* dc_frfcfs_c::schedule(list<drb_entry_s*>* buffer)
+void dc_frfcfs_c::on_drb_remove(drb_entry_s* entry)
 {
-  buffer->sort(*m_sort);
+  dequeue(entry);
+}
+
+
+drb_entry_s* dc_frfcfs_c::pick(frfcfs_queue_s* queue, uint64_t rid)
+{
+  if (queue->m_age.empty())
+    return NULL;
+
+  auto row = queue->m_row.find(rid);
+  if (row != queue->m_row.end())
+    return row->second.m_head;
+
+  return queue->m_age.m_head;
+}
+
+
+drb_entry_s* dc_frfcfs_c::schedule(arena_list_c<drb_entry_s*>* buffer)
+{
+  ASSERT(!buffer->empty());
+  int bid = buffer->front()->m_bid;
+
+  // prefetches promoted to demand (memory_c::adjust_req) since the last decision
+  frfcfs_queue_s* prefetch = &m_prefetch_queue[bid];
+  for (drb_entry_s* entry = prefetch->m_age.m_head; entry != NULL; ) {
+    drb_entry_s* next = entry->m_age_link.m_next;
+    if (entry->m_req->m_type != MRT_DPRF) {
+      dequeue(entry);
+      enqueue(entry, false);
+    }
+    entry = next;
+  }
+
+  uint64_t rid = open_row(bid);
+  m_sort_seq[bid] = m_seq;
+  m_sort_rid[bid] = rid;
+
+  drb_entry_s* entry = pick(&m_demand_queue[bid], rid);
+  if (entry == NULL)
+    entry = pick(prefetch, rid);
+
+  ASSERT(entry);
+  return entry;
+}
+
+
+// same address implies same row: only the row queues need to be searched
+void dc_frfcfs_c::get_merge_reqs(int bid, drb_entry_s* done, arena_list_c<drb_entry_s*>* merge_list)
+{
+  frfcfs_queue_s* queues[2] = {&m_demand_queue[bid], &m_prefetch_queue[bid]};
+  for (int ii = 0; ii < 2; ++ii) {
+    auto row = queues[ii]->m_row.find(done->m_rid);
+    if (row == queues[ii]->m_row.end())
+      continue;
+
+    for (drb_entry_s* entry = row->second.m_head; entry != NULL; \
+        entry = entry->m_row_link.m_next) {
+      if (entry->m_addr == done->m_addr)
+        merge_list->push_back(entry);
+    }
+  }
+
+  merge_list->sort(*m_sort);
+}
+
+
+void dc_frfcfs_c::get_prefetch_reqs(int bid, arena_list_c<drb_entry_s*>* prefetch_list)
+{
+  for (drb_entry_s* entry = m_prefetch_queue[bid].m_age.m_head; entry != NULL; \
+      entry = entry->m_age_link.m_next) {
+    if (entry->m_req->m_type == MRT_DPRF)
+      prefetch_list->push_back(entry);
+  }
 
-  return buffer->front();
+  prefetch_list->sort(*m_sort);
 }
 
 
@@ -933,7 +1187,7 @@ drb_entry_s* dc_frfcfs_c::schedule(list<drb_entry_s*>* buffer)
 dram_simple_ctrl_c::dram_simple_ctrl_c(macsim_c* simBase) : dram_c(simBase)
 {
   m_latency = *KNOB(KNOB_DRAM_ADDITIONAL_LATENCY);
-  m_output_buffer = new list<mem_req_s*>;
+  m_output_buffer = new arena_list_c<mem_req_s*>;
 
   m_cycle = 0;
 }
@@ -962,7 +1216,7 @@ void dram_simple_ctrl_c::run_a_cycle(bool pll_lock)
 
 void dram_simple_ctrl_c::send(void)
 {
-  vector<mem_req_s*> temp_list;
+  arena_list_c<mem_req_s*> temp_list;
 
   for (auto I = m_output_buffer->begin(), E = m_output_buffer->end(); I != E; ++I) {
     mem_req_s* req = (*I);
@@ -42,11 +42,13 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <list>
 #include <fstream>
+#include <unordered_map>
 
 #include "macsim.h"
 #include "dram.h"
 #include "global_types.h"
 #include "global_defs.h"
+#include "arena.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -61,6 +63,18 @@ enum DRAM_STATE {
 }; 
 
 
+typedef struct drb_entry_s drb_entry_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief intrusive link of a drb entry
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct drb_link_s {
+  drb_entry_s* m_prev; /**< previous entry */
+  drb_entry_s* m_next; /**< next entry */
+} drb_link_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief dram request entry class
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -81,6 +95,11 @@ typedef struct drb_entry_s {
   int         m_size;           /**< size */
   Counter     m_timestamp;      /**< last touched cycle */
   Counter     m_scheduled;      /**< scheduled cycle */
+  Counter     m_seq;            /**< arrival sequence number within the controller */
+  bool        m_prefetch;       /**< queued as a prefetch by the scheduling policy */
+  drb_link_s  m_age_link;       /**< link in the per-bank arrival-ordered queue */
+  drb_link_s  m_row_link;       /**< link in the per-row arrival-ordered queue */
+  arena_list_c<drb_entry_s*>::iterator m_buffer_pos; /**< position in the dram request buffer */
   macsim_c*   m_simBase;        /**< macsim_c base class for simulation globals */
   // m_type;
   // m_core_type;
@@ -140,6 +159,16 @@ class dram_ctrl_c : public dram_c
      * Tick a cycle.
      */
     void run_a_cycle(bool);
+
+    /**
+     * Check whether there is no pending request.
+     */
+    bool is_idle(void);
+
+    /**
+     * Advance the clock without ticking (only when idle).
+     */
+    void skip_cycles(Counter num_cycles);
     
     /**
      * Print requests in the buffer
@@ -172,7 +201,23 @@ class dram_ctrl_c : public dram_c
      * Pick the highest priority entry based one the policy.
      * Each dram scheduling policy should override this function.
      */
-    virtual drb_entry_s* schedule(list<drb_entry_s*>* drb_list);
+    virtual drb_entry_s* schedule(arena_list_c<drb_entry_s*>* drb_list);
+
+    /**
+     * Remove an entry from the dram request buffer.
+     */
+    void remove_req_from_drb(int bid, drb_entry_s* entry);
+
+    /**
+     * Collect buffered requests to the same address as the completed one,
+     * in the order they appear in the buffer.
+     */
+    virtual void get_merge_reqs(int bid, drb_entry_s* done, arena_list_c<drb_entry_s*>* merge_list);
+
+    /**
+     * Collect buffered prefetches, in the order they appear in the buffer.
+     */
+    virtual void get_prefetch_reqs(int bid, arena_list_c<drb_entry_s*>* prefetch_list);
 
     /**
      * Schedule each dram channel
@@ -236,14 +281,24 @@ class dram_ctrl_c : public dram_c
      */
     virtual void on_complete(drb_entry_s* req);
 
+    /**
+     * Function to do any book-keeping when an entry enters the buffer
+     */
+    virtual void on_drb_insert(drb_entry_s* entry);
+
+    /**
+     * Function to do any book-keeping when an entry leaves the buffer
+     */
+    virtual void on_drb_remove(drb_entry_s* entry);
+
     /**
      * Function to do any book-keeping that might be needed by scheduling policies
      */
     virtual void on_run_a_cycle();
 
   protected:
-    list<drb_entry_s*> *m_buffer; /**< Dram request buffer (DRB) */
-    list<drb_entry_s*> *m_buffer_free_list; /**< DRB free list */
+    arena_list_c<drb_entry_s*> *m_buffer; /**< Dram request buffer (DRB) */
+    arena_list_c<drb_entry_s*> *m_buffer_free_list; /**< DRB free list */
     drb_entry_s** m_current_list; /**< Currently servicing request in each DRB */
     uint64_t* m_current_rid; /**< Current open row id */
     Counter* m_bank_ready; /**< bank ready cycle */
@@ -271,18 +326,54 @@ class dram_ctrl_c : public dram_c
     int m_precharge_latency; /**< precharge latency */
     int m_column_latency; /**< column access latency */
 
-    list<mem_req_s*>* m_output_buffer; /**< output buffer */
-    list<mem_req_s*>* m_tmp_output_buffer; /**< buffer to simulate any additional dram latency */
+    arena_list_c<mem_req_s*>* m_output_buffer; /**< output buffer */
+    arena_list_c<mem_req_s*>* m_tmp_output_buffer; /**< buffer to simulate any additional dram latency */
 };
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief arrival-ordered intrusive queue of drb entries
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct drb_queue_s {
+  drb_entry_s* m_head; /**< oldest entry */
+  drb_entry_s* m_tail; /**< youngest entry */
+
+  /**
+   * Constructor
+   */
+  drb_queue_s() : m_head(NULL), m_tail(NULL) {}
+
+  /**
+   * Check whether the queue is empty
+   */
+  bool empty(void) const { return m_head == NULL; }
+} drb_queue_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief FR-FCFS queues of one request class (demand or prefetch) in a bank
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct frfcfs_queue_s {
+  drb_queue_s m_age; /**< all entries of the class */
+  unordered_map<uint64_t, drb_queue_s> m_row; /**< entries of the class per row */
+} frfcfs_queue_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief FR-FCFS dram scheduling
+///
+/// Demand requests first, then row-buffer hits, then the oldest request. Instead of
+/// sorting the request buffer on every decision, each bank keeps arrival-ordered demand
+/// and prefetch queues, plus per-row queues, that are updated as entries enter and leave
+/// the buffer. The pick is then the head of the open-row queue or of the age queue.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 class dc_frfcfs_c : public dram_ctrl_c
 {
   /**
    * \brief dc_frfcfs_c sort function
+   *
+   * Orders entries the way a buffer sorted at the last scheduling decision of the bank
+   * (and appended to since) would hold them.
    */
   class sort_func {
     public:
@@ -316,10 +407,57 @@ class dc_frfcfs_c : public dram_ctrl_c
      * Overloaded schedule function
      * @param drb_list - dram request buffer to be scheduled
      */
-    drb_entry_s* schedule(list<drb_entry_s*> *drb_list);
+    drb_entry_s* schedule(arena_list_c<drb_entry_s*> *drb_list);
+
+  protected:
+    /**
+     * Collect same address requests from the row queues
+     */
+    void get_merge_reqs(int bid, drb_entry_s* done, arena_list_c<drb_entry_s*>* merge_list);
+
+    /**
+     * Collect prefetches from the prefetch queue
+     */
+    void get_prefetch_reqs(int bid, arena_list_c<drb_entry_s*>* prefetch_list);
+
+    /**
+     * Enqueue a new entry
+     */
+    void on_drb_insert(drb_entry_s* entry);
+
+    /**
+     * Dequeue a leaving entry
+     */
+    void on_drb_remove(drb_entry_s* entry);
+
+  private:
+    /**
+     * Put an entry into the demand or prefetch queues of its bank
+     */
+    void enqueue(drb_entry_s* entry, bool prefetch);
+
+    /**
+     * Take an entry out of the queues of its bank
+     */
+    void dequeue(drb_entry_s* entry);
+
+    /**
+     * Pick the open-row hit in the class if any, else the oldest entry
+     */
+    drb_entry_s* pick(frfcfs_queue_s* queue, uint64_t rid);
+
+    /**
+     * Row id that the scheduling policy treats as the open row of a bank
+     */
+    uint64_t open_row(int bid);
 
   private:
     class sort_func* m_sort; /**< sort function */
+    frfcfs_queue_s* m_demand_queue; /**< per-bank demand queues */
+    frfcfs_queue_s* m_prefetch_queue; /**< per-bank prefetch queues */
+    Counter m_seq; /**< arrival sequence counter */
+    Counter* m_sort_seq; /**< last arrival seen by the previous decision of a bank */
+    uint64_t* m_sort_rid; /**< open row at the previous decision of a bank */
 };
 
 
@@ -368,7 +506,7 @@ class dram_simple_ctrl_c : public dram_c
 
   private:
     int m_latency; 
-    list<mem_req_s*>* m_output_buffer; /**< output buffer */
+    arena_list_c<mem_req_s*>* m_output_buffer; /**< output buffer */
 };
 
 
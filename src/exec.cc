@@ -596,6 +596,8 @@ bool exec_c::exec(int thread_id, int entry, uop_c* uop)
   if (uop_latency > 0) {
     int max_latency = std::max(uop_latency, static_cast<int>(*m_simBase->m_knobs->KNOB_EXEC_RETIRE_LATENCY));
     uop->m_done_cycle = m_cur_core_cycle + max_latency;
+    if (m_ptx_sim || m_igpu_sim)
+      m_gpu_rob->uop_done(uop);
   }
 
   DEBUG_CORE(m_core_id, "done_exec m_core_id:%d thread_id:%d core_cycle_count:%llu uop_num:%llu"
@@ -743,6 +745,7 @@ void exec_c::run_a_cycle(void)
 
             puop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
             puop->m_state = OS_SCHEDULED;
+            m_gpu_rob->uop_done(puop);
           }
         } // uop->m_parent_uop
         else {
@@ -755,6 +758,8 @@ void exec_c::run_a_cycle(void)
 
       uop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
       uop->m_state = OS_SCHEDULED;
+      if (m_ptx_sim || m_igpu_sim)
+        m_gpu_rob->uop_done(uop);
 
       // HMC atomics nobypass cache case
       if (!(*KNOB(KNOB_ENABLE_HMC_BYPASS_CACHE)))
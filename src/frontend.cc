@@ -77,7 +77,7 @@ bool icache_fill_line_wrapper(mem_req_s *req)
   DEBUG_CORE(req->m_core_id, "req:%d called icache_done_func\n", req->m_id);
 
   // serve merged request
-  list<mem_req_s*> done_list;
+  arena_list_c<mem_req_s*> done_list;
   for (auto I = req->m_merge.begin(), E  = req->m_merge.end(); I != E; ++I) {
     if ((*I)->m_done_func && !((*I)->m_done_func((*I)))) {
       result = false;
@@ -166,6 +166,9 @@ frontend_c::frontend_c(FRONTEND_INTERFACE_PARAMS(), macsim_c* simBase)
   m_fetch_arbiter          = 0;
   m_mem_access_thread_num  = 0;
   m_last_fetch_tid_failed  = false;
+  m_stall_active           = false;
+  m_stall_no_fetch         = false;
+  m_stall_mispred          = false;
 
   FRONTEND_CONFIG();
     
@@ -189,7 +192,7 @@ frontend_c::~frontend_c()
 void frontend_c::run_a_cycle(void)
 {
   // bind core id
-  static bool map_core = false;
+  thread_local static bool map_core = false;
   if (!map_core) {
     m_core = m_simBase->m_core_pointers[m_core_id];
     map_core = false;
@@ -353,6 +356,86 @@ void frontend_c::run_a_cycle(void)
 }
 
 
+// cycle skipping : the next cycle is a stall when the only fetchable thread cannot fetch.
+// Mirrors run_a_cycle(), fetch_rr() and process_ifetch() without changing any state.
+bool frontend_c::check_stall(vector<Counter>* state, Counter* next_event)
+{
+  m_stall_active   = false;
+  m_stall_no_fetch = false;
+  m_stall_mispred  = false;
+
+  // fetching unit is not running or currently no thread has been fetching 
+  if (!m_fe_running || !m_fetching_thread_num) 
+    return true;
+
+  // fetch every cycle from a single thread, which the arbiter already points to
+  // (GPU fetch policies and barriers are not modeled)
+  int tid = m_last_terminated_tid;
+  if (m_knob_ptx_sim || m_fetch_ratio != 1 || m_unique_scheduled_thread_num - tid != 1 || 
+      m_fetch_arbiter != tid) 
+    return false;
+
+  m_stall_active = true;
+  state->push_back(m_last_fetch_tid_failed);
+
+  // already terminated or fetch not ready : nothing to fetch
+  frontend_s* fetch_data = m_core->get_trace_info(tid)->m_fetch_data;
+  if (m_core->m_fetch_ended[tid] || m_core->m_thread_reach_end[tid] || 
+      (KNOB(KNOB_NO_FETCH_ON_ICACHE_MISS)->getValue() && !check_fetch_ready(tid)) ||
+      (fetch_data != NULL && fetch_data->m_fetch_blocked)) {
+    m_stall_no_fetch = true;
+    return true;
+  }
+
+  // frontend queue full
+  if (m_fe_stall || m_q_frontend->space() <= m_knob_fetch_width) 
+    return true;
+
+  state->push_back(fetch_data->m_fe_mode);
+  switch (fetch_data->m_fe_mode) {
+    // icache miss not serviced yet
+    case FRONTEND_MODE_WAIT_FOR_MISS:
+      return !check_fetch_ready(tid);
+
+    // branch misprediction not resolved yet
+    case FRONTEND_MODE_IFETCH: {
+      Counter cycle = m_simBase->m_core_cycle[m_core_id] + 1;
+      Counter resolve_cycle = MAX2(m_bp_data->m_bp_recovery_cycle[tid], 
+          m_bp_data->m_bp_redirect_cycle[tid]);
+      if (fetch_data->m_first_time || resolve_cycle <= cycle)
+        return false;
+
+      m_stall_mispred = true;
+      *next_event = MIN2(*next_event, resolve_cycle);
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+
+// cycle skipping : account stalled cycles
+void frontend_c::skip_cycles(Counter num_cycles)
+{
+  m_cur_core_cycle = m_simBase->m_core_cycle[m_core_id];
+
+  if (m_stall_active) {
+    POWER_CORE_EVENT_N(m_core_id, POWER_BLOCK_STATES_R, num_cycles);
+    POWER_CORE_EVENT_N(m_core_id, POWER_BLOCK_STATES_W, num_cycles);
+  }
+
+  if (m_stall_no_fetch) {
+    STAT_EVENT_N(NUM_NO_FETCH_CYCLES, num_cycles);
+    STAT_CORE_EVENT_N(m_core_id, CORE_NUM_NO_FETCH_CYCLES, num_cycles);
+  }
+
+  if (m_stall_mispred) 
+    STAT_CORE_EVENT_N(m_core_id, BP_MISPRED_STALL, num_cycles);
+}
+
+
 // fetch instructions from a thread
 FRONTEND_MODE frontend_c::process_ifetch(unsigned int tid, frontend_s* fetch_data)
 {
@@ -731,6 +814,10 @@ bool frontend_c::icache_fill_line(mem_req_s *req)
           ii, fetch_data->m_fetch_ready_addr, req->m_addr);
     }
   }
+
+  // a thread waiting for this line can fetch again
+  m_core->wake_up();
+
   return true;
 }
 
@@ -312,6 +312,20 @@ class frontend_c
      */
     bool is_running() { return m_fe_running; }
 
+    /**
+     * Cycle skipping : check whether the next cycle fetches nothing and leaves the
+     * frontend unchanged
+     * @param state - appended with the frontend state that a stalled cycle does not change
+     * @param next_event - lowered to the cycle the stall ends, if known
+     * @return true if the next cycle is a stall
+     */
+    bool check_stall(vector<Counter>* state, Counter* next_event);
+
+    /**
+     * Cycle skipping : account stalled cycles (see check_stall) without running them
+     */
+    void skip_cycles(Counter num_cycles);
+
     /*! \fn int predict_bpu(uop_c *uop)
      *  \brief Function to call branch predictor
      *  \param uop - Pointter to an branch uop
@@ -445,6 +459,9 @@ class frontend_c
     core_c*       m_core; /**< core pointer */
     int           m_mem_access_thread_num; /**< number of threads that access memory */
     int           m_fetch_ratio; /**< how often fetch an instruction (GPU only) */
+    bool          m_stall_active; /**< stalled cycles access the block states table */
+    bool          m_stall_no_fetch; /**< stalled cycles find no thread to fetch */
+    bool          m_stall_mispred; /**< stalled cycles wait for a branch recovery */
 
     bool          m_dcache_bank_busy[129]; /**< dcache bank busy status */
 
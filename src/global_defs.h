@@ -103,6 +103,10 @@ class inst_info_s;
 class thread_queue_c;
 class thread_block_queue_c;
 class process_manager_c;
+class parallel_engine_c;
+class checkpoint_c;
+class sampling_c;
+class interval_stats_c;
 class extra_stat_c;
 class pref_info_c;
 class pc_info_c;
@@ -115,9 +119,13 @@ class noc_c;
 class ManifoldProcessor;
 class trace_read_c;
 class trace_reader_wrapper_c;
+class trace_file_c;
+class trace_prefetcher_c;
+class decode_cache_c;
 class KnobsContainer;
 class ProcessorStatistics;
 class CoreStatistics;
+class AbstractStat;
 class cache_partition_framework_c;
 class dyfr_c;
 class MMU;
@@ -139,6 +147,7 @@ typedef struct Hash_Table_struct Hash_Table;
 typedef struct l2_data_s l2_data_s;
 typedef struct pref_req_info_s pref_req_info_s;
 typedef struct trace_uop_s trace_uop_s;
+typedef struct decode_entry_s decode_entry_s;
 typedef struct TraceBuffer_ TraceBuffer;
 typedef struct mt_scheduler_s mt_scheduler_s;
 typedef struct reconv_data_s recove_data_s;
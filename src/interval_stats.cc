@@ -0,0 +1,184 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : interval_stats.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : periodic snapshots of stat counters in a columnar binary file
+ *********************************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <sys/stat.h>
+
+#include "interval_stats.h"
+#include "macsim.h"
+#include "statistics.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+#include "utils.h"
+
+#include "all_knobs.h"
+
+
+interval_stats_c::interval_stats_c(macsim_c* simBase)
+{
+  m_simBase    = simBase;
+  m_file       = NULL;
+  m_interval   = *KNOB(KNOB_STAT_INTERVAL_CYCLE);
+  m_next_cycle = m_interval;
+  m_last_cycle = 0;
+  m_num_row    = 0;
+
+  if (m_interval == 0)
+    return;
+
+  // columns : stat names separated by ':'
+  stringstream list(KNOB(KNOB_STAT_INTERVAL_LIST)->getValue());
+  string name;
+  while (getline(list, name, ':')) {
+    if (name != "")
+      add_column(name);
+  }
+
+  string dir = *KNOB(KNOB_STATISTICS_OUT_DIRECTORY);
+  mkdir(dir.c_str(), S_IRWXU);
+
+  string filename = dir + "/" + KNOB(KNOB_STAT_INTERVAL_FILE)->getValue();
+  m_file = fopen(filename.c_str(), "wb");
+  ASSERTM(m_file, "cannot open %s\n", filename.c_str());
+
+  // schema header
+  uns32 version    = INTERVAL_STATS_VERSION;
+  uns32 num_column = m_name.size() + 1;
+  fwrite(INTERVAL_STATS_MAGIC, 1, 8, m_file);
+  fwrite(&version, sizeof(version), 1, m_file);
+  fwrite(&num_column, sizeof(num_column), 1, m_file);
+  fwrite(&m_interval, sizeof(m_interval), 1, m_file);
+
+  for (int ii = -1; ii < static_cast<int>(m_name.size()); ++ii) {
+    const string& column = (ii == -1) ? string("CYCLE") : m_name[ii];
+    uns32 length = column.size();
+    fwrite(&length, sizeof(length), 1, m_file);
+    fwrite(column.c_str(), 1, length, m_file);
+  }
+
+  m_block.resize(static_cast<size_t>(num_column) * INTERVAL_STATS_BLOCK_ROWS);
+}
+
+
+interval_stats_c::~interval_stats_c()
+{
+  if (m_file != NULL) {
+    flush();
+    fclose(m_file);
+  }
+}
+
+
+// add the column of a global stat, or one column per core of a per-core stat
+void interval_stats_c::add_column(const string& name)
+{
+  ProcessorStatistics* stats = m_simBase->m_ProcessorStats;
+
+  for (int ii = 0; ii < stats->globalStats()->size(); ++ii) {
+    AbstractStat& stat = (*stats)[ii];
+    if (stat.getName() == name) {
+      m_name.push_back(name);
+      m_stat.push_back(&stat);
+      return;
+    }
+  }
+
+  bool found = false;
+  for (unsigned int core_id = 0; core_id < stats->getNumCores(); ++core_id) {
+    CoreStatistics& core_stats = stats->core(core_id);
+    for (int ii = 0; ii < core_stats.size(); ++ii) {
+      AbstractStat& stat = core_stats[ii];
+      if (stat.getName() == name) {
+        m_name.push_back(name + "_CORE_" + to_string(core_id));
+        m_stat.push_back(&stat);
+        found = true;
+        break;
+      }
+    }
+  }
+
+  ASSERTM(found, "stat_interval_list : unknown stat %s\n", name.c_str());
+}
+
+
+// record the current counts (no allocation : the block buffer is preallocated)
+void interval_stats_c::snapshot(Counter cycle)
+{
+  Counter* row = &m_block[m_num_row];
+  row[0] = cycle;
+  for (size_t ii = 0; ii < m_stat.size(); ++ii) {
+    row[(ii + 1) * INTERVAL_STATS_BLOCK_ROWS] = m_stat[ii]->getCount();
+  }
+
+  m_last_cycle = cycle;
+  while (m_next_cycle <= cycle)
+    m_next_cycle += m_interval;
+
+  if (++m_num_row == INTERVAL_STATS_BLOCK_ROWS)
+    flush();
+}
+
+
+// write buffered snapshots as one block
+void interval_stats_c::flush(void)
+{
+  if (m_num_row == 0)
+    return;
+
+  uns32 num_row = m_num_row;
+  fwrite(&num_row, sizeof(num_row), 1, m_file);
+  for (size_t ii = 0; ii <= m_stat.size(); ++ii) {
+    fwrite(&m_block[ii * INTERVAL_STATS_BLOCK_ROWS], sizeof(Counter), m_num_row, m_file);
+  }
+
+  m_num_row = 0;
+}
+
+
+void interval_stats_c::finalize(Counter cycle)
+{
+  if (m_file == NULL)
+    return;
+
+  if (cycle > m_last_cycle)
+    snapshot(cycle);
+
+  flush();
+  fclose(m_file);
+  m_file = NULL;
+}
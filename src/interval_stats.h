@@ -0,0 +1,139 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : interval_stats.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : periodic snapshots of stat counters in a columnar binary file
+ *********************************************************************************************/
+
+#ifndef INTERVAL_STATS_H_INCLUDED
+#define INTERVAL_STATS_H_INCLUDED
+
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "global_defs.h"
+#include "global_types.h"
+
+
+/** File magic */
+#define INTERVAL_STATS_MAGIC "MSIVSTAT"
+
+/** File format version */
+#define INTERVAL_STATS_VERSION 1
+
+/** Snapshots buffered before a block is written */
+#define INTERVAL_STATS_BLOCK_ROWS 1024
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Interval statistics sink
+///
+/// Every STAT_INTERVAL_CYCLE cycles, the cumulative counts of the stats listed in
+/// STAT_INTERVAL_LIST are recorded. A per-core stat adds one column per core. The file
+/// starts with a schema header, followed by blocks of up to INTERVAL_STATS_BLOCK_ROWS
+/// snapshots stored column by column (all values are host-endian):
+///
+///   char[8] magic, uns32 version, uns32 number of columns, uns64 interval,
+///   per column : uns32 name length, name (column 0 is CYCLE)
+///   per block  : uns32 number of rows, per column : uns64 value[rows]
+///
+/// Snapshots go into a buffer allocated up front, so taking one does not allocate.
+/// tools/interval_reader converts the file to CSV.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class interval_stats_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    interval_stats_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~interval_stats_c();
+
+    /**
+     * Take a snapshot when an interval boundary has been crossed
+     */
+    void check(Counter cycle)
+    {
+      if (m_file != NULL && cycle >= m_next_cycle)
+        snapshot(cycle);
+    }
+
+    /**
+     * Cycle of the next snapshot (MAX_CTR : disabled)
+     */
+    Counter get_next_cycle(void)
+    {
+      return (m_file != NULL) ? m_next_cycle : MAX_CTR;
+    }
+
+    /**
+     * Record the final counts and close the file
+     */
+    void finalize(Counter cycle);
+
+  private:
+    interval_stats_c(); // do not implement
+
+    /**
+     * Add the column(s) of a stat
+     */
+    void add_column(const string& name);
+
+    /**
+     * Record the current counts
+     */
+    void snapshot(Counter cycle);
+
+    /**
+     * Write buffered snapshots
+     */
+    void flush(void);
+
+  private:
+    macsim_c*             m_simBase; /**< macsim_c base class for simulation globals */
+    FILE*                 m_file; /**< output file (NULL : disabled) */
+    Counter               m_interval; /**< snapshot interval in cycles */
+    Counter               m_next_cycle; /**< cycle of the next snapshot */
+    Counter               m_last_cycle; /**< cycle of the last snapshot */
+    vector<string>        m_name; /**< column names (without CYCLE) */
+    vector<AbstractStat*> m_stat; /**< stat of each column */
+    vector<Counter>       m_block; /**< buffered snapshots, column by column */
+    int                   m_num_row; /**< buffered snapshots */
+};
+
+#endif
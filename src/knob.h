@@ -234,6 +234,38 @@ template<class T> class KnobTemplate : public abstract_knob_c
 };
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Knob with a value fixed at build time
+///
+/// knobgen.pl generates these for the knobs in the params file given to it, so that
+/// *KNOB(var) folds to a constant. The runtime knob with the same name is still registered
+/// and all_knobs_c::checkFixedKnobs() rejects a different value.
+///////////////////////////////////////////////////////////////////////////////////////////////
+template<class T> class KnobConstant
+{
+  public:
+    /**
+     * Constructor.
+     * @param val value of the knob
+     */
+    constexpr KnobConstant(const T val) : m_value(val) { }
+
+    /**
+     * Get the value of the knob.
+     */
+    constexpr T getValue() const { return m_value; }
+
+    /**
+     * Conversion operator ().
+     * Return the value of the knob.
+     */
+    constexpr operator T() const { return m_value; }
+
+  private:
+    const T m_value; /**< knob value */
+};
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief string type knob class
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -66,6 +66,12 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "dram.h"
 #include "dyfr.h"
 #include "mmu.h"
+#include "parallel_engine.h"
+#include "trace_prefetch.h"
+#include "checkpoint.h"
+#include "sampling.h"
+#include "interval_stats.h"
+#include "arena.h"
 
 #include "all_knobs.h"
 #include "all_stats.h"
@@ -100,6 +106,7 @@ macsim_c::macsim_c()
   m_no_threads_per_block           = 0;
   m_total_retired_block            = 0;
   m_end_simulation                 = false;
+  m_checkpoint_pending             = false;
   m_repeat_done                    = false;
   m_gpu_paused                     = true;
 
@@ -115,6 +122,9 @@ macsim_c::macsim_c()
 
   m_pll_lockout = 0;
   m_hmc_trans_id_gen = 0;
+
+  m_parallel_engine = NULL;
+  m_trace_prefetcher = NULL;
 }
 
 
@@ -167,6 +177,12 @@ void macsim_c::init_knobs(int argc, char** argv)
   }
 #endif
 
+  // knobs fixed at build time (knobgen.pl with a params file) cannot be changed
+  if (!m_knobs->checkFixedKnobs()) {
+    fprintf(stderr, "rebuild with the new knob values\n");
+    exit(15);
+  }
+
   //save the states of all knobs to a file
   m_knobsContainer->saveToFile("params.out");
 }
@@ -207,6 +223,11 @@ void macsim_c::register_functions(void)
   network_factory_c::get()->register_class("ring", default_network);
   network_factory_c::get()->register_class("mesh", default_network);
   network_factory_c::get()->register_class("simple_noc", default_network);
+  network_factory_c::get()->register_class("flat_ring", default_network);
+  network_factory_c::get()->register_class("flat_mesh", default_network);
+  network_factory_c::get()->register_class("analytic", default_network);
+  network_factory_c::get()->register_class("torus", default_network);
+  network_factory_c::get()->register_class("cmesh", default_network);
 }
 
 
@@ -218,7 +239,6 @@ void macsim_c::init_memory(void)
   // pool allocation
   m_thread_pool           = new pool_c<thread_s>(10, "thread_pool"); 
   m_section_pool          = new pool_c<section_info_s>(100, "section_pool"); 
-  m_mem_map_entry_pool    = new pool_c<mem_map_entry_c>(200, "mem_map_pool");
   m_heartbeat_pool        = new pool_c<heartbeat_s>(10, "heartbeat_pool");
   m_bp_recovery_info_pool = new pool_c<bp_recovery_info_c>(10, "bp_recovery_info_pool");
   m_trace_node_pool       = new pool_c<thread_trace_info_node_s>(10, "thread_node_pool");
@@ -228,6 +248,10 @@ void macsim_c::init_memory(void)
   m_process_manager = new process_manager_c(m_simBase);
   m_trace_reader = new trace_reader_wrapper_c(m_simBase);
 
+  // background trace decompression
+  if (*KNOB(KNOB_TRACE_PREFETCH_DEPTH) > 0)
+    m_trace_prefetcher = new trace_prefetcher_c(m_simBase);
+
   // block schedule info
   block_schedule_info_s* block_schedule_info = new block_schedule_info_s;
   m_block_schedule_info[0] = block_schedule_info;
@@ -580,10 +604,15 @@ void macsim_c::open_traces(string trace_list)
 // =======================================
 void macsim_c::deallocate_memory(void)
 {
+  // stop worker threads first
+  delete m_parallel_engine;
+  m_parallel_engine = NULL;
+  delete m_trace_prefetcher;
+  m_trace_prefetcher = NULL;
+
   // memory deallocation
   delete m_thread_pool;
   delete m_section_pool; 
-  delete m_mem_map_entry_pool;
   delete m_heartbeat_pool;
   delete m_bp_recovery_info_pool;
   delete m_trace_node_pool;
@@ -718,6 +747,7 @@ void macsim_c::initialize(int argc, char** argv)
   // initialize stats
   m_coreStatsTemplate = new CoreStatistics(m_simBase);
   m_ProcessorStats = new ProcessorStatistics(m_simBase);
+  arena_c::init(m_simBase);
 
   m_allStats = new all_stats_c(m_ProcessorStats);
   m_allStats->initialize(m_ProcessorStats, m_coreStatsTemplate);
@@ -770,12 +800,42 @@ void macsim_c::initialize(int argc, char** argv)
   m_MMU = make_unique<MMU>();
   m_MMU->initialize(m_simBase);
 
+  // sampled simulation
+  m_sampling = make_unique<sampling_c>(m_simBase);
+
+  // interval statistics
+  m_interval_stats = make_unique<interval_stats_c>(m_simBase);
+
+  // restore warmed-up state (thread positions are applied when traces are opened)
+  string checkpoint_load = KNOB(KNOB_CHECKPOINT_LOAD)->getValue();
+  if (strcmp(checkpoint_load.c_str(), "NULL")) {
+    checkpoint_c checkpoint(m_simBase);
+    checkpoint.load(checkpoint_load);
+  }
+
+  string checkpoint_save = KNOB(KNOB_CHECKPOINT_SAVE)->getValue();
+  if (strcmp(checkpoint_save.c_str(), "NULL")) {
+    ASSERTM(*KNOB(KNOB_CHECKPOINT_SAVE_INST) || *KNOB(KNOB_CHECKPOINT_SAVE_CYCLE),
+        "checkpoint_save requires checkpoint_save_inst or checkpoint_save_cycle\n");
+    m_checkpoint_pending = true;
+  }
+
   // open traces
   string trace_name_list = static_cast<string>(*KNOB(KNOB_TRACE_NAME_FILE));
   open_traces(trace_name_list);
 
   // any number other than 0, to pass the first simulation loop iteration
   m_num_running_core = 10000; 
+
+  // multi-threaded core stepping
+  if (*KNOB(KNOB_NUM_SIM_THREADS) > 1 && parallel_engine_c::is_supported(m_simBase)) {
+    m_parallel_engine = new parallel_engine_c(m_simBase, *KNOB(KNOB_NUM_SIM_THREADS));
+  }
+
+  // multi-threaded router stepping
+  if (*KNOB(KNOB_ENABLE_NEW_NOC) && *KNOB(KNOB_NOC_NUM_THREADS) > 1) {
+    m_network->enable_parallel(*KNOB(KNOB_NOC_NUM_THREADS));
+  }
 }
 
 
@@ -891,8 +951,58 @@ int macsim_c::run_a_cycle()
     m_num_running_core = 0;
   }
 
+#if !defined(USING_SST) && !defined(IRIS)
+  // jump over cycles in which no component has work to do (frequency changes
+  // by dyfr are sampled on every cycle, so skipping is disabled with dyfr)
+  if (*KNOB(KNOB_ENABLE_CYCLE_SKIP) && !*KNOB(KNOB_ENABLE_DYFR)) {
+    skip_idle_cycles();
+  }
+#endif
+
+  if (m_parallel_engine) {
+    run_parallel_cycles();
+    m_interval_stats->check(m_simulation_cycle);
+
+    if (m_checkpoint_pending && check_checkpoint()) {
+      return 0; //simulation finished
+    }
+    return 1; //simulation not finished
+  }
+
   Counter pivot = m_core_cycle[0] + 1;
 
+  bool pll_locked = run_uncore_cycle();
+
+  // core execution loop
+  for (int kk = 0; kk < m_num_sim_cores; ++kk) {
+    // use pivot to randomize core run_cycle pattern 
+    unsigned int ii = (kk+pivot) % m_num_sim_cores;
+
+    if (!tick_core_clock(ii)) {
+      continue;
+    }
+
+    if (run_core_cycle(ii, pll_locked, m_simulation_cycle)) {
+      m_num_running_core++;
+    }
+  }
+
+  end_cycle();
+  m_interval_stats->check(m_simulation_cycle);
+
+  if (m_checkpoint_pending && check_checkpoint()) {
+    return 0; //simulation finished
+  }
+
+  return 1; //simulation not finished
+}
+
+
+// =======================================
+// Run pll/dyfr, MMU, and uncore components (NOC, LLC, MC) : returns pll lock state
+// =======================================
+bool macsim_c::run_uncore_cycle(void)
+{
   // Dynamic Frequency
   // on lock pll is trying to lock on frequency - all units stall
   bool pll_locked = (m_pll_lockout > 0);
@@ -924,7 +1034,14 @@ int macsim_c::run_a_cycle()
     manifold::kernel::Manifold::Run((double) m_simulation_cycle);       //IRIS
     manifold::kernel::Manifold::Run((double) m_simulation_cycle);       //IRIS for half tick?
 #else
-    m_network->run_a_cycle(pll_locked);
+    // no packet, flit, or credit in any router : skip the NoC clock domain
+    if (m_network->is_active()) {
+      m_network->run_a_cycle(pll_locked);
+    }
+    else {
+      m_network->skip_cycles(1);
+      STAT_EVENT(NOC_GATED_CYCLE);
+    }
 #endif
     GET_NEXT_CYCLE(CLOCK_NOC);
   }
@@ -944,103 +1061,391 @@ int macsim_c::run_a_cycle()
   }
 #endif /* USING_SST */
 
-  // core execution loop
-  for (int kk = 0; kk < m_num_sim_cores; ++kk) {
-    // use pivot to randomize core run_cycle pattern 
-    unsigned int ii = (kk+pivot) % m_num_sim_cores;
+  return pll_locked;
+}
 
-    core_c *core = m_core_pointers[ii];
-    string core_type = core->get_core_type();
-    if (m_clock_internal != m_domain_next[ii]) {
-      continue;
+
+// =======================================
+// Advance the clock of a core : returns true if the core ticks in this cycle
+// =======================================
+bool macsim_c::tick_core_clock(int core_id)
+{
+  if (m_clock_internal != m_domain_next[core_id]) {
+    return false;
+  }
+
+  GET_NEXT_CYCLE(core_id);
+  if (m_termination_check[core_id] == false) {
+    m_termination_check[core_id] = true;
+    ++m_termination_count;
+  }
+
+  return true;
+}
+
+
+// =======================================
+// Run a cycle of a core (and its private caches) : returns true if the core was running.
+// Only touches state of the core, except through the memory system and the process
+// manager, so that it can be called from a parallel engine thread.
+// =======================================
+bool macsim_c::run_core_cycle(int core_id, bool pll_locked, Counter cycle)
+{
+  int ii = core_id;
+  core_c *core = m_core_pointers[ii];
+  bool running = false;
+
+  // increment core cycle
+  core->inc_core_cycle_count();
+  m_core_cycle[ii]++;
+
+#ifndef USING_SST
+  m_memory->run_a_cycle_core(ii, pll_locked);
+#endif
+
+  // core ended or not started    
+  if (m_sim_end[ii] || !m_core_started[ii]) {
+    return false;
+  }
+
+  // check whether all ops in this core have been completed.
+  if (core->m_running_thread_num == 0 && (core->m_unique_scheduled_thread_num >= 1)) { 
+    if (m_num_waiting_dispatched_threads == 0)  {
+      m_sim_end[ii] = true;
+    }
+  }
+
+  // active core : running a cycle and update stats
+  if (!m_sim_end[ii])  {
+    // run a cycle (a known pipeline stall only accounts its stall stats)
+    if (!pll_locked && core->is_stalled()) {
+      core->skip_cycles(1);
     }
     else {
-      GET_NEXT_CYCLE(ii);
-      if (m_termination_check[ii] == false) {
-        m_termination_check[ii] = true;
-        ++m_termination_count;
-      }
+      core->run_a_cycle(pll_locked);
     }
 
-    // increment core cycle
-    core->inc_core_cycle_count();
-    m_core_cycle[ii]++;
+    running = true;
+    STAT_CORE_EVENT(ii, CYC_COUNT);
+    STAT_CORE_EVENT(ii, NUM_SAMPLES);
+    STAT_CORE_EVENT_N(ii, NUM_ACTIVE_BLOCKS, core->m_running_block_num);
+    STAT_CORE_EVENT_N(ii, NUM_ACTIVE_THREADS, core->m_running_thread_num);
+  }
 
-#ifndef USING_SST
-    m_memory->run_a_cycle_core(ii, pll_locked);
-#endif
+  // checking for threads 
+  if (m_sim_end[ii] != true) {
+    // when KNOB_MAX_INSTS is set, execute each thread for KNOB_MAX_INSTS instructions
+    if (*m_simBase->m_knobs->KNOB_MAX_INSTS && 
+        core->m_num_thread_reach_end == core->m_unique_scheduled_thread_num) {
+      m_sim_end[ii] = true;
+    }
+    // when KNOB_SIM_CYCLE_COUNT is set, execute only KNOB_SIM_CYCLE_COUNT cycles
+    else if (*KNOB(KNOB_SIM_CYCLE_COUNT) && cycle >= *KNOB(KNOB_SIM_CYCLE_COUNT)) {
+      m_sim_end[ii] = true;
+    }
+  }
 
-    // core ended or not started    
-    if (m_sim_end[ii] || !m_core_started[ii]) {
-      continue;
+  if (!m_sim_end[ii]) { 
+    // advance queues to prepare for the next cycle
+    core->advance_queues();
+
+    // check heartbeat
+    core->check_heartbeat(false);
+
+    // forward progress check in every 10000 cycles
+    if (!(m_core_cycle[ii] % 10000))  
+      core->check_forward_progress();
+  } 
+
+  // when a core has been completed, do last print heartbeat 
+  if (m_sim_end[ii] || m_core_end_trace[ii]) 
+    core->check_heartbeat(true);
+
+  return running;
+}
+
+
+// =======================================
+// Advance the simulation clock
+// =======================================
+void macsim_c::end_cycle(void)
+{
+  // increase simulation cycle
+  m_simulation_cycle++;
+  STAT_EVENT(CYC_COUNT_TOT);
+
+
+  // m_termination_check[0] cpu [1] gpu
+
+  if (++m_clock_internal == m_clock_lcm) {
+    m_clock_internal = 0;
+    for (int ii = 0; ii < 3 + m_num_sim_cores; ++ii) {
+      m_domain_count[ii] = 0;
+      m_domain_next[ii]  = 0;
     }
+  }
+}
+
+
+// =======================================
+// Run KNOB_PARALLEL_QUANTUM cycles : the uncore is stepped serially, then the core
+// cycles of the quantum are run on the parallel engine in serial order
+// =======================================
+void macsim_c::run_parallel_cycles(void)
+{
+  int quantum = *KNOB(KNOB_PARALLEL_QUANTUM);
+  m_parallel_engine->begin_phase(quantum > 1);
+
+  // core cycles of core 0 already collected (to compute the pivot)
+  Counter num_core0_cycles = 0;
+
+  // core cycle from which the running core count restarts
+  int reset_item = -1;
+
+  for (int cycle = 0; cycle < quantum; ++cycle) {
+    if (cycle > 0 && m_termination_count == m_num_sim_cores) {
+      m_termination_count = 0;
+      fill_n(m_termination_check, m_num_sim_cores, false);
+      reset_item = m_parallel_engine->get_num_items();
+    }
+
+    Counter pivot = m_core_cycle[0] + num_core0_cycles + 1;
 
-    // check whether all ops in this core have been completed.
-    if (core->m_running_thread_num == 0 && (core->m_unique_scheduled_thread_num >= 1)) { 
-      if (m_num_waiting_dispatched_threads == 0)  {
-        m_sim_end[ii] = true;
+    bool pll_locked = run_uncore_cycle();
+
+    for (int kk = 0; kk < m_num_sim_cores; ++kk) {
+      unsigned int ii = (kk+pivot) % m_num_sim_cores;
+
+      if (!tick_core_clock(ii)) {
+        continue;
+      }
+
+      if (ii == 0) {
+        ++num_core0_cycles;
       }
+
+      // process manager calls within a single-cycle quantum run in isolation
+      bool exclusive = (quantum == 1 && !m_core_pointers[ii]->is_parallel_safe());
+      m_parallel_engine->add_item(ii, m_simulation_cycle, pll_locked, exclusive);
     }
 
-    // active core : running a cycle and update stats
-    if (!m_sim_end[ii])  {
-      // run a cycle
-      core->run_a_cycle(pll_locked);
+    // cores see the simulation cycle of the last cycle in the quantum
+    if (cycle < quantum - 1) {
+      end_cycle();
+    }
+  }
+
+  m_parallel_engine->run_phase();
+
+  if (reset_item != -1) {
+    m_num_running_core = 0;
+  }
+
+  for (int ii = 0; ii < m_parallel_engine->get_num_items(); ++ii) {
+    parallel_item_s* item = m_parallel_engine->get_item(ii);
 
+    // deferred process manager calls in serial order
+    for (auto itr = item->m_deferred.begin(); itr != item->m_deferred.end(); ++itr) {
+      (*itr)();
+    }
+
+    if (item->m_running && ii >= reset_item) {
       m_num_running_core++;
-      STAT_CORE_EVENT(ii, CYC_COUNT);
-      STAT_CORE_EVENT(ii, NUM_SAMPLES);
-      STAT_CORE_EVENT_N(ii, NUM_ACTIVE_BLOCKS, core->m_running_block_num);
-      STAT_CORE_EVENT_N(ii, NUM_ACTIVE_THREADS, core->m_running_thread_num);
     }
+  }
+
+  end_cycle();
+}
+
 
-    // checking for threads 
-    if (m_sim_end[ii] != true) {
-      // when KNOB_MAX_INSTS is set, execute each thread for KNOB_MAX_INSTS instructions
-      if (*m_simBase->m_knobs->KNOB_MAX_INSTS && 
-          core->m_num_thread_reach_end == core->m_unique_scheduled_thread_num) {
-        m_sim_end[ii] = true;
+// =======================================
+// Fast-forward idle cycles : a core is skipped while its pipeline is stalled (see
+// core_c::check_stall) or while it is not running, as long as its private caches are idle.
+// Uncore domains (NOC, LLC, MC) are skipped only when all of them are idle,
+// so that a request in flight never observes a skipped tick.
+// =======================================
+void macsim_c::skip_idle_cycles(void)
+{
+  // the simulation cannot end while a core is stalled (see below)
+  bool core_skip = !m_repeat_done && m_num_active_threads > 0 && 
+    (!*KNOB(KNOB_SIM_CYCLE_COUNT) || m_simulation_cycle < *KNOB(KNOB_SIM_CYCLE_COUNT));
+
+  // next live core tick
+  int target = m_clock_lcm;
+  bool stalled = false;
+  for (int ii = 0; ii < m_num_sim_cores; ++ii) {
+    core_c* core = m_core_pointers[ii];
+    bool inactive = m_sim_end[ii] || !m_core_started[ii];
+    Counter num_ticks = 0;
+    if (core_skip && m_memory->is_core_idle(ii)) {
+      if (inactive) {
+        num_ticks = m_domain_freq[ii];
       }
-      // when KNOB_SIM_CYCLE_COUNT is set, execute only KNOB_SIM_CYCLE_COUNT cycles
-      else if (*KNOB(KNOB_SIM_CYCLE_COUNT) && m_simulation_cycle >= *KNOB(KNOB_SIM_CYCLE_COUNT)) {
-        m_sim_end[ii] = true;
+      else if (!m_core_end_trace[ii]) {
+        // forward progress is checked on every 10000th core cycle
+        Counter cycle = m_core_cycle[ii];
+        num_ticks = MIN2(core->get_num_idle_cycles(), (cycle / 10000 + 1) * 10000 - cycle - 1);
+        num_ticks = MIN2(num_ticks, static_cast<Counter>(m_domain_freq[ii]));
+        stalled |= (num_ticks > 0);
       }
     }
 
-    if (!m_sim_end[ii]) { 
-      // advance queues to prepare for the next cycle
-      core->advance_queues();
+    // first tick that has to run
+    target = MIN2(target, static_cast<int>(1.0*m_clock_lcm*(m_domain_count[ii] + num_ticks)/
+          m_domain_freq[ii]));
+  }
+
+  // not running cores are skipped only along with a stalled core, which keeps the
+  // termination check from seeing a round without any running core
+  if (!stalled) {
+    for (int ii = 0; ii < m_num_sim_cores; ++ii) {
+      target = MIN2(target, m_domain_next[ii]);
+    }
+  }
+
+  bool uncore_idle = m_network->is_idle() && m_memory->is_uncore_idle();
+  for (int ii = 0; ii < m_num_mc && uncore_idle; ++ii) {
+    uncore_idle = m_dram_controller[ii]->is_idle();
+  }
 
-      // check heartbeat
-      core->check_heartbeat(false);
+  if (!uncore_idle) {
+    target = MIN2(target, m_domain_next[CLOCK_LLC]);
+    target = MIN2(target, m_domain_next[CLOCK_NOC]);
+    target = MIN2(target, m_domain_next[CLOCK_MC]);
+  }
 
-      // forward progress check in every 10000 cycles
-      if (!(m_core_cycle[ii] % 10000))  
-        core->check_forward_progress();
-    } 
+  Counter num_skip = target - m_clock_internal;
 
-    // when a core has been completed, do last print heartbeat 
-    if (m_sim_end[ii] || m_core_end_trace[ii]) 
-      core->check_heartbeat(true);
+  // mmu runs at the global clock
+  num_skip = MIN2(num_skip, m_MMU->get_num_idle_cycles());
+
+  // interval stats and checkpoints are taken at the end of a cycle
+  num_skip = MIN2(num_skip, m_interval_stats->get_next_cycle() - 1 - m_simulation_cycle);
+  if (m_checkpoint_pending && *KNOB(KNOB_CHECKPOINT_SAVE_CYCLE)) {
+    num_skip = MIN2(num_skip, *KNOB(KNOB_CHECKPOINT_SAVE_CYCLE) - 1 - m_simulation_cycle);
   }
 
+  // sim_cycle_count is checked by the running core ticks
+  if (stalled && *KNOB(KNOB_SIM_CYCLE_COUNT)) {
+    num_skip = MIN2(num_skip, *KNOB(KNOB_SIM_CYCLE_COUNT) - m_simulation_cycle);
+  }
 
-  // increase simulation cycle
-  m_simulation_cycle++;
-  STAT_EVENT(CYC_COUNT_TOT);
+  if (num_skip == 0) {
+    return;
+  }
 
+  int begin = m_clock_internal;
+  int end = m_clock_internal + num_skip;
+
+  // skipped core ticks : same clock and termination bookkeeping as run_a_cycle. a stalled
+  // core counts as running in every round, hence the termination check cannot succeed.
+  if (stalled) {
+    vector<Counter> num_tick(m_num_sim_cores, 0);
+    for (int cycle = begin; cycle < end; ++cycle) {
+      m_clock_internal = cycle;
+      if (cycle > begin && m_termination_count == m_num_sim_cores) {
+        m_termination_count = 0;
+        fill_n(m_termination_check, m_num_sim_cores, false);
+        m_num_running_core = 0;
+      }
 
-  // m_termination_check[0] cpu [1] gpu
+      for (int ii = 0; ii < m_num_sim_cores; ++ii) {
+        if (!tick_core_clock(ii)) {
+          continue;
+        }
 
-  if (++m_clock_internal == m_clock_lcm) {
+        ++num_tick[ii];
+        if (!m_sim_end[ii] && m_core_started[ii]) {
+          ++m_num_running_core;
+        }
+      }
+    }
+    m_clock_internal = begin;
+
+    if (m_termination_count == m_num_sim_cores) {
+      m_termination_count = 0;
+      fill_n(m_termination_check, m_num_sim_cores, false);
+      m_num_running_core = 0;
+    }
+
+    for (int ii = 0; ii < m_num_sim_cores; ++ii) {
+      Counter num_cycles = num_tick[ii];
+      if (num_cycles == 0) {
+        continue;
+      }
+
+      core_c* core = m_core_pointers[ii];
+      core->inc_core_cycle_count(num_cycles);
+      m_core_cycle[ii] += num_cycles;
+      m_memory->skip_core_cycles(ii, num_cycles);
+
+      if (!m_sim_end[ii] && m_core_started[ii]) {
+        core->skip_cycles(num_cycles);
+        STAT_CORE_EVENT_N(ii, CYC_COUNT, num_cycles);
+        STAT_CORE_EVENT_N(ii, NUM_SAMPLES, num_cycles);
+        STAT_CORE_EVENT_N(ii, NUM_ACTIVE_BLOCKS, num_cycles * core->m_running_block_num);
+        STAT_CORE_EVENT_N(ii, NUM_ACTIVE_THREADS, num_cycles * core->m_running_thread_num);
+      }
+    }
+  }
+
+  // tick idle uncore domains without running them
+  if (uncore_idle) {
+    int num_tick[3] = {0, 0, 0}; // LLC, NOC, MC
+    for (int ii = 0; ii < 3; ++ii) {
+      while (m_domain_next[CLOCK_LLC + ii] < end) {
+        GET_NEXT_CYCLE(CLOCK_LLC + ii);
+        ++num_tick[ii];
+      }
+    }
+
+    if (num_tick[0] > 0) {
+      m_memory->skip_uncore_cycles(num_tick[0]);
+    }
+
+    if (num_tick[1] > 0) {
+      m_network->skip_cycles(num_tick[1]);
+    }
+
+    for (int ii = 0; ii < m_num_mc && num_tick[2] > 0; ++ii) {
+      m_dram_controller[ii]->skip_cycles(num_tick[2]);
+    }
+  }
+
+  m_MMU->skip_cycles(num_skip);
+
+  m_simulation_cycle += num_skip;
+  STAT_EVENT_N(CYC_COUNT_TOT, num_skip);
+
+  m_clock_internal += num_skip;
+  if (m_clock_internal == m_clock_lcm) {
     m_clock_internal = 0;
     for (int ii = 0; ii < 3 + m_num_sim_cores; ++ii) {
       m_domain_count[ii] = 0;
       m_domain_next[ii]  = 0;
     }
   }
+}
 
-  return 1; //simulation not finished
+
+// =======================================
+// Save a checkpoint when the target instruction count or cycle is reached
+// =======================================
+bool macsim_c::check_checkpoint(void)
+{
+  Counter inst_count = (*m_ProcessorStats)[INST_COUNT_TOT].getCount();
+  if ((!*KNOB(KNOB_CHECKPOINT_SAVE_INST) || inst_count < *KNOB(KNOB_CHECKPOINT_SAVE_INST)) &&
+      (!*KNOB(KNOB_CHECKPOINT_SAVE_CYCLE) || 
+       m_simulation_cycle < *KNOB(KNOB_CHECKPOINT_SAVE_CYCLE))) {
+    return false;
+  }
+
+  m_checkpoint_pending = false;
+
+  checkpoint_c checkpoint(m_simBase);
+  checkpoint.save(KNOB(KNOB_CHECKPOINT_SAVE)->getValue());
+
+  return *KNOB(KNOB_CHECKPOINT_SAVE_EXIT);
 }
 
 
@@ -1058,8 +1463,12 @@ void macsim_c::finalize()
   fini_sim();
 
   // dump out stat files at the end of simulation
+  m_interval_stats->finalize(m_simulation_cycle);
   m_ProcessorStats->saveStats();
 
+  // depends on the number of host threads, hence not in the stat files
+  report("arena heap allocations: " << arena_c::get_num_heap_alloc());
+
   cout << "Done\n";
 }
 
@@ -191,6 +191,43 @@ class macsim_c
      */
 		void fini_sim(void);
 
+    /**
+     * Fast-forward idle cycles until the next cycle with pending work
+     */
+		void skip_idle_cycles(void);
+
+    /**
+     * Run pll/dyfr, MMU, NOC, LLC, and MC for a cycle : returns pll lock state
+     */
+		bool run_uncore_cycle(void);
+
+    /**
+     * Advance the clock of a core : returns true if the core ticks in the current cycle
+     */
+		bool tick_core_clock(int core_id);
+
+    /**
+     * Run a cycle of a core : returns true if the core was running
+     * @param cycle - simulation cycle of the core tick
+     */
+		bool run_core_cycle(int core_id, bool pll_locked, Counter cycle);
+
+    /**
+     * Advance the simulation clock at the end of a cycle
+     */
+		void end_cycle(void);
+
+    /**
+     * Run a quantum of cycles with cores stepped on the parallel engine
+     */
+		void run_parallel_cycles(void);
+
+    /**
+     * Save a checkpoint once its instruction/cycle target has been reached
+     * @return true if the simulation ends after saving the checkpoint
+     */
+		bool check_checkpoint(void);
+
 #ifdef IRIS
     /**
      * Initialize iris configuration
@@ -219,6 +256,7 @@ class macsim_c
 		Counter m_core0_inst_count; /**< core 0 inst count for debug/assert */
 		Counter m_core_cycle[MAX_NUM_CORES];/**< core cycle count */
 		int m_end_simulation; /**< flag to end simulation */
+		bool m_checkpoint_pending; /**< checkpoint has not been saved yet */
 
     // statistics
 		all_stats_c*         m_allStats; /**< all statistics */
@@ -254,7 +292,6 @@ class macsim_c
     // data structure pools (to reduce overhead of memory allocation)
 		pool_c<thread_s>* m_thread_pool; /**<  thread data pool */
 		pool_c<section_info_s>* m_section_pool; /**<  section data pool */
-		pool_c<mem_map_entry_c>* m_mem_map_entry_pool; /**<  memory dependence data pool */
 		pool_c<heartbeat_s>* m_heartbeat_pool; /**<  heartbeat data pool */
 		pool_c<bp_recovery_info_c>* m_bp_recovery_info_pool; /**<  bp recovery information pool */
 		pool_c<thread_trace_info_node_s>* m_trace_node_pool; /**<  trace node pool */
@@ -296,7 +333,11 @@ class macsim_c
     int m_termination_count;
 
     dyfr_c* m_dyfr; /**< dynamic frequency class> */
+    parallel_engine_c* m_parallel_engine; /**< multi-threaded core stepping */
+    trace_prefetcher_c* m_trace_prefetcher; /**< asynchronous trace file reader */
     unique_ptr<MMU> m_MMU; /**< memory management unit> */
+    unique_ptr<sampling_c> m_sampling; /**< sampled simulation driver */
+    unique_ptr<interval_stats_c> m_interval_stats; /**< interval statistics sink */
 
 	private:
 		macsim_c* m_simBase; /**< self-reference for macro usage */
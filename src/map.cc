@@ -81,7 +81,7 @@ map_data_c::map_data_c(macsim_c* simBase)
 {
   /* initialize the memory dependence hash table */
   m_simBase = simBase;
-  m_oracle_mem_hash = new hash_c<mem_map_entry_c>(simBase->m_mem_map_entry_pool);
+  m_oracle_mem_hash = new hash_c<mem_map_entry_c>("oracle_mem_hash");
 }
 
 
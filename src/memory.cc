@@ -48,10 +48,12 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "memory.h"
 #include "network.h"
 #include "port.h"
+#include "rob_smc.h"
 #include "uop.h"
 #include "factory_class.h"
 #include "bug_detector.h"
 #include "mmu.h"
+#include "parallel_engine.h"
 
 #include "config.h"
 
@@ -129,7 +131,7 @@ inline bool IsLoad(Mem_Type type)
 bool dcache_fill_line_wrapper(mem_req_s* req)
 {
 	bool result = true;
-  list<mem_req_s*> done_list;
+  arena_list_c<mem_req_s*> done_list;
   for (auto I = req->m_merge.begin(), E = req->m_merge.end(); I != E; ++I) {
     if ((*I)->m_done_func && !((*I)->m_done_func((*I)))) {
       result = false;
@@ -616,6 +618,7 @@ int dcu_c::access(uop_c* uop)
   // -------------------------------------
   else { // !cache_hit
     STAT_EVENT(L1_MISS_CPU + this->m_ptx_sim);
+    STAT_CORE_EVENT(uop->m_core_id, DCACHE_MISS);
     DEBUG_CORE(uop->m_core_id, "L%d[%d] uop_num:%lld cache miss\n", m_level, m_id, uop->m_uop_num);
 
     // -------------------------------------
@@ -787,6 +790,81 @@ void dcu_c::run_a_cycle(bool pll_lock)
   ++m_cycle;
 }
 
+// all queues are empty and no packet is waiting at the router
+bool dcu_c::is_idle(void)
+{
+  if (m_has_router && (*KNOB(KNOB_ENABLE_IRIS) || *KNOB(KNOB_ENABLE_NEW_NOC)) &&
+      NETWORK->receive(m_level, m_id) != NULL)
+    return false;
+
+  return m_retry_queue.empty() && m_in_queue->m_entry.empty() && 
+    m_wb_queue->m_entry.empty() && m_fill_queue->m_entry.empty() && 
+    m_out_queue->m_entry.empty();
+}
+
+void dcu_c::skip_cycles(Counter num_cycles)
+{
+  m_cycle += num_cycles;
+}
+
+// queues are not saved (drained checkpoint). caches that are not part of the configured
+// hierarchy have never been initialized, hence m_cache is checked as well
+void dcu_c::checkpoint(checkpoint_c* ckpt)
+{
+  if (m_cache && !m_disable)
+    m_cache->checkpoint(ckpt);
+}
+
+// functional warmup : same lookup, prefetcher training and routing as a request through
+// in_queue and fill_queue, but no request is generated and dirty victims are dropped
+void dcu_c::warmup(mem_req_s* req)
+{
+  bool ptx_store = m_ptx_sim && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f && 
+    m_level == MEM_L1 && req->m_type == MRT_DSTORE;
+
+  if (!m_disable) {
+    Addr line_addr;
+    dcache_data_s* line = (dcache_data_s*)m_cache->access_cache(req->m_addr, &line_addr, true, 
+        req->m_appl_id);
+
+    m_simBase->m_core_pointers[req->m_core_id]->train_hw_pref(m_level, req->m_thread_id, 
+        (m_level == MEM_L1) ? line_addr : req->m_addr, req->m_pc, req->m_uop, line != NULL);
+
+    if (line) {
+      // GPU : evict global data on write hit in L1
+      if (ptx_store)
+        m_cache->invalidate_cache_line(req->m_addr);
+      else if (req->m_type == MRT_DSTORE)
+        line->m_dirty = true;
+      return;
+    }
+  }
+
+  // LLC misses go to the memory controller
+  if (m_level != MEM_LLC) {
+    int next_id = req->m_cache_id[m_level+1];
+    if ((m_coupled_down && m_next_id == next_id) || !m_has_router)
+      m_next[next_id]->warmup(req);
+    else
+      m_memory->get_cache(m_level+1, next_id)->warmup(req);
+  }
+
+  // GPU stores do not allocate L1 lines
+  if (m_disable || ptx_store)
+    return;
+
+  Addr line_addr, victim_line_addr;
+  dcache_data_s* data = (dcache_data_s*)m_cache->insert_cache(req->m_addr, &line_addr, 
+      &victim_line_addr, req->m_appl_id, req->m_ptx);
+
+  data->m_dirty       = (m_level == MEM_L1 && req->m_type == MRT_DSTORE);
+  data->m_fetch_cycle = m_cycle;
+  data->m_core_id     = req->m_core_id;
+  data->m_pc          = req->m_pc;
+  data->m_tid         = req->m_thread_id;
+}
+
+
 // Main cache access function
 // process requests in the input queue
 // input queue: 
@@ -795,7 +873,7 @@ void dcu_c::run_a_cycle(bool pll_lock)
 //   3) will go to the output queue on cache misses
 void dcu_c::process_in_queue()
 {
-  list<mem_req_s*> done_list;
+  arena_list_c<mem_req_s*> done_list;
   int count = 0;
   for (auto I = m_in_queue->m_entry.begin(), E = m_in_queue->m_entry.end(); I != E; ++I) {
     if (count == 4)
@@ -928,6 +1006,8 @@ void dcu_c::process_in_queue()
       }
 
       STAT_EVENT(L1_HIT_CPU + (m_level - 1)*4 + 2 + req->m_ptx);
+      if (m_level == MEM_LLC)
+        STAT_CORE_EVENT(req->m_core_id, LLC_MISS);
 
 //      handle_coherence(m_level, false, );
 
@@ -1061,7 +1141,7 @@ bool dcu_c::send_packet(mem_req_s* req, int msg_type, int dir)
 //   request that are waiting to be sent to the router 
 void dcu_c::process_out_queue()
 {
-  list<mem_req_s*> done_list;
+  arena_list_c<mem_req_s*> done_list;
   int count = 0;
   for (auto I = m_out_queue->m_entry.begin(), E = m_out_queue->m_entry.end(); I != E; ++I) {
     if (count == 4)
@@ -1149,7 +1229,7 @@ void dcu_c::process_out_queue()
 //   to fill a cache line
 void dcu_c::process_fill_queue()
 {
-  list<mem_req_s*> done_list;
+  arena_list_c<mem_req_s*> done_list;
   int count = 0;
 
   for (auto I = m_fill_queue->m_entry.begin(), E = m_fill_queue->m_entry.end(); I != E; ++I) {
@@ -1410,7 +1490,7 @@ void dcu_c::process_fill_queue()
 //   destination would be either the output queue or the fill queue of the next-level cache
 void dcu_c::process_wb_queue()
 {
-  list<mem_req_s*> done_list;
+  arena_list_c<mem_req_s*> done_list;
   int count = 0;
   for (auto I = m_wb_queue->m_entry.begin(), E = m_wb_queue->m_entry.end(); I != E; ++I) {
     if (count == 4)
@@ -1565,7 +1645,9 @@ bool dcu_c::done(mem_req_s* req)
     DEBUG_CORE(req->m_core_id, "req_id:%d inst:%lld uop:%lld done in_cycle:%llu\n", req->m_id, uop->m_inst_num, uop->m_uop_num, req->m_in_global);
     uop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
     uop->m_state = OS_SCHEDULED;
+    m_simBase->m_core_pointers[uop->m_core_id]->wake_up();
     if (m_ptx_sim || m_igpu_sim) {
+      m_simBase->m_core_pointers[uop->m_core_id]->get_gpu_rob()->uop_done(uop);
       if (uop->m_parent_uop) {
         uop_c* puop = uop->m_parent_uop;
         ++puop->m_num_child_uops_done;
@@ -1577,6 +1659,7 @@ bool dcu_c::done(mem_req_s* req)
 
           puop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
           puop->m_state = OS_SCHEDULED;
+          m_simBase->m_core_pointers[puop->m_core_id]->get_gpu_rob()->uop_done(puop);
         }
       } // uop->m_parent_uop
       else {
@@ -1597,7 +1680,9 @@ bool dcu_c::write_done(mem_req_s* req)
   uop_c* uop = req->m_uop;
   uop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
   uop->m_state = OS_SCHEDULED;
+  m_simBase->m_core_pointers[uop->m_core_id]->wake_up();
   if (m_ptx_sim || m_igpu_sim) {
+    m_simBase->m_core_pointers[uop->m_core_id]->get_gpu_rob()->uop_done(uop);
     if (uop->m_parent_uop) {
       uop_c* puop = uop->m_parent_uop;
       ++puop->m_num_child_uops_done;
@@ -1609,6 +1694,7 @@ bool dcu_c::write_done(mem_req_s* req)
 
         puop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
         puop->m_state = OS_SCHEDULED;
+        m_simBase->m_core_pointers[puop->m_core_id]->get_gpu_rob()->uop_done(puop);
       }
     } // uop->m_parent_uop
     else {
@@ -1672,8 +1758,8 @@ memory_c::memory_c(macsim_c* simBase)
   //  ASSERT(m_num_core == m_num_llc);
 
   // allocate mshr
-  m_mshr = new list<mem_req_s*>[m_num_core];
-  m_mshr_free_list = new list<mem_req_s*>[m_num_core];
+  m_mshr = new arena_list_c<mem_req_s*>[m_num_core];
+  m_mshr_free_list = new arena_list_c<mem_req_s*>[m_num_core];
 
   for (int ii = 0; ii < m_num_core; ++ii) {
     for (int jj = 0; jj < *m_simBase->m_knobs->KNOB_MEM_MSHR_SIZE; ++jj) {
@@ -1682,7 +1768,13 @@ memory_c::memory_c(macsim_c* simBase)
     }
   }
 
-  m_mem_req_pool = new pool_c<mem_req_s>;
+  // line address directory over all mshrs
+  m_mshr_dir.reserve(m_num_core * *m_simBase->m_knobs->KNOB_MEM_MSHR_SIZE);
+  m_mshr_dir_shift    = log2_int(*KNOB(KNOB_L1_LARGE_LINE_SIZE));
+  m_mshr_max_req_size = 0;
+  m_mshr_seq          = 0;
+
+  m_warmup_req = new mem_req_s(simBase);
 
   int num_large_core = *m_simBase->m_knobs->KNOB_NUM_SIM_LARGE_CORES;
   int num_medium_core = *m_simBase->m_knobs->KNOB_NUM_SIM_MEDIUM_CORES;
@@ -1776,6 +1868,7 @@ memory_c::~memory_c()
   for (int ii = 0; ii < m_num_llc; ++ii)
     delete m_llc_cache[ii];
 
+  delete m_warmup_req;
   delete[] m_mshr;
   delete[] m_mshr_free_list;
   delete[] m_l1_cache;
@@ -1799,6 +1892,9 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
     uns delay, uop_c* uop, function<bool (mem_req_s*)> done_func, Counter unique_num, \
     pref_req_info_s* pref_info, int core_id, int thread_id, bool ptx)
 {
+  // other cores' MSHRs are searched and may be modified below
+  parallel_engine_c::order();
+
   DEBUG_CORE(core_id, "MSHR[%d] new_req type:%s (%d)\n", 
       core_id, mem_req_c::mem_req_type_name[type], (int)m_mshr[core_id].size());
 
@@ -1809,12 +1905,7 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
 
   // find a matching request
   // search other cores' MSHRs as well since only L1s have MSHRs
-  mem_req_s* matching_req = NULL;
-  for (int i = 0; i < *KNOB(KNOB_NUM_SIM_CORES); ++i) {
-    matching_req = search_req(i, addr, size);
-    if (matching_req != NULL)
-      break;
-  }
+  mem_req_s* matching_req = search_req(addr, size);
 
   if (type == MRT_IFETCH) { 
     POWER_CORE_EVENT(core_id, POWER_ICACHE_MISS_BUF_R_TAG); 
@@ -1879,7 +1970,7 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
   
   if (ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f
       && type == MRT_DSTORE) {
-    new_req = m_mem_req_pool->acquire_entry(m_simBase);
+    new_req = acquire_req();
   }
   else {
     new_req = allocate_new_entry(core_id);
@@ -1920,6 +2011,10 @@ bool memory_c::new_mem_req(Mem_Req_Type type, Addr addr, uns size, bool cache_hi
   init_new_req(new_req, type, addr, size, with_data, delay, uop, done_func, unique_num, \
       priority, core_id, thread_id, ptx);
 
+  // mshr entries are searchable from now on (including merged ones)
+  if (!(ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f && type == MRT_DSTORE))
+    mshr_dir_insert(new_req, core_id, m_mshr_seq++);
+
   // merge to existing request
   if (ptx && *m_simBase->m_knobs->KNOB_COMPUTE_CAPABILITY == 2.0f 
       && matching_req && type == MRT_DSTORE) {
@@ -1966,16 +2061,62 @@ mem_req_s* memory_c::allocate_new_entry(int core_id)
 
 
 // search matching request
-mem_req_s* memory_c::search_req(int core_id, Addr addr, int size)
+mem_req_s* memory_c::search_req(Addr addr, int size)
+{
+  // a covering entry starts at most (max request size - size) bytes before addr
+  Addr end = addr + size;
+  Addr first_line = (end > static_cast<Addr>(m_mshr_max_req_size)) ?
+    (end - m_mshr_max_req_size) >> m_mshr_dir_shift : 0;
+  Addr last_line = addr >> m_mshr_dir_shift;
+
+  // among all covering entries, pick the first one in (core id, mshr list) order
+  mshr_dir_entry_s* match = NULL;
+  for (Addr line = first_line; line <= last_line; ++line) {
+    auto range = m_mshr_dir.equal_range(line);
+    for (auto I = range.first; I != range.second; ++I) {
+      mshr_dir_entry_s* entry = &I->second;
+      mem_req_s* req = entry->m_req;
+      if (req->m_addr <= addr && req->m_addr+req->m_size >= end) {
+        if (match == NULL || entry->m_core_id < match->m_core_id ||
+            (entry->m_core_id == match->m_core_id && entry->m_seq < match->m_seq)) {
+          match = entry;
+        }
+      }
+    }
+  }
+
+  return match ? match->m_req : NULL;
+}
+
+
+// add an mshr entry to the directory (keyed by the line of its start address)
+void memory_c::mshr_dir_insert(mem_req_s* req, int core_id, Counter seq)
 {
-  for (auto I = m_mshr[core_id].begin(), E = m_mshr[core_id].end(); I != E; ++I) {
-    mem_req_s* req = (*I);
-    if (req->m_addr <= addr && req->m_addr+req->m_size >= addr+size) {
-      return req;
+  mshr_dir_entry_s entry;
+  entry.m_req     = req;
+  entry.m_core_id = core_id;
+  entry.m_seq     = seq;
+  m_mshr_dir.insert(make_pair(req->m_addr >> m_mshr_dir_shift, entry));
+
+  if (static_cast<int>(req->m_size) > m_mshr_max_req_size)
+    m_mshr_max_req_size = req->m_size;
+}
+
+
+// remove an mshr entry from the directory
+mshr_dir_entry_s memory_c::mshr_dir_remove(mem_req_s* req)
+{
+  auto range = m_mshr_dir.equal_range(req->m_addr >> m_mshr_dir_shift);
+  for (auto I = range.first; I != range.second; ++I) {
+    if (I->second.m_req == req) {
+      mshr_dir_entry_s entry = I->second;
+      m_mshr_dir.erase(I);
+      return entry;
     }
   }
 
-  return NULL;
+  ASSERTM(0, "req:%d is not in the mshr directory\n", req->m_id);
+  return mshr_dir_entry_s();
 }
 
 
@@ -2024,6 +2165,9 @@ void memory_c::adjust_req(mem_req_s* req, Mem_Req_Type type, Addr addr, int size
     int delay, uop_c* uop, function<bool (mem_req_s*)> done_func, Counter unique_num, \
     Counter priority, int core_id, int thread_id, bool ptx)
 {
+  // the start address may change : re-index the entry in the mshr directory
+  mshr_dir_entry_s dir_entry = mshr_dir_remove(req);
+
   req->m_appl_id                = m_simBase->m_core_pointers[core_id]->get_appl_id(thread_id);;
   req->m_core_id                = core_id;
   req->m_thread_id              = thread_id;
@@ -2050,6 +2194,8 @@ void memory_c::adjust_req(mem_req_s* req, Mem_Req_Type type, Addr addr, int size
   req->m_skip                   = false;
 
   set_cache_id(req);
+
+  mshr_dir_insert(req, dir_entry.m_core_id, dir_entry.m_seq);
 }
 
 
@@ -2068,6 +2214,8 @@ void memory_c::set_cache_id(mem_req_s* req)
 // deallocate a memory request
 void memory_c::free_req(int core_id, mem_req_s* req)
 {
+  parallel_engine_c::order();
+
   STAT_EVENT(AVG_MEMORY_LATENCY_BASE);
   STAT_EVENT_N(AVG_MEMORY_LATENCY, m_cycle - req->m_in);
 
@@ -2080,9 +2228,10 @@ void memory_c::free_req(int core_id, mem_req_s* req)
   ASSERTM(req->m_merge.empty(), "type:%s\n", mem_req_c::mem_req_type_name[req->m_type]);
 
   if (req->m_type == MRT_WB) {
-    delete req;
+    release_req(req);
   }
   else {
+    mshr_dir_remove(req);
     req->init();
     m_mshr[core_id].remove(req);
     m_mshr_free_list[core_id].push_back(req);
@@ -2091,10 +2240,27 @@ void memory_c::free_req(int core_id, mem_req_s* req)
 
 void memory_c::free_write_req(mem_req_s* req)
 {
+  parallel_engine_c::order();
+
   STAT_EVENT(AVG_MEMORY_LATENCY_BASE);
   STAT_EVENT_N(AVG_MEMORY_LATENCY, m_cycle - req->m_in);
 
-  m_mem_req_pool->release_entry(req);
+  release_req(req);
+}
+
+
+// allocate a request outside of the mshr
+mem_req_s* memory_c::acquire_req(void)
+{
+  return new (arena_c::get<mem_req_s>()->allocate()) mem_req_s(m_simBase);
+}
+
+
+// release a request allocated outside of the mshr
+void memory_c::release_req(mem_req_s* req)
+{
+  req->~mem_req_s();
+  arena_c::get<mem_req_s>()->release(req);
 }
 
 
@@ -2181,6 +2347,17 @@ void memory_c::run_a_cycle_core(int core_id, bool pll_lock)
   m_l1_cache[core_id]->run_a_cycle(pll_lock);
 }
 
+bool memory_c::is_core_idle(int core_id)
+{
+  return m_l1_cache[core_id]->is_idle() && m_l2_cache[core_id]->is_idle();
+}
+
+void memory_c::skip_core_cycles(int core_id, Counter num_cycles)
+{
+  m_l2_cache[core_id]->skip_cycles(num_cycles);
+  m_l1_cache[core_id]->skip_cycles(num_cycles);
+}
+
 void memory_c::run_a_cycle_uncore(bool pll_lock)
 {
   int index = m_cycle % m_num_llc;
@@ -2192,6 +2369,90 @@ void memory_c::run_a_cycle_uncore(bool pll_lock)
     m_l3_cache[ii % m_num_l3]->run_a_cycle(pll_lock);
 }
 
+bool memory_c::is_uncore_idle(void)
+{
+  for (int ii = 0; ii < m_num_llc; ++ii) {
+    if (!m_llc_cache[ii]->is_idle())
+      return false;
+  }
+
+  for (int ii = 0; ii < m_num_l3; ++ii) {
+    if (!m_l3_cache[ii]->is_idle())
+      return false;
+  }
+
+  return true;
+}
+
+void memory_c::skip_uncore_cycles(Counter num_cycles)
+{
+  for (int ii = 0; ii < m_num_llc; ++ii)
+    m_llc_cache[ii]->skip_cycles(num_cycles);
+
+  for (int ii = 0; ii < m_num_l3; ++ii)
+    m_l3_cache[ii]->skip_cycles(num_cycles);
+
+  m_cycle += num_cycles;
+}
+
+void memory_c::checkpoint(checkpoint_c* ckpt)
+{
+  for (int ii = 0; ii < m_num_core; ++ii) {
+    m_l1_cache[ii]->checkpoint(ckpt);
+    m_l2_cache[ii]->checkpoint(ckpt);
+  }
+
+  for (int ii = 0; ii < m_num_l3; ++ii)
+    m_l3_cache[ii]->checkpoint(ckpt);
+
+  for (int ii = 0; ii < m_num_llc; ++ii)
+    m_llc_cache[ii]->checkpoint(ckpt);
+}
+
+// functional warmup
+void memory_c::warmup(int level, Mem_Req_Type type, Addr addr, Addr pc, uop_c* uop, 
+    int core_id, int thread_id, bool ptx)
+{
+  // shared caches are accessed below
+  parallel_engine_c::order();
+
+  // data accesses are translated at L1 (see dcu_c::access)
+  if (level == MEM_L1 && *m_simBase->m_knobs->KNOB_ENABLE_PHYSICAL_MAPPING)
+    addr = m_simBase->m_MMU->warmup(addr);
+
+  mem_req_s* req = m_warmup_req;
+  req->m_type      = type;
+  req->m_addr      = addr;
+  req->m_pc        = pc;
+  req->m_uop       = uop;
+  req->m_core_id   = core_id;
+  req->m_thread_id = thread_id;
+  req->m_appl_id   = m_simBase->m_core_pointers[core_id]->get_appl_id(thread_id);
+  req->m_ptx       = ptx;
+  set_cache_id(req);
+
+  get_cache(level, req->m_cache_id[level])->warmup(req);
+}
+
+
+dcu_c* memory_c::get_cache(int level, int id)
+{
+  switch (level) {
+    case MEM_L1:
+      return m_l1_cache[id];
+    case MEM_L2:
+      return m_l2_cache[id];
+    case MEM_L3:
+      return m_l3_cache[id];
+    case MEM_LLC:
+      return m_llc_cache[id];
+    default:
+      ASSERTM(0, "level:%d\n", level);
+  }
+  return NULL;
+}
+
+
 // evict a prefetch request
 mem_req_s* memory_c::evict_prefetch(int core_id)
 {
@@ -2208,9 +2469,11 @@ mem_req_s* memory_c::evict_prefetch(int core_id)
 #define GET_APPL_ID(xx, yy) (m_simBase->m_core_pointers[(xx)]->get_appl_id((yy)))
 mem_req_s* memory_c::new_wb_req(Addr addr, int size, bool ptx, dcache_data_s* data, int level)
 {
+  parallel_engine_c::order();
+
   STAT_EVENT(TOTAL_WB);
   STAT_EVENT(L1_WB + (level-1));
-  mem_req_s* req = new mem_req_s(m_simBase);
+  mem_req_s* req = acquire_req();
 
   req->m_id                     = m_unique_id++;
   req->m_appl_id                = GET_APPL_ID(data->m_core_id, data->m_tid);
@@ -2278,7 +2541,7 @@ void memory_c::print_mshr(void)
 // flush all prefetches in the mshr
 void memory_c::flush_prefetch(int core_id)
 {
-  list<mem_req_s*> done_list;
+  arena_list_c<mem_req_s*> done_list;
   for (auto I = m_mshr[core_id].begin(), E = m_mshr[core_id].end(); I != E; ++I) {
     if ((*I)->m_type == MRT_DPRF && (*I)->m_merge.empty()) {
       done_list.push_back((*I));
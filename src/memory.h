@@ -41,6 +41,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <functional>
+#include <unordered_map>
 
 #include "memreq_info.h"
 #include "pref_common.h"
@@ -65,6 +66,16 @@ bool IsLoad(Mem_Type type);
 bool dcache_fill_line_wrapper(mem_req_s *req);
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief MSHR directory entry
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct mshr_dir_entry_s {
+  mem_req_s* m_req;     /**< MSHR entry */
+  int        m_core_id; /**< core that owns the MSHR entry */
+  Counter    m_seq;     /**< allocation order (position in the MSHR list) */
+} mshr_dir_entry_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief data cache data structure
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -135,7 +146,7 @@ class queue_c
     queue_c(); //Do not implement
 
   public:
-    list<mem_req_s*> m_entry; /**< queue entries */
+    arena_list_c<mem_req_s*> m_entry; /**< queue entries */
 
   private:
     unsigned int m_size; /**< queue size */
@@ -224,6 +235,26 @@ class dcu_c
      */
     void run_a_cycle(bool);
 
+    /**
+     * Check whether all queues are empty
+     */
+    bool is_idle(void);
+
+    /**
+     * Advance the clock without ticking (only when idle)
+     */
+    void skip_cycles(Counter num_cycles);
+
+    /**
+     * Save or restore the cache contents
+     */
+    void checkpoint(checkpoint_c* ckpt);
+
+    /**
+     * Functional warmup : look up this level, warm up the lower levels on a miss and fill
+     */
+    void warmup(mem_req_s* req);
+
     /**
      * Check available buffer space
      */
@@ -320,7 +351,7 @@ class dcu_c
     int       m_num_read_port; /**< number of read ports */
     int       m_num_write_port; /**< number of write ports */
 
-    list<mem_req_s*> m_retry_queue;
+    arena_list_c<mem_req_s*> m_retry_queue;
 
     memory_c* m_memory; /**< pointer to the memory system */
     macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
@@ -406,11 +437,54 @@ class memory_c
      */
     void run_a_cycle_core(int, bool);
 
+    /**
+     * Check whether L1/L2 caches of a core are idle
+     */
+    bool is_core_idle(int core_id);
+
+    /**
+     * Advance L1/L2 clocks of a core without ticking (only when idle)
+     */
+    void skip_core_cycles(int core_id, Counter num_cycles);
+
     /**
      * Tick a cycle for LLC cache
      */
     void run_a_cycle_uncore(bool);
 
+    /**
+     * Check whether all LLC/L3 caches are idle
+     */
+    bool is_uncore_idle(void);
+
+    /**
+     * Advance LLC/L3 clocks without ticking (only when idle)
+     */
+    void skip_uncore_cycles(Counter num_cycles);
+
+    /**
+     * Save or restore the contents of all data caches
+     */
+    void checkpoint(checkpoint_c* ckpt);
+
+    /**
+     * Functional warmup : access the cache hierarchy from the given level without timing
+     * @param level - first level to access (MEM_L1 for data, MEM_L2 for L1 misses)
+     * @param type - request type (MRT_IFETCH, MRT_DFETCH, or MRT_DSTORE)
+     */
+    void warmup(int level, Mem_Req_Type type, Addr addr, Addr pc, uop_c* uop, int core_id, 
+        int thread_id, bool ptx);
+
+    /**
+     * Get the data cache of the given level
+     */
+    dcu_c* get_cache(int level, int id);
+
+    /**
+     * Check whether a core has allocated MSHR entries
+     */
+    bool has_outstanding_req(int core_id) { return !m_mshr[core_id].empty(); }
+
     /**
      * Deallocate completed memory request
      */
@@ -500,6 +574,16 @@ class memory_c
      */
     mem_req_s* allocate_new_entry(int core_id);
 
+    /**
+     * Allocate a request that does not occupy an mshr entry (write-back, ptx write)
+     */
+    mem_req_s* acquire_req(void);
+
+    /**
+     * Release a request obtained from acquire_req
+     */
+    void release_req(mem_req_s* req);
+
     /**
      * Initialize a new request
      */
@@ -516,9 +600,20 @@ class memory_c
         Counter priority, int core_id, int thread_id, bool ptx);
 
     /**
-     * Search a request from queues
+     * Search the MSHRs of all cores for a request that covers [addr, addr + size).
+     * Returns the same entry as scanning each core's MSHR list in core order.
+     */
+    mem_req_s* search_req(Addr addr, int size);
+
+    /**
+     * Add an MSHR entry to the line address directory
+     */
+    void mshr_dir_insert(mem_req_s* req, int core_id, Counter seq);
+
+    /**
+     * Remove an MSHR entry from the line address directory
      */
-    mem_req_s* search_req(int core_id, Addr addr, int size);
+    mshr_dir_entry_s mshr_dir_remove(mem_req_s* req);
 
     /**
      * Set the level of each cache level
@@ -541,8 +636,13 @@ class memory_c
     dcu_c** m_l2_cache; /**< L2 caches */
     dcu_c** m_l3_cache; /**< L3 caches */
     dcu_c** m_llc_cache; /**< LLC caches */
-    list<mem_req_s*>* m_mshr; /**< mshr entry per L1 cache */
-    list<mem_req_s*>* m_mshr_free_list; /**< mshr entry free list */
+    arena_list_c<mem_req_s*>* m_mshr; /**< mshr entry per L1 cache */
+    arena_list_c<mem_req_s*>* m_mshr_free_list; /**< mshr entry free list */
+    unordered_multimap<Addr, mshr_dir_entry_s, hash<Addr>, equal_to<Addr>,
+      arena_allocator_c<pair<const Addr, mshr_dir_entry_s> > > m_mshr_dir; /**< mshr entries by line address */
+    int m_mshr_dir_shift; /**< line address shift of the mshr directory */
+    int m_mshr_max_req_size; /**< largest request size in the mshr directory */
+    Counter m_mshr_seq; /**< mshr allocation counter */
     int m_num_core; /**< number of cores */
     int m_num_cpu;
     int m_num_gpu;
@@ -565,7 +665,7 @@ class memory_c
     unordered_map<Addr, bool> m_td_pending_req; /**< pending requests in tag directory */
 
     Counter m_cycle; /**< clock cycle */
-    pool_c<mem_req_s> *m_mem_req_pool; /**< pool for write requests in ptx simulations */
+    mem_req_s* m_warmup_req; /**< request used by the functional warmup */
 }; 
 
 
@@ -49,6 +49,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "macsim.h"
 #include "global_defs.h"
 #include "global_types.h"
+#include "arena.h"
 
 #define _DEBUG_IRIS
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -180,7 +181,7 @@ typedef struct mem_req_s {
   macsim_c*     m_simBase;      /**< reference to macsim base class for sim globals */
   
   function<bool (mem_req_s*)> m_done_func; /**< done function */
-  list<mem_req_s*> m_merge; /**< merged request list */
+  arena_list_c<mem_req_s*> m_merge; /**< merged request list */
 } mem_req_s;
 
 
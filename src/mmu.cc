@@ -50,6 +50,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "core.h"
 #include "frontend.h"
 #include "mmu.h"
+#include "checkpoint.h"
+#include "rob_smc.h"
 
 using namespace std;
 
@@ -104,6 +106,24 @@ Addr MMU::ReplacementUnit::getVictim()
   return page_number;
 }
 
+void MMU::ReplacementUnit::checkpoint(checkpoint_c *ckpt)
+{
+  uint64_t num_entries = m_table.size();
+  ckpt->io(num_entries);
+
+  if (ckpt->is_saving()) {
+    for (Entry *node = m_tail->prev; node != m_head; node = node->prev)
+      ckpt->io(node->page_number);
+  } else {
+    assert(m_table.empty());
+    for (uint64_t i = 0; i < num_entries; ++i) {
+      Addr page_number;
+      ckpt->io(page_number);
+      insert(page_number);
+    }
+  }
+}
+
 void MMU::initialize(macsim_c *simBase)
 {
   m_simBase = simBase;
@@ -133,6 +153,54 @@ void MMU::initialize(macsim_c *simBase)
   m_fault_buffer_size = m_simBase->m_knobs->KNOB_FAULT_BUFFER_SIZE->getValue();
 }
 
+void MMU::checkpoint(checkpoint_c *ckpt)
+{
+  ckpt->io(m_frame_to_allocate);
+
+  uint64_t num_pages = m_page_table.size();
+  ckpt->io(num_pages);
+
+  if (ckpt->is_saving()) {
+    for (auto &entry : m_page_table) {
+      Addr page_number = entry.first;
+      ckpt->io(page_number);
+      ckpt->io(entry.second.frame_number);
+    }
+  } else {
+    ASSERT(m_page_table.empty());
+    for (uint64_t i = 0; i < num_pages; ++i) {
+      Addr page_number, frame_number;
+      ckpt->io(page_number);
+      ckpt->io(frame_number);
+      ASSERTM(frame_number < m_free_frames.size(), "checkpoint : frame %llx out of memory\n", 
+              frame_number);
+
+      m_page_table.emplace(piecewise_construct, forward_as_tuple(page_number), forward_as_tuple(frame_number));
+      m_free_frames[frame_number] = false;
+      --m_free_frames_remaining;
+    }
+  }
+
+  m_TLB->checkpoint(ckpt);
+  m_replacement_unit->checkpoint(ckpt);
+
+  uint64_t num_unique_pages = m_unique_pages.size();
+  ckpt->io(num_unique_pages);
+
+  if (ckpt->is_saving()) {
+    for (auto page_number : m_unique_pages) {
+      Addr page = page_number;
+      ckpt->io(page);
+    }
+  } else {
+    for (uint64_t i = 0; i < num_unique_pages; ++i) {
+      Addr page_number;
+      ckpt->io(page_number);
+      m_unique_pages.emplace(page_number);
+    }
+  }
+}
+
 void MMU::finalize()
 {
   STAT_EVENT_N(UNIQUE_PAGE, m_unique_pages.size());
@@ -200,6 +268,7 @@ void MMU::run_a_cycle(bool pll_lock)
       
       int latency = m_simBase->m_memory->access(uop);
       if (0 != latency) { // successful execution
+        m_simBase->m_core_pointers[uop->m_core_id]->wake_up();
         if (latency > 0) { // cache hit
           DEBUG("cache hit at %llu - core_id:%d thread_id:%d inst_num:%llu uop_num:%llu\n",
                 m_cycle, uop->m_core_id, uop->m_thread_id, uop->m_inst_num, uop->m_uop_num);
@@ -215,6 +284,7 @@ void MMU::run_a_cycle(bool pll_lock)
 
               puop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
               puop->m_state = OS_SCHEDULED;
+              m_simBase->m_core_pointers[puop->m_core_id]->get_gpu_rob()->uop_done(puop);
             }
           } else {
             if (*m_simBase->m_knobs->KNOB_FETCH_ONLY_LOAD_READY) {
@@ -269,12 +339,33 @@ void MMU::run_a_cycle(bool pll_lock)
   ++m_cycle;
 }
 
+Counter MMU::get_num_idle_cycles()
+{
+  if (m_batch_processing || !m_fault_buffer.empty() || 
+      !m_retry_queue.empty() || !m_fault_retry_queue.empty())
+    return 0;
+
+  if (m_walk_queue_cycle.empty())
+    return ULLONG_MAX;
+
+  Counter next_walk = m_walk_queue_cycle.begin()->first;
+  return (next_walk > m_cycle) ? next_walk - m_cycle : 0;
+}
+
+void MMU::skip_cycles(Counter num_cycles)
+{
+  m_cycle += num_cycles;
+}
+
 void MMU::do_page_table_walks(uop_c *cur_uop)
 {
   Addr addr = cur_uop->m_vaddr;
   Addr page_number = get_page_number(addr);
   Addr page_offset = get_page_offset(addr);
 
+  // the uop leaves the walk queue
+  m_simBase->m_core_pointers[cur_uop->m_core_id]->wake_up();
+
   auto it = m_page_table.find(page_number);
   if (it != m_page_table.end()) { // page table hit
     Addr frame_number = it->second.frame_number;
@@ -366,25 +457,7 @@ bool MMU::do_batch_processing()
       m_batch_processing_next_event_cycle = m_cycle + m_fault_latency;
     else {
       m_batch_processing_next_event_cycle = m_cycle + m_eviction_latency + m_fault_latency;
-      
-      // evict a page
-      Addr victim_page = m_replacement_unit->getVictim();
-      auto it = m_page_table.find(victim_page);
-      assert(it != m_page_table.end());
-      Addr victim_frame = it->second.frame_number;
-      m_page_table.erase(victim_page);
-      m_TLB->invalidate(victim_page);
-
-      // invalidate cache lines of this page
-      Addr frame_addr = victim_frame << m_offset_bits;
-      m_simBase->m_memory->invalidate(frame_addr);
-
-      m_free_frames[victim_frame] = true;
-      ++m_free_frames_remaining;
-
-      m_frame_to_allocate = victim_frame; // for faster simulation
-      
-       STAT_EVENT(EVICTION);
+      evict_page();
     }
 
     m_batch_processing_first_transfer_started = true;
@@ -400,34 +473,13 @@ bool MMU::do_batch_processing()
   // on m_batch_processing_next_event_cycle, a free page is gauranteed
   assert(m_free_frames_remaining > 0);
 
-  // if this randomly picked page was already assigned
-  if (!m_free_frames[m_frame_to_allocate]) {
-    // iterate through the list until a free page is found
-    Addr starting_page_of_search = m_frame_to_allocate;
-    do {
-      ++m_frame_to_allocate;
-      m_frame_to_allocate %= m_free_frames.size();
-    } while ((m_frame_to_allocate != starting_page_of_search) && (!m_free_frames[m_frame_to_allocate]));
-  }
-
-  assert(m_free_frames[m_frame_to_allocate]);
-
   // allocate a new page
   Addr page_number = m_fault_buffer_processing.front();
   m_fault_buffer_processing.pop_front();
-  Addr frame_number = m_frame_to_allocate;
+  allocate_page(page_number);
 
   DEBUG("fault resolved page_number:%llx at %llu\n", page_number, m_cycle);
 
-  // allocate an entry in the page table
-  m_page_table.emplace(piecewise_construct, forward_as_tuple(page_number), forward_as_tuple(frame_number));
-  
-  // update replacement unit
-  m_replacement_unit->insert(page_number);
-
-  m_free_frames[frame_number] = false;
-  --m_free_frames_remaining;
-
   // insert uops that tried to access this page into retry queue
   {
     auto it = m_fault_uops_processing.find(page_number);
@@ -476,25 +528,7 @@ bool MMU::do_batch_processing()
       m_batch_processing_next_event_cycle = m_cycle + m_fault_latency;
     else {
       m_batch_processing_next_event_cycle = m_cycle + m_eviction_latency + m_fault_latency;
-      
-      // evict a page
-      Addr victim_page = m_replacement_unit->getVictim();
-      auto it = m_page_table.find(victim_page);
-      assert(it != m_page_table.end());
-      Addr victim_frame = it->second.frame_number;
-      m_page_table.erase(victim_page);
-      m_TLB->invalidate(victim_page);      
-      
-      // invalidate cache lines of this page
-      Addr frame_addr = victim_frame << m_offset_bits;
-      m_simBase->m_memory->invalidate(frame_addr);
-
-      m_free_frames[victim_frame] = true;
-      ++m_free_frames_remaining;
-
-      m_frame_to_allocate = victim_frame; // for faster simulation
-      
-       STAT_EVENT(EVICTION);
+      evict_page();
     }
 
     return false;
@@ -514,6 +548,79 @@ bool MMU::do_batch_processing()
   return true;
 }
 
+void MMU::evict_page()
+{
+  Addr victim_page = m_replacement_unit->getVictim();
+  auto it = m_page_table.find(victim_page);
+  assert(it != m_page_table.end());
+  Addr victim_frame = it->second.frame_number;
+  m_page_table.erase(victim_page);
+  m_TLB->invalidate(victim_page);
+
+  // invalidate cache lines of this page
+  Addr frame_addr = victim_frame << m_offset_bits;
+  m_simBase->m_memory->invalidate(frame_addr);
+
+  m_free_frames[victim_frame] = true;
+  ++m_free_frames_remaining;
+
+  m_frame_to_allocate = victim_frame; // for faster simulation
+
+  STAT_EVENT(EVICTION);
+}
+
+Addr MMU::allocate_page(Addr page_number)
+{
+  // if this randomly picked page was already assigned
+  if (!m_free_frames[m_frame_to_allocate]) {
+    // iterate through the list until a free page is found
+    Addr starting_page_of_search = m_frame_to_allocate;
+    do {
+      ++m_frame_to_allocate;
+      m_frame_to_allocate %= m_free_frames.size();
+    } while ((m_frame_to_allocate != starting_page_of_search) && (!m_free_frames[m_frame_to_allocate]));
+  }
+
+  assert(m_free_frames[m_frame_to_allocate]);
+  Addr frame_number = m_frame_to_allocate;
+
+  // allocate an entry in the page table
+  m_page_table.emplace(piecewise_construct, forward_as_tuple(page_number), forward_as_tuple(frame_number));
+  
+  // update replacement unit
+  m_replacement_unit->insert(page_number);
+
+  m_free_frames[frame_number] = false;
+  --m_free_frames_remaining;
+
+  return frame_number;
+}
+
+Addr MMU::warmup(Addr addr)
+{
+  Addr page_number = get_page_number(addr);
+  Addr page_offset = get_page_offset(addr);
+
+  if (m_TLB->lookup(addr))
+    return (m_TLB->translate(addr) << m_offset_bits) | page_offset;
+
+  Addr frame_number;
+  auto it = m_page_table.find(page_number);
+  if (it != m_page_table.end()) { // page table hit
+    frame_number = it->second.frame_number;
+    m_replacement_unit->update(page_number);
+  } else { // page fault : resolved right away
+    if (m_free_frames_remaining == 0)
+      evict_page();
+    frame_number = allocate_page(page_number);
+    m_unique_pages.emplace(page_number);
+  }
+
+  m_TLB->insert(addr, frame_number);
+
+  return (frame_number << m_offset_bits) | page_offset;
+}
+
 void MMU::begin_batch_processing()
 {
   assert(m_batch_processing == false);
@@ -91,6 +91,7 @@ private:
     void insert(Addr page_number);
     void update(Addr page_number);
     Addr getVictim();
+    void checkpoint(checkpoint_c *ckpt); // pages are saved in LRU to MRU order
 
   private:
     struct Entry
@@ -135,9 +136,19 @@ public:
   bool translate(uop_c *cur_uop);
   void handle_page_faults();
 
+  Counter get_num_idle_cycles(); // cycles until the next pending event (ULLONG_MAX if none)
+  void skip_cycles(Counter num_cycles);
+
+  void checkpoint(checkpoint_c *ckpt); // page table and TLB; pending walks/faults are not saved
+
+  Addr warmup(Addr addr); // functional translation: TLB, page table and faults without timing
+
 private:
   void do_page_table_walks(uop_c *cur_uop);
   
+  void evict_page();
+  Addr allocate_page(Addr page_number);
+  
   void begin_batch_processing();
   bool do_batch_processing();
 
@@ -40,6 +40,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "network_ring.h"
 #include "network_mesh.h"
 #include "network_simple.h"
+#include "network_flat.h"
+#include "network_analytic.h"
+#include "network_table.h"
+#include "noc_parallel_engine.h"
 
 #include "memreq_info.h"
 #include "debug_macros.h"
@@ -118,6 +122,16 @@ network_c* default_network(macsim_c* m_simBase)
     new_network = new network_mesh_c(m_simBase);
   else if (policy == "simple_noc")
     new_network = new network_simple_c(m_simBase);
+  else if (policy == "flat_ring")
+    new_network = new network_flat_c(m_simBase, 1);
+  else if (policy == "flat_mesh")
+    new_network = new network_flat_c(m_simBase, 2);
+  else if (policy == "analytic")
+    new_network = new network_analytic_c(m_simBase);
+  else if (policy == "torus")
+    new_network = new network_table_c(m_simBase, true);
+  else if (policy == "cmesh")
+    new_network = new network_table_c(m_simBase, false);
   else
     assert(0);
 
@@ -132,13 +146,21 @@ network_c::network_c(macsim_c* simBase)
 
   m_total_packet = 0;
   m_num_router   = 0;
+  m_cycle        = 0;
 
-  m_flit_pool   = new pool_c<flit_c>(100, "flit");
-  m_credit_pool = new pool_c<credit_c>(100, "credit");
+  m_active         = false;
+  m_skipped_cycles = 0;
+  m_parallel       = NULL;
+
+  // flits and credits move between host threads when routers are stepped in parallel
+  int thread_cache = (*KNOB(KNOB_NOC_NUM_THREADS) > 1) ? 64 : 0;
+  m_flit_pool   = new pool_c<flit_c>(100, "flit", thread_cache);
+  m_credit_pool = new pool_c<credit_c>(100, "credit", thread_cache);
 }
 
 network_c::~network_c()
 {
+  delete m_parallel;
   delete m_flit_pool;
   delete m_credit_pool;
 }
@@ -151,6 +173,7 @@ bool network_c::send(mem_req_s* req, int src_level, int src_id, int dst_level, i
   DEBUG("src_level:%d src_id:%d (%d)  dst_level:%d dst_id:%d (%d)\n",
       src_level, src_id, req->m_msg_src, dst_level, dst_id, req->m_msg_dst);
 
+  m_active = true;
   return m_router[req->m_msg_src]->inject_packet(req);
 }
 
@@ -168,11 +191,75 @@ void network_c::receive_pop(int level, int id)
 }
 
 
+bool network_c::is_idle(void)
+{
+  if (m_active)
+    return false;
+
+  // ejected packets not received yet
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    if (!m_router[ii]->is_idle())
+      return false;
+  }
+
+  return true;
+}
+
+
+// router clocks catch up in the next run_routers
+void network_c::skip_cycles(Counter num_cycles)
+{
+  m_skipped_cycles += num_cycles;
+  m_cycle += num_cycles;
+}
+
+
+void network_c::enable_parallel(int num_threads)
+{
+  if (noc_parallel_engine_c::is_supported(m_simBase, m_num_router))
+    m_parallel = new noc_parallel_engine_c(m_simBase, m_router, num_threads);
+}
+
+
+void network_c::run_routers(bool pll_lock)
+{
+  if (m_skipped_cycles > 0) {
+    for (int ii = 0; ii < m_num_router; ++ii)
+      m_router[ii]->skip_cycles(m_skipped_cycles);
+    m_skipped_cycles = 0;
+  }
+
+  if (m_parallel != NULL) {
+    m_active = m_parallel->run_a_cycle(CYCLE % m_num_router, pll_lock);
+    return;
+  }
+
+  // randomized tick function
+  int index = CYCLE % m_num_router;
+  for (int ii = index; ii < index + m_num_router; ++ii) {
+    router_c* router = m_router[ii % m_num_router];
+    if (router->is_active())
+      router->run_a_cycle(pll_lock);
+    else
+      router->skip_inactive_cycle();
+  }
+
+  // a router may become active after its turn, so check once all routers ran
+  m_active = false;
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    if (m_router[ii]->is_active()) {
+      m_active = true;
+      break;
+    }
+  }
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 
-router_c::router_c(macsim_c* simBase, int type, int id, int num_port)
-  : m_simBase(simBase), m_type(type), m_id(id), m_num_port(num_port)
+router_c::router_c(macsim_c* simBase, int type, int id, int num_port, int num_local)
+  : m_simBase(simBase), m_type(type), m_id(id), m_num_port(num_port), m_num_local(num_local)
 {
   // configuration
   m_num_vc              = *KNOB(KNOB_NUM_VC); 
@@ -181,8 +268,14 @@ router_c::router_c(macsim_c* simBase, int type, int id, int num_port)
   m_link_width          = *KNOB(KNOB_LINK_WIDTH);
   m_num_vc_cpu          = *KNOB(KNOB_CPU_VC_PARTITION);
   m_next_vc             = 0;
+  m_cycle               = 0;
+  m_occupancy           = 0;
+  m_parallel            = NULL;
   
   // link setting
+  m_link = new router_c*[m_num_port];
+  fill_n(m_link, m_num_port, static_cast<router_c*>(NULL));
+
   m_opposite_dir[LOCAL] = LOCAL;
   m_opposite_dir[LEFT]  = RIGHT;
   m_opposite_dir[RIGHT] = LEFT;
@@ -190,9 +283,9 @@ router_c::router_c(macsim_c* simBase, int type, int id, int num_port)
   m_opposite_dir[DOWN]  = UP;
 
   // memory allocations
-  m_req_buffer = new queue<mem_req_s*>;
+  m_req_buffer = new queue<mem_req_s*>[m_num_local];
 
-  m_injection_buffer = new list<mem_req_s*>;
+  m_injection_buffer = new list<mem_req_s*>[m_num_local];
   m_injection_buffer_max_size = 32;
 
   m_input_buffer    = new list<flit_c*>*[m_num_port];
@@ -247,8 +340,9 @@ router_c::router_c(macsim_c* simBase, int type, int id, int num_port)
 
 router_c::~router_c()
 {
-  delete m_req_buffer;
-  delete m_injection_buffer;
+  delete[] m_req_buffer;
+  delete[] m_injection_buffer;
+  delete[] m_link;
   for (int ii = 0; ii < m_num_port; ++ii) {
     delete[] m_input_buffer[ii];
     delete[] m_output_buffer[ii];
@@ -318,8 +412,16 @@ void router_c::run_a_cycle(bool pll_lock)
 // insert a packet from the network interface (NI)
 bool router_c::inject_packet(mem_req_s* req)
 {
-  if (m_injection_buffer->size() < m_injection_buffer_max_size) {
-    m_injection_buffer->push_back(req);
+  return inject_packet(req, 0);
+}
+
+
+// insert a packet from the network interface (NI) of a local port
+bool router_c::inject_packet(mem_req_s* req, int local)
+{
+  if (m_injection_buffer[local].size() < m_injection_buffer_max_size) {
+    m_injection_buffer[local].push_back(req);
+    ++m_occupancy;
     return true;
   }
 
@@ -330,8 +432,20 @@ bool router_c::inject_packet(mem_req_s* req)
 // insert a packet from the injection buffer
 void router_c::local_packet_injection(void)
 {
+  for (int local = 0; local < m_num_local; ++local) {
+    local_packet_injection(local);
+  }
+}
+
+
+// insert a packet from the injection buffer of a local port
+void router_c::local_packet_injection(int local)
+{
+  list<mem_req_s*>* injection_buffer = &m_injection_buffer[local];
+  list<flit_c*>* input_buffer = m_input_buffer[local_port(local)];
+
   while (1) {
-    if (m_injection_buffer->empty())
+    if (injection_buffer->empty())
       break;
 
     bool req_inserted = false;
@@ -342,9 +456,9 @@ void router_c::local_packet_injection(void)
       // check buffer availability to insert a new request
       bool cpu_queue = false;
       mem_req_s* req;
-      if (m_injection_buffer->empty())
+      if (injection_buffer->empty())
         continue;
-      req = m_injection_buffer->front();
+      req = injection_buffer->front();
       cpu_queue = false;
 
       assert(req);
@@ -358,29 +472,16 @@ void router_c::local_packet_injection(void)
 
 #ifdef GPU_VALIDATION
       last_tried_vc = (m_next_vc + ii) % m_num_vc;
-      if (m_input_buffer[0][(m_next_vc + ii) % m_num_vc].size() + num_flit <= m_buffer_max_size) {
+      if (input_buffer[(m_next_vc + ii) % m_num_vc].size() + num_flit <= m_buffer_max_size) {
 #else
-      if (m_input_buffer[0][ii].size() + num_flit <= m_buffer_max_size) {
+      if (input_buffer[ii].size() + num_flit <= m_buffer_max_size) {
 #endif
         // flit generation and insert into the buffer
         STAT_EVENT(TOTAL_PACKET_CPU + req->m_ptx);
         req->m_noc_cycle = m_cycle;
 
         // stat handling
-        ++g_total_packet;
-        if (req->m_ptx) {
-          ++g_total_gpu_packet;
-          STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE_GPU);
-          STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET_GPU, g_total_gpu_packet);
-        }
-        else {
-          ++g_total_cpu_packet;
-          STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE_CPU);
-          STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET_CPU, g_total_cpu_packet);
-        }
-
-        STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE);
-        STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET, g_total_packet);
+        count_packet(req->m_ptx, true);
 
         // packet generation
         for (int jj = 0; jj < num_flit; ++jj) {
@@ -403,14 +504,15 @@ void router_c::local_packet_injection(void)
 
           // insert all flits to input_buffer[LOCAL][vc]
 #ifdef GPU_VALIDATION
-          m_input_buffer[0][(m_next_vc + ii) % m_num_vc].push_back(new_flit);
+          input_buffer[(m_next_vc + ii) % m_num_vc].push_back(new_flit);
 #else
-          m_input_buffer[0][ii].push_back(new_flit);
+          input_buffer[ii].push_back(new_flit);
 #endif
         }
 
         // pop a request from the injection queue
-        m_injection_buffer->pop_front();
+        injection_buffer->pop_front();
+        m_occupancy += num_flit - 1;
         req_inserted = true;
 
         DEBUG("cycle:%-10lld node:%d [IB] req_id:%d src:%d dst:%d\n",
@@ -456,22 +558,23 @@ void router_c::stage_vca(void)
         }
         assert(port != -1);
 
-        if (port != LOCAL) {
+        if (!is_local_port(port)) {
           m_link[port]->insert_packet(flit, m_opposite_dir[port], ivc);
           flit->m_rdy_cycle = m_cycle + 1;
         }
 
         // delete flit in the buffer
         m_input_buffer[ip][ivc].pop_front();
+        --m_occupancy;
 
         // free 1) switch, 2) ivc_avail[ip][ivc], 3) rc, 4) vc
         if (flit->m_tail) {
-          if (port == LOCAL) {
-            m_req_buffer->push(flit->m_req);
+          if (is_local_port(port)) {
+            m_req_buffer[local_index(port)].push(flit->m_req);
           }
         }
 
-        if (port == LOCAL) {
+        if (is_local_port(port)) {
           flit->init();
           m_flit_pool->release_entry(flit);
         }
@@ -632,7 +735,7 @@ void router_c::stage_st(void)
       }
 
       // send a credit back to previous router
-      if (ip != LOCAL) {
+      if (!is_local_port(ip)) {
         credit_c* credit = m_credit_pool->acquire_entry();
         credit->m_port = m_opposite_dir[ip];
         credit->m_vc = ivc;
@@ -675,7 +778,7 @@ void router_c::stage_lt(void)
 
     if (vc != -1) {
       // insert to next router
-      if (port != LOCAL) {
+      if (!is_local_port(port)) {
         DEBUG("cycle:%-10lld node:%d [LT] req_id:%d flit_id:%d src:%d dst:%d port:%d vc:%d\n",
             m_cycle, m_id, f->m_req->m_id, f->m_id, f->m_req->m_msg_src, 
             f->m_req->m_msg_dst, port, vc);
@@ -688,8 +791,9 @@ void router_c::stage_lt(void)
 
       // delete flit in the buffer
       m_output_buffer[port][vc].pop_front();
+      --m_occupancy;
 
-      if (port != LOCAL)
+      if (!is_local_port(port))
         --m_credit[port][vc];
 
       // free 1) switch, 2) ivc_avail[ip][ivc], 3) rc, 4) vc
@@ -703,15 +807,9 @@ void router_c::stage_lt(void)
         m_output_vc_avail[port][vc] = true;
 
 
-        if (port == LOCAL) {
-          --g_total_packet;
-          if (f->m_req->m_ptx) {
-            --g_total_gpu_packet;
-          }
-          else {
-            --g_total_cpu_packet;
-          }
-          m_req_buffer->push(f->m_req);
+        if (is_local_port(port)) {
+          count_packet(f->m_req->m_ptx, false);
+          m_req_buffer[local_index(port)].push(f->m_req);
           DEBUG("cycle:%-10lld node:%d [TT] req_id:%d flit_id:%d src:%d dst:%d vc:%d\n",
               m_cycle, m_id, f->m_req->m_id, f->m_id, f->m_req->m_msg_src,
               f->m_req->m_msg_dst, vc);
@@ -724,7 +822,7 @@ void router_c::stage_lt(void)
         }
       }
 
-      if (port == LOCAL) {
+      if (is_local_port(port)) {
         f->init();
         m_flit_pool->release_entry(f);
       }
@@ -740,6 +838,10 @@ void router_c::check_channel(void)
 
 void router_c::insert_packet(flit_c* flit, int port, int vc)
 {
+  // from a router of another partition : delivered by the parallel engine
+  if (m_parallel != NULL && m_parallel->post_flit(m_id, flit, port, vc))
+    return;
+
   // IB (Input Buffering) stage
   if (flit->m_head)
     DEBUG("cycle:%-10lld node:%d [IB] req_id:%d src:%d dst:%d ip:%d vc:%d\n",
@@ -747,6 +849,7 @@ void router_c::insert_packet(flit_c* flit, int port, int vc)
 
   m_input_buffer[port][vc].push_back(flit);
   flit->m_state = IB;
+  ++m_occupancy;
 }
 
 
@@ -758,7 +861,11 @@ void router_c::insert_packet(mem_req_s* req)
 
 void router_c::insert_credit(credit_c* credit)
 {
+  if (m_parallel != NULL && m_parallel->post_credit(m_id, credit))
+    return;
+
   m_pending_credit->push_back(credit);
+  ++m_occupancy;
 }
 
 
@@ -775,23 +882,25 @@ void router_c::process_pending_credit(void)
       ++m_credit[credit->m_port][credit->m_vc];
       m_pending_credit->remove(credit);
       m_credit_pool->release_entry(credit);
+      --m_occupancy;
     }
   } while (I != E);
 }
 
 
+// dir : local port index
 mem_req_s* router_c::receive_req(int dir)
 {
-  if (m_req_buffer->empty())
+  if (m_req_buffer[dir].empty())
     return NULL;
   else
-    return m_req_buffer->front();
+    return m_req_buffer[dir].front();
 }
 
 
 void router_c::pop_req(int dir)
 {
-  m_req_buffer->pop();
+  m_req_buffer[dir].pop();
 }
 
 
@@ -832,10 +941,84 @@ void router_c::set_router_map(deque<router_c*>& router_map)
   m_router_map = router_map;
 }
 
+bool router_c::is_idle(void)
+{
+  if (!m_pending_credit->empty())
+    return false;
+
+  for (int ii = 0; ii < m_num_local; ++ii) {
+    if (!m_injection_buffer[ii].empty() || !m_req_buffer[ii].empty())
+      return false;
+  }
+
+  for (int ii = 0; ii < m_num_port; ++ii) {
+    for (int jj = 0; jj < m_num_vc; ++jj) {
+      if (!m_input_buffer[ii][jj].empty() || !m_output_buffer[ii][jj].empty())
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void router_c::skip_cycles(Counter num_cycles)
+{
+  m_cycle += num_cycles;
+}
+
 void router_c::reset(void)
 {
 }
 
+void router_c::count_packet(bool ptx, bool inject)
+{
+  if (m_parallel != NULL) {
+    m_packet_count_log.push_back((inject ? 2 : 0) | (ptx ? 1 : 0));
+    return;
+  }
+
+  update_packet_count(ptx, inject);
+}
+
+void router_c::update_packet_count(bool ptx, bool inject)
+{
+  if (!inject) {
+    --g_total_packet;
+    if (ptx) {
+      --g_total_gpu_packet;
+    }
+    else {
+      --g_total_cpu_packet;
+    }
+    return;
+  }
+
+  ++g_total_packet;
+  if (ptx) {
+    ++g_total_gpu_packet;
+    STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE_GPU);
+    STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET_GPU, g_total_gpu_packet);
+  }
+  else {
+    ++g_total_cpu_packet;
+    STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE_CPU);
+    STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET_CPU, g_total_cpu_packet);
+  }
+
+  STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE);
+  STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET, g_total_packet);
+}
+
+void router_c::replay_packet_count(void)
+{
+  if (m_packet_count_log.empty())
+    return;
+
+  for (auto itr = m_packet_count_log.begin(); itr != m_packet_count_log.end(); ++itr)
+    update_packet_count(*itr & 1, *itr & 2);
+  m_packet_count_log.clear();
+}
+
 int* router_c::get_num_packet_inserted(void)
 {
   return NULL;
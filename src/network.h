@@ -48,6 +48,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "macsim.h"
 
 
+class noc_parallel_engine_c;
+
+
 #define CPU_ROUTER 0
 #define GPU_ROUTER 1
 #define L3_ROUTER 2
@@ -150,11 +153,12 @@ class credit_c
 class router_c
 {
   public:
-    router_c(macsim_c* simBase, int type, int id, int num_port);
+    router_c(macsim_c* simBase, int type, int id, int num_port, int num_local = 1);
     ~router_c();
 
   public:
     virtual bool inject_packet(mem_req_s* req);
+    bool inject_packet(mem_req_s* req, int local);
     virtual mem_req_s* receive_req(int dir);
     virtual void pop_req(int dir);
     virtual void init(int total_router, int* total_packet, pool_c<flit_c>* flit_pool, 
@@ -169,12 +173,58 @@ class router_c
     virtual void insert_credit(credit_c*);
     virtual router_c* get_router(int dir);
 
+    /**
+     * Check whether the router holds no packet, flit, or credit
+     */
+    virtual bool is_idle(void);
+
+    /**
+     * Advance the router clock without running it (only when idle)
+     */
+    virtual void skip_cycles(Counter num_cycles);
+
+    /**
+     * Is there a packet, flit, or credit for the pipeline? (ejected packets excluded)
+     */
+    inline bool is_active(void) const { return m_occupancy > 0; }
+
+    /**
+     * Advance the clock of an inactive router, whose stages have nothing to do
+     */
+    inline void skip_inactive_cycle(void) { ++m_cycle; }
+
     // these functions are currently used by only network_simple_c
     virtual void reset(void);
     virtual int* get_num_packet_inserted(void);
 
     void set_router_map(deque<router_c*>& router_map);
     void insert_packet(mem_req_s* req);
+
+    /**
+     * Is the port a local (injection/ejection) port? A concentrated router has
+     * additional local ports after DOWN.
+     */
+    inline bool is_local_port(int port) const { return port == LOCAL || port > DOWN; }
+
+    /**
+     * Index of the node attached to a local port
+     */
+    inline int local_index(int port) const { return port == LOCAL ? 0 : port - DOWN; }
+
+    /**
+     * Local port of the attached node
+     */
+    inline int local_port(int index) const { return index == 0 ? LOCAL : DOWN + index; }
+
+    /**
+     * Step the router on the host threads of the engine (NULL : serial)
+     */
+    inline void set_parallel(noc_parallel_engine_c* parallel) { m_parallel = parallel; }
+
+    /**
+     * Apply the packet count updates logged during a parallel cycle
+     */
+    void replay_packet_count(void);
     
     /**
      * VCA (Virtual Channel Allocation) stage
@@ -211,6 +261,11 @@ class router_c
      */
     virtual void local_packet_injection(void);
 
+    /**
+     * Local packet injection from a local port
+     */
+    void local_packet_injection(int local);
+
     /**
      * Process pending credits to model credit traversal latency
      */
@@ -236,6 +291,17 @@ class router_c
      */
     virtual void check_starvation(void);
 
+    /**
+     * Update the global packet counts on injection or ejection (logged while stepped in
+     * parallel, since the injection samples depend on the serial order of routers)
+     */
+    void count_packet(bool ptx, bool inject);
+
+    /**
+     * Update the global packet counts and sample them on injection
+     */
+    void update_packet_count(bool ptx, bool inject);
+
   private:
     router_c(); // do not implement
 
@@ -244,6 +310,7 @@ class router_c
 
     int m_num_vc; /**< number of virtual channels */
     int m_num_port; /**< number of ports */
+    int m_num_local; /**< number of local ports (nodes attached to the router) */
     
     string m_topology; /**< router topology */
     int m_type; /**< router type */
@@ -266,13 +333,13 @@ class router_c
     int m_arbitration_policy; /**< arbitration policy */
 
     // link
-    router_c* m_link[5]; /**< links */
+    router_c** m_link; /**< links (per port) */
     unordered_map<int, int> m_opposite_dir; /**< opposite direction map */
 
     // buffers
-    list<mem_req_s*>* m_injection_buffer; /**< injection queue */
+    list<mem_req_s*>* m_injection_buffer; /**< injection queue (per local port) */
     int m_injection_buffer_max_size; /**< max injection queue size */
-    queue<mem_req_s*>* m_req_buffer; /**< ejection queue */
+    queue<mem_req_s*>* m_req_buffer; /**< ejection queue (per local port) */
 
     int m_buffer_max_size; /**< input/output buffer max size */
 
@@ -300,6 +367,13 @@ class router_c
     // clock
     Counter m_cycle; /**< router clock */
 
+    // activity gating
+    int m_occupancy; /**< packets in the injection buffer, flits, and pending credits */
+
+    // parallel stepping
+    noc_parallel_engine_c* m_parallel; /**< parallel stepping engine */
+    vector<uns8> m_packet_count_log; /**< packet count updates (bit 0: ptx, bit 1: inject) */
+
 };
 
 
@@ -336,6 +410,33 @@ class network_c
 
     virtual void print() = 0;
 
+    /**
+     * Check whether all routers are idle
+     */
+    virtual bool is_idle(void);
+
+    /**
+     * Advance clocks of the network (only when idle)
+     */
+    virtual void skip_cycles(Counter num_cycles);
+
+    /**
+     * Does any router have work? When false, the NoC clock domain can be skipped.
+     */
+    inline bool is_active(void) const { return m_active; }
+
+    /**
+     * Step routers on multiple host threads, if the network supports it
+     */
+    void enable_parallel(int num_threads);
+
+  protected:
+    /**
+     * Tick routers from a rotating start index, skipping inactive routers, and update
+     * the network activity
+     */
+    void run_routers(bool pll_lock);
+
   protected:
     macsim_c* m_simBase;
     string m_topology; /**< topology */
@@ -356,6 +457,12 @@ class network_c
 
     Counter m_cycle; /**< clock cycle */
 
+    // activity gating
+    bool m_active; /**< any router active after the last cycle (or a packet sent since) */
+    Counter m_skipped_cycles; /**< cycles skipped but not yet applied to the router clocks */
+
+    noc_parallel_engine_c* m_parallel; /**< parallel router stepping (NULL : serial) */
+
 };
 
 
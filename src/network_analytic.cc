@@ -0,0 +1,339 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : network_analytic.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : analytical latency/bandwidth network model
+ *********************************************************************************************/
+
+
+#include <fstream>
+#include <cmath>
+
+#include "network_analytic.h"
+#include "all_knobs.h"
+#include "all_stats.h"
+#include "utils.h"
+#include "debug_macros.h"
+#include "assert_macros.h"
+#include "memreq_info.h"
+
+
+#define DEBUG(args...) _DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_NOC, ## args)
+
+// flits an injection port can hold beyond the current cycle (router_c : 32 packets)
+#define INJECTION_LIMIT 32
+
+// utilization cap for the queueing model
+#define MAX_LINK_UTIL 0.95f
+
+
+extern int g_total_packet;
+extern int g_total_cpu_packet;
+extern int g_total_gpu_packet;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+
+network_analytic_c::network_analytic_c(macsim_c* simBase)
+  : network_c(simBase)
+{
+  m_topology        = "analytic";
+  m_mesh            = (*KNOB(KNOB_NOC_DIMENSION) == 2);
+  m_width           = 0;
+  m_router_delay    = *KNOB(KNOB_ANALYTIC_NOC_ROUTER_DELAY);
+  m_link_latency    = *KNOB(KNOB_LINK_LATENCY);
+  m_link_width      = *KNOB(KNOB_LINK_WIDTH);
+  m_injection_limit = INJECTION_LIMIT;
+  m_window          = *KNOB(KNOB_ANALYTIC_NOC_WINDOW);
+  m_window_end      = m_window;
+  m_seq             = 0;
+
+  ASSERTM(m_window > 0, "analytic_noc_window should be positive\n");
+}
+
+
+network_analytic_c::~network_analytic_c()
+{
+}
+
+
+#define CREATE_NODE(index, level, offset) \
+  for (int ii = 0; ii < index; ++ii) { \
+    m_router_map[level*1000+ii+offset] = m_num_router++; \
+  }
+
+
+// same node placement as network_ring_c and network_mesh_c
+void network_analytic_c::init(int num_cpu, int num_gpu, int num_l3, int num_llc, int num_mc)
+{
+  m_num_router = 0;
+  m_num_cpu = num_cpu;
+  m_num_gpu = num_gpu;
+  m_num_l3  = num_l3;
+  m_num_llc = num_llc;
+  m_num_mc  = num_mc;
+
+  if (m_mesh) {
+    CREATE_NODE(m_num_cpu, MEM_L2, 0);
+    CREATE_NODE(m_num_l3, MEM_L3, 0);
+    CREATE_NODE(m_num_llc, MEM_LLC, 0);
+    CREATE_NODE(m_num_mc, MEM_MC, 0);
+    CREATE_NODE(m_num_gpu, MEM_L2, m_num_cpu);
+
+    m_width = sqrt(m_num_router);
+    if (m_width * m_width != m_num_router)
+      ++m_width;
+  }
+  else {
+    CREATE_NODE(m_num_cpu, MEM_L2, 0);
+    CREATE_NODE(m_num_gpu, MEM_L2, m_num_cpu);
+    CREATE_NODE(m_num_l3, MEM_L3, 0);
+    CREATE_NODE(m_num_llc, MEM_LLC, 0);
+    CREATE_NODE(m_num_mc, MEM_MC, 0);
+  }
+
+  report("ANALYTIC " << (m_mesh ? "MESH" : "RING") << " TOTAL_NODE:" << m_num_router 
+      << " CPU:" << m_num_cpu << " GPU:" << m_num_gpu << " L3:" << m_num_l3 
+      << " LLC:" << m_num_llc << " MC:" << m_num_mc);
+
+  m_delivered.resize(m_num_router);
+  m_injection_free.assign(m_num_router, 0);
+  m_ejection_free.assign(m_num_router, 0);
+  m_link_flit.assign(m_num_router * 4, 0);
+  m_link_util.assign(m_num_router * 4, 0.0f);
+}
+
+
+bool network_analytic_c::send(mem_req_s* req, int src_level, int src_id, int dst_level, 
+    int dst_id)
+{
+  int src = m_router_map[src_level*1000+src_id];
+  int dst = m_router_map[dst_level*1000+dst_id];
+
+  int num_flit = 1;
+  if ((req->m_msg_type == NOC_NEW_WITH_DATA) || (req->m_msg_type == NOC_FILL)) 
+    num_flit += req->m_size / m_link_width; 
+
+  // injection port : one flit per cycle
+  Counter depart = MAX2(m_cycle, m_injection_free[src]);
+  if (depart - m_cycle > m_injection_limit)
+    return false;
+
+  m_injection_free[src] = depart + num_flit;
+  req->m_msg_src = src;
+  req->m_msg_dst = dst;
+
+  update_window();
+
+  // head flit : router of the source, then link + router per hop
+  Counter head_cycle = depart + m_router_delay;
+  int node = src;
+  int ring_dir = RIGHT;
+  if (!m_mesh) {
+    int right = (dst - src + m_num_router) % m_num_router;
+    int left  = (src - dst + m_num_router) % m_num_router;
+    ring_dir = (left < right) ? LEFT : RIGHT;
+  }
+
+  while (node != dst) {
+    int dir = ring_dir;
+    if (m_mesh) {
+      // XY routing
+      int x_src = node % m_width;
+      int y_src = node / m_width;
+      int x_dst = dst % m_width;
+      int y_dst = dst / m_width;
+      if (x_src > x_dst)      dir = LEFT;
+      else if (x_src < x_dst) dir = RIGHT;
+      else if (y_src > y_dst) dir = UP;
+      else                    dir = DOWN;
+    }
+
+    int link = node * 4 + dir - 1;
+    head_cycle += queueing_delay(link, num_flit) + m_link_latency + m_router_delay;
+    m_link_flit[link] += num_flit;
+    STAT_EVENT_N(NOC_LINK_ACTIVE, num_flit);
+
+    switch (dir) {
+      case LEFT  : node = m_mesh ? node - 1 : (node - 1 + m_num_router) % m_num_router; break;
+      case RIGHT : node = m_mesh ? node + 1 : (node + 1) % m_num_router; break;
+      case UP    : node -= m_width; break;
+      case DOWN  : node += m_width; break;
+    }
+  }
+
+  // ejection port : the tail arrives num_flit - 1 cycles after the head
+  Counter eject_cycle = MAX2(head_cycle, m_ejection_free[dst]);
+  Counter deliver_cycle = eject_cycle + num_flit - 1;
+  m_ejection_free[dst] = deliver_cycle + 1;
+
+  packet_s packet;
+  packet.m_deliver_cycle = deliver_cycle;
+  packet.m_seq           = m_seq++;
+  packet.m_dst           = dst;
+  packet.m_req           = req;
+  m_in_flight.push(packet);
+  m_active = true;
+
+  // stat handling
+  STAT_EVENT(TOTAL_PACKET_CPU + req->m_ptx);
+  req->m_noc_cycle = m_cycle;
+
+  ++g_total_packet;
+  if (req->m_ptx) {
+    ++g_total_gpu_packet;
+    STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE_GPU);
+    STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET_GPU, g_total_gpu_packet);
+  }
+  else {
+    ++g_total_cpu_packet;
+    STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE_CPU);
+    STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET_CPU, g_total_cpu_packet);
+  }
+
+  STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE);
+  STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET, g_total_packet);
+
+  DEBUG("cycle:%-10lld [SEND] req_id:%d src:%d dst:%d flit:%d deliver:%lld\n",
+      m_cycle, req->m_id, src, dst, num_flit, deliver_cycle);
+
+  return true;
+}
+
+
+// M/D/1 waiting time with a service time of num_flit cycles
+Counter network_analytic_c::queueing_delay(int link, int num_flit)
+{
+  float util = m_link_util[link];
+  if (util <= 0.0f)
+    return 0;
+
+  util = MIN2(util, MAX_LINK_UTIL);
+  return static_cast<Counter>(util * num_flit / (2.0f * (1.0f - util)));
+}
+
+
+void network_analytic_c::update_window(void)
+{
+  if (m_cycle < m_window_end)
+    return;
+
+  // utilization of the window that just ended (idle if more than one window passed)
+  bool last_window = (m_cycle < m_window_end + m_window);
+  for (int ii = 0; ii < m_num_router * 4; ++ii) {
+    m_link_util[ii] = last_window ? static_cast<float>(m_link_flit[ii]) / m_window : 0.0f;
+    m_link_flit[ii] = 0;
+  }
+
+  m_window_end = (m_cycle / m_window + 1) * m_window;
+}
+
+
+void network_analytic_c::run_a_cycle(bool pll_lock)
+{
+  while (!pll_lock && !m_in_flight.empty() && m_in_flight.top().m_deliver_cycle <= m_cycle) {
+    packet_s packet = m_in_flight.top();
+    m_in_flight.pop();
+
+    mem_req_s* req = packet.m_req;
+    m_delivered[packet.m_dst].push(req);
+
+    --g_total_packet;
+    if (req->m_ptx) {
+      --g_total_gpu_packet;
+    }
+    else {
+      --g_total_cpu_packet;
+    }
+
+    DEBUG("cycle:%-10lld [RECV] req_id:%d src:%d dst:%d\n",
+        m_cycle, req->m_id, req->m_msg_src, req->m_msg_dst);
+
+    STAT_EVENT(NOC_AVG_LATENCY_BASE);
+    STAT_EVENT_N(NOC_AVG_LATENCY, m_cycle - req->m_noc_cycle);
+
+    STAT_EVENT(NOC_AVG_LATENCY_BASE_CPU + req->m_ptx);
+    STAT_EVENT_N(NOC_AVG_LATENCY_CPU + req->m_ptx, m_cycle - req->m_noc_cycle);
+  }
+
+  m_active = !m_in_flight.empty();
+  ++m_cycle;
+}
+
+
+mem_req_s* network_analytic_c::receive(int level, int id)
+{
+  queue<mem_req_s*>& delivered = m_delivered[m_router_map[level*1000+id]];
+  if (delivered.empty())
+    return NULL;
+
+  return delivered.front();
+}
+
+
+void network_analytic_c::receive_pop(int level, int id)
+{
+  m_delivered[m_router_map[level*1000+id]].pop();
+}
+
+
+bool network_analytic_c::is_idle(void)
+{
+  if (!m_in_flight.empty())
+    return false;
+
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    if (!m_delivered[ii].empty())
+      return false;
+  }
+
+  return true;
+}
+
+
+void network_analytic_c::skip_cycles(Counter num_cycles)
+{
+  m_cycle += num_cycles;
+}
+
+
+void network_analytic_c::print(void)
+{
+  ofstream out("router.out");
+  out << "in_flight:" << m_in_flight.size() << "\n";
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    out << "node:" << ii << " delivered:" << m_delivered[ii].size() 
+      << " injection_free:" << m_injection_free[ii] 
+      << " ejection_free:" << m_ejection_free[ii] << "\n";
+  }
+}
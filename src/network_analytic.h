@@ -0,0 +1,169 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : network_analytic.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : analytical latency/bandwidth network model
+ *********************************************************************************************/
+
+
+#ifndef NETWORK_ANALYTIC_H
+#define NETWORK_ANALYTIC_H
+
+
+#include <vector>
+#include <queue>
+
+#include "macsim.h"
+#include "network.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Analytical network model (noc_topology analytic)
+///
+/// Instead of moving flits through router pipelines, the delivery cycle of a packet is
+/// computed when it is sent :
+///   per hop    : router delay + link latency + M/D/1 queueing delay of the link, where the
+///                link utilization is the number of flits routed over it in the previous
+///                window of analytic_noc_window cycles
+///   end points : the injection and ejection ports serialize packets one flit per cycle
+/// Nodes are placed as in the ring (noc_dimension != 2) or the mesh (noc_dimension 2)
+/// network, with shortest-path routing on the ring and XY routing on the mesh. Delivered
+/// packets wait in a per-node queue for receive/receive_pop, as with the router models.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class network_analytic_c : public network_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    network_analytic_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~network_analytic_c();
+
+    /**
+     * Initialize the network
+     */
+    void init(int num_cpu, int num_gpu, int num_l3, int num_llc, int num_mc);
+
+    /**
+     * Send a packet : compute its delivery cycle
+     */
+    bool send(mem_req_s* req, int src_level, int src_id, int dst_level, int dst_id);
+
+    /**
+     * Get the oldest delivered packet of a node
+     */
+    mem_req_s* receive(int level, int id);
+
+    /**
+     * Remove the oldest delivered packet of a node
+     */
+    void receive_pop(int level, int id);
+
+    /**
+     * Deliver packets whose delivery cycle has come
+     */
+    void run_a_cycle(bool pll_lock);
+
+    /**
+     * Print network information
+     */
+    void print(void);
+
+    /**
+     * Check whether no packet is in flight or waiting to be received
+     */
+    bool is_idle(void);
+
+    /**
+     * Advance the clock (only when no packet is in flight)
+     */
+    void skip_cycles(Counter num_cycles);
+
+  private:
+    network_analytic_c(); // do not implement
+
+    /**
+     * Queueing delay of a link
+     */
+    Counter queueing_delay(int link, int num_flit);
+
+    /**
+     * Move to the utilization window of the current cycle
+     */
+    void update_window(void);
+
+  private:
+    /**
+     * Packet in flight
+     */
+    typedef struct packet_s {
+      Counter m_deliver_cycle; /**< delivery cycle */
+      Counter m_seq; /**< send order (tie breaker) */
+      int m_dst; /**< destination node */
+      mem_req_s* m_req; /**< request */
+
+      /**
+       * Later delivery has lower priority
+       */
+      bool operator<(const packet_s& rhs) const
+      {
+        if (m_deliver_cycle != rhs.m_deliver_cycle)
+          return m_deliver_cycle > rhs.m_deliver_cycle;
+        return m_seq > rhs.m_seq;
+      }
+    } packet_s;
+
+    bool m_mesh; /**< mesh (true) or ring placement */
+    int m_width; /**< mesh width */
+    int m_router_delay; /**< cycles per hop spent in a router */
+    int m_link_latency; /**< link latency */
+    int m_link_width; /**< link width (bytes per flit) */
+    int m_injection_limit; /**< max backlog of an injection port (flits) */
+    Counter m_window; /**< utilization window */
+    Counter m_window_end; /**< end of the current window */
+    Counter m_seq; /**< number of packets sent */
+
+    priority_queue<packet_s> m_in_flight; /**< packets not delivered yet */
+    vector<queue<mem_req_s*> > m_delivered; /**< delivered packets per node */
+    vector<Counter> m_injection_free; /**< next free cycle of the injection port per node */
+    vector<Counter> m_ejection_free; /**< next free cycle of the ejection port per node */
+
+    // per link (node * 4 + direction - 1)
+    vector<Counter> m_link_flit; /**< flits routed in the current window */
+    vector<float> m_link_util; /**< utilization in the previous window */
+};
+
+#endif
@@ -0,0 +1,765 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : network_flat.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : router with flat-array virtual channel buffers (ring/mesh)
+ *********************************************************************************************/
+
+
+#include <fstream>
+#include <cmath>
+
+#include "network_flat.h"
+#include "all_knobs.h"
+#include "all_stats.h"
+#include "utils.h"
+#include "debug_macros.h"
+#include "assert_macros.h"
+#include "memreq_info.h"
+
+
+#define DEBUG(args...) _DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_NOC, ## args)
+
+
+extern int g_total_packet;
+extern int g_total_cpu_packet;
+extern int g_total_gpu_packet;
+
+
+// port on the other end of a link (LOCAL, LEFT, RIGHT, UP, DOWN)
+static const int opposite_dir[5] = {LOCAL, RIGHT, LEFT, DOWN, UP};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+
+network_flat_c::network_flat_c(macsim_c* simBase, int dimension)
+  : network_c(simBase), m_dimension(dimension)
+{
+  m_topology = (dimension == 1) ? "flat_ring" : "flat_mesh";
+}
+
+
+network_flat_c::~network_flat_c()
+{
+}
+
+
+// run one cycle for all routers
+void network_flat_c::run_a_cycle(bool pll_lock)
+{
+  run_routers(pll_lock);
+  ++m_cycle;
+}
+
+
+#define CREATE_ROUTER(index, type, level, offset) \
+  for (int ii = 0; ii < index; ++ii) { \
+    m_router_map[level*1000+ii+offset] = m_num_router; \
+    router_c* new_router = new router_flat_c(m_simBase, type, m_num_router++, m_dimension); \
+    m_router.push_back(new_router); \
+  }
+
+
+// same router placement as network_ring_c and network_mesh_c
+void network_flat_c::init(int num_cpu, int num_gpu, int num_l3, int num_llc, int num_mc)
+{
+  m_num_router = 0;
+  m_num_cpu = num_cpu;
+  m_num_gpu = num_gpu;
+  m_num_l3  = num_l3;
+  m_num_llc = num_llc;
+  m_num_mc  = num_mc;
+
+  int width = 0;
+  if (m_dimension == 1) {
+    CREATE_ROUTER(m_num_cpu, CPU_ROUTER, MEM_L2, 0);
+    CREATE_ROUTER(m_num_gpu, GPU_ROUTER, MEM_L2, m_num_cpu);
+    CREATE_ROUTER(m_num_l3, L3_ROUTER, MEM_L3, 0);
+    CREATE_ROUTER(m_num_llc, LLC_ROUTER, MEM_LLC, 0);
+    CREATE_ROUTER(m_num_mc, MC_ROUTER, MEM_MC, 0);
+  }
+  else {
+    CREATE_ROUTER(m_num_cpu, CPU_ROUTER, MEM_L2, 0);
+    CREATE_ROUTER(m_num_l3, L3_ROUTER, MEM_L3, 0);
+    CREATE_ROUTER(m_num_llc, LLC_ROUTER, MEM_LLC, 0);
+    CREATE_ROUTER(m_num_mc, MC_ROUTER, MEM_MC, 0);
+    CREATE_ROUTER(m_num_gpu, GPU_ROUTER, MEM_L2, m_num_cpu);
+
+    // fill the square with dummy routers
+    width = sqrt(m_num_router);
+    if ((width * width) != m_num_router) {
+      for (; m_num_router < (width+1)*(width+1); ++m_num_router) {
+        report("router:" << m_num_router << " type:dummy created");
+
+        router_c* new_router = new router_flat_c(m_simBase, 0, m_num_router, m_dimension);
+        m_router.push_back(new_router);
+      }
+      ++width;
+    }
+  }
+
+  report("TOTAL_ROUTER:" << m_num_router << " CPU:" << m_num_cpu << " GPU:" << m_num_gpu
+      << " L3:" << m_num_l3 << " LLC:" << m_num_llc << " MC:" << m_num_mc);
+
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    m_router[ii]->init(m_num_router, &g_total_packet, m_flit_pool, m_credit_pool);
+  }
+
+  // connect routers
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    if (m_dimension == 1) {
+      m_router[ii]->set_link(LEFT,  m_router[(ii-1+m_num_router)%m_num_router]);
+      m_router[ii]->set_link(RIGHT, m_router[(ii+1)%m_num_router]);
+      continue;
+    }
+
+    if (ii / width > 0)  // north link
+      m_router[ii]->set_link(UP, m_router[ii-width]);
+
+    if (ii / width < (width - 1))  // south link
+      m_router[ii]->set_link(DOWN, m_router[ii+width]);
+
+    if (ii % width != 0)  // west link
+      m_router[ii]->set_link(LEFT, m_router[ii-1]);
+
+    if (ii % width != (width - 1))  // east link
+      m_router[ii]->set_link(RIGHT, m_router[ii+1]);
+  }
+
+  m_router[0]->print_link_info();
+}
+
+
+void network_flat_c::print(void)
+{
+  ofstream out("router.out");
+  out << "total_packet:" << m_total_packet << "\n";
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    m_router[ii]->print(out);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+
+// constructor
+router_flat_c::router_flat_c(macsim_c* simBase, int type, int id, int dimension)
+  : router_c(simBase, type, id, dimension == 1 ? 3 : 5), m_dimension(dimension)
+{
+  // configurations
+  m_topology = (dimension == 1) ? "flat_ring" : "flat_mesh";
+  assert(*KNOB(KNOB_NOC_DIMENSION) == dimension);
+  assert(m_num_vc >= 2);
+  assert(m_arbitration_policy == OLDEST_FIRST);
+  ASSERTM(!*KNOB(KNOB_IDEAL_NOC), "ideal_noc is not supported by %s\n", m_topology.c_str());
+
+  int num_ivc = m_num_port * m_num_vc;
+  m_injection.init(1, m_injection_buffer_max_size);
+
+  m_ibuf.init(num_ivc, m_buffer_max_size);
+  m_route_mask.assign(num_ivc * 2, 0);
+  m_ivc_route.assign(num_ivc, -1);
+  m_ivc_oport.assign(num_ivc, -1);
+  m_ivc_ovc.assign(num_ivc, -1);
+
+  m_obuf.init(num_ivc, m_buffer_max_size);
+  m_ovc_avail.assign(num_ivc, true);
+  m_ovc_credit.assign(num_ivc, m_buffer_max_size);
+}
+
+
+// destructor
+router_flat_c::~router_flat_c()
+{
+}
+
+
+void router_flat_c::init(int total_router, int* total_packet, pool_c<flit_c>* flit_pool, 
+    pool_c<credit_c>* credit_pool)
+{
+  router_c::init(total_router, total_packet, flit_pool, credit_pool);
+  m_width = sqrt(total_router);
+}
+
+
+void router_flat_c::run_a_cycle(bool pll_lock)
+{
+  if (pll_lock) {
+    ++m_cycle;
+    return;
+  }
+
+  process_pending_credit();
+  stage_lt();
+  stage_sa();
+  stage_st();
+  stage_rc();
+  stage_vca();
+  local_packet_injection();
+
+  ++m_cycle;
+}
+
+
+bool router_flat_c::inject_packet(mem_req_s* req)
+{
+  if (!m_injection.push_back(0, req))
+    return false;
+
+  ++m_occupancy;
+  return true;
+}
+
+
+// insert packets from the injection buffer to the local input port
+void router_flat_c::local_packet_injection(void)
+{
+  while (!m_injection.empty(0)) {
+    bool req_inserted = false;
+#ifdef GPU_VALIDATION
+    int last_tried_vc = -1;
+#endif
+    mem_req_s* req = m_injection.front(0);
+    int num_flit = 1;
+    if ((req->m_msg_type == NOC_NEW_WITH_DATA) || (req->m_msg_type == NOC_FILL)) 
+      num_flit += req->m_size / m_link_width; 
+
+    for (int ii = 0; ii < m_num_vc; ++ii) {
+#ifdef GPU_VALIDATION
+      int vc = (m_next_vc + ii) % m_num_vc;
+      last_tried_vc = vc;
+#else
+      int vc = ii;
+#endif
+      // the local port is port 0, so vc is also the input buffer index
+      if (m_ibuf.size(vc) + num_flit > m_buffer_max_size)
+        continue;
+
+      STAT_EVENT(TOTAL_PACKET_CPU + req->m_ptx);
+      req->m_noc_cycle = m_cycle;
+
+      // stat handling
+      ++g_total_packet;
+      if (req->m_ptx) {
+        ++g_total_gpu_packet;
+        STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE_GPU);
+        STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET_GPU, g_total_gpu_packet);
+      }
+      else {
+        ++g_total_cpu_packet;
+        STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE_CPU);
+        STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET_CPU, g_total_cpu_packet);
+      }
+
+      STAT_EVENT(NOC_AVG_ACTIVE_PACKET_BASE);
+      STAT_EVENT_N(NOC_AVG_ACTIVE_PACKET, g_total_packet);
+
+      // packet generation
+      for (int jj = 0; jj < num_flit; ++jj) {
+        flit_c* new_flit = m_flit_pool->acquire_entry();
+        new_flit->m_req       = req;
+        new_flit->m_src       = req->m_msg_src;
+        new_flit->m_dst       = req->m_msg_dst;
+        new_flit->m_head      = (jj == 0);
+        new_flit->m_tail      = (jj == num_flit-1);
+        new_flit->m_state     = IB;
+        new_flit->m_timestamp = m_cycle;
+        new_flit->m_rdy_cycle = m_cycle;
+        new_flit->m_id        = jj;
+        new_flit->m_dir       = -1;
+
+        m_ibuf.push_back(vc, new_flit);
+      }
+
+      m_injection.pop_front(0);
+      m_occupancy += num_flit - 1;
+      req_inserted = true;
+
+      DEBUG("cycle:%-10lld node:%d [IB] req_id:%d src:%d dst:%d\n",
+          m_cycle, m_id, req->m_id, req->m_msg_src, req->m_msg_dst);
+      break;
+    }
+
+#ifdef GPU_VALIDATION
+    if (last_tried_vc != -1 && *KNOB(KNOB_USE_RR_FOR_NOC_INSERTION)) {
+      m_next_vc = (last_tried_vc + 1) % m_num_vc;
+    }
+#endif
+
+    // Nothing was scheduled. Stop inserting!
+    if (!req_inserted)
+      break;
+  }
+}
+
+
+// RC (Route Calculation) stage : shortest path on the ring, XY (+ escape) on the mesh
+void router_flat_c::stage_rc(void)
+{
+  for (int port = 0; port < m_num_port; ++port) {
+    for (int vc = 0; vc < m_num_vc; ++vc) {
+      int iv = port * m_num_vc + vc;
+      if (m_ibuf.empty(iv) || (m_dimension == 1 && m_ivc_route[iv] != -1))
+        continue;
+
+      flit_c* flit = m_ibuf.front(iv);
+      if (flit->m_head == false || flit->m_state != IB || flit->m_rdy_cycle > m_cycle)
+        continue;
+
+      uns32* route = &m_route_mask[iv * 2];
+      if (m_dimension == 1) {
+        if (flit->m_dst == m_id) {
+          route[0] = 1 << LOCAL;
+        }
+        else if (flit->m_dir != -1) {
+          route[0] = 1 << flit->m_dir;
+        }
+        else {
+          int left;
+          int right;
+          if (m_id > flit->m_dst) {
+            left = m_id - flit->m_dst;
+            right = flit->m_dst - m_id + m_total_router;
+          }
+          else {
+            left = m_id - flit->m_dst + m_total_router;
+            right = flit->m_dst - m_id;
+          }
+
+          flit->m_dir = (left < right) ? LEFT : RIGHT;
+          route[0] = 1 << flit->m_dir;
+        }
+      }
+      else {
+        route[0] = route[1] = 0;
+        if (flit->m_dst == m_id) {
+          route[0] = route[1] = 1 << LOCAL;
+        }
+        else {
+          int x_src = m_id % m_width;
+          int y_src = m_id / m_width;
+          int x_dst = flit->m_dst % m_width;
+          int y_dst = flit->m_dst / m_width;
+
+          // adaptive routing
+          if (x_src > x_dst)
+            route[0] |= 1 << LEFT;
+          else if (x_src < x_dst)
+            route[0] |= 1 << RIGHT;
+
+          if (y_src > y_dst) 
+            route[0] |= 1 << UP;
+          else if (y_src < y_dst)
+            route[0] |= 1 << DOWN;
+
+          // escape routing
+          if (x_src > x_dst)
+            route[1] = 1 << LEFT;
+          else if (x_src < x_dst)
+            route[1] = 1 << RIGHT;
+          else if (y_src > y_dst) 
+            route[1] = 1 << UP;
+          else if (y_src < y_dst)
+            route[1] = 1 << DOWN;
+        }
+      }
+
+      flit->m_state = RC;
+      DEBUG("cycle:%-10lld node:%d [RC] req_id:%d flit_id:%d src:%d dst:%d ip:%d vc:%d\n",
+          m_cycle, m_id, flit->m_req->m_id, flit->m_id, flit->m_req->m_msg_src,
+          flit->m_req->m_msg_dst, port, vc);
+    }
+  }
+}
+
+
+// VCA (Virtual Channel Allocation) stage
+void router_flat_c::stage_vca(void)
+{
+  for (int oport = 0; oport < m_num_port; ++oport) {
+    for (int ovc = 0; ovc < m_num_vc; ++ovc) {
+      int ov = oport * m_num_vc + ovc;
+      if (!m_ovc_avail[ov])
+        continue;
+
+      int iport, ivc;
+      stage_vca_pick_winner(oport, ovc, iport, ivc);
+      if (iport == -1)
+        continue;
+
+      int iv = iport * m_num_vc + ivc;
+      flit_c* flit = m_ibuf.front(iv);
+      flit->m_state = VCA;
+
+      m_ivc_oport[iv]  = oport;
+      m_ivc_ovc[iv]    = ovc;
+      m_ivc_route[iv]  = oport;
+      m_ovc_avail[ov]  = false;
+
+      DEBUG("cycle:%-10lld node:%d [VA] req_id:%d flit_id:%d src:%d dst:%d ip:%d ic:%d "
+          "op:%d oc:%d ptx:%d\n",
+          m_cycle, m_id, flit->m_req->m_id, flit->m_id, flit->m_req->m_msg_src, 
+          flit->m_req->m_msg_dst, iport, ivc, oport, ovc, flit->m_req->m_ptx);
+    }
+  }
+}
+
+
+// oldest-first VC arbitration
+void router_flat_c::stage_vca_pick_winner(int oport, int ovc, int& iport, int& ivc)
+{
+  // the last vc of the mesh uses the escape route
+  int rc_index = (m_dimension == 1) ? 0 : ovc / (m_num_vc - 1);
+  uns32 oport_mask = 1 << oport;
+
+  Counter oldest_timestamp = ULLONG_MAX;
+  iport = -1;
+  for (int ii = 0; ii < m_num_port; ++ii) {
+    if (ii == oport)
+      continue;
+
+    for (int jj = 0; jj < m_num_vc; ++jj) {
+      int iv = ii * m_num_vc + jj;
+      if (m_ibuf.empty(iv) || !(m_route_mask[iv * 2 + rc_index] & oport_mask))
+        continue;
+
+      flit_c* flit = m_ibuf.front(iv);
+
+      // DUATO's deadlock prevention protocol on the ring
+      if (m_dimension == 1) {
+        if (ovc == m_num_vc - 2 && m_id > flit->m_dst)
+          continue;
+        if (ovc == m_num_vc - 1 && m_id < flit->m_dst)
+          continue;
+      }
+
+      // header && RC stage && oldest
+      if (flit->m_head == true && flit->m_state == RC && flit->m_timestamp < oldest_timestamp) {
+        oldest_timestamp = flit->m_timestamp;
+        iport = ii;
+        ivc   = jj;
+      }
+    }
+  }
+}
+
+
+// SA (Switch Allocation) stage
+void router_flat_c::stage_sa(void)
+{
+  for (int op = 0; op < m_num_port; ++op) {
+    if (m_sw_avail[op] > m_cycle)
+      continue;
+
+    int ip, ivc;
+    stage_sa_pick_winner(op, ip, ivc, 0); 
+    if (ip == -1)
+      continue;
+
+    int iv = ip * m_num_vc + ivc;
+    flit_c* flit = m_ibuf.front(iv);
+    flit->m_state = SA;
+
+    m_sw_avail[op] = m_cycle + 1;
+
+    DEBUG("cycle:%-10lld node:%d [SA] req_id:%d flit_id:%d src:%d dst:%d ip:%d ic:%d op:%d oc:%d route:%d port:%d\n",
+        m_cycle, m_id, flit->m_req->m_id, flit->m_id, flit->m_req->m_msg_src, 
+        flit->m_req->m_msg_dst, ip, ivc, m_ivc_route[iv], m_ivc_ovc[iv], 
+        m_ivc_route[iv], m_ivc_oport[iv]);
+  }
+}
+
+
+// oldest-first switch arbitration
+void router_flat_c::stage_sa_pick_winner(int op, int& ip, int& ivc, int sw_id)
+{
+  Counter oldest_timestamp = ULLONG_MAX;
+  ip = -1;
+  for (int ii = 0; ii < m_num_port; ++ii) {
+    if (ii == op)
+      continue;
+
+    for (int jj = 0; jj < m_num_vc; ++jj) {
+      // find a flit that acquires a vc in current output port
+      int iv = ii * m_num_vc + jj;
+      if (m_ivc_route[iv] != op || m_ivc_oport[iv] != op || m_ibuf.empty(iv))
+        continue;
+
+      flit_c* flit = m_ibuf.front(iv);
+
+      // VCA & Header or IB & Body/Tail
+      if (((flit->m_head && flit->m_state == VCA) ||
+           (!flit->m_head && flit->m_state == IB)) && 
+          flit->m_timestamp < oldest_timestamp) {
+        oldest_timestamp = flit->m_timestamp;
+        ip = ii;
+        ivc = jj;
+      }
+    }
+  }
+}
+
+
+// ST (Switch Traversal) stage
+void router_flat_c::stage_st(void)
+{
+  for (int op = 0; op < m_num_port; ++op) {
+    // the first switch-allocated vc of the last input port wins (as router_c::stage_st)
+    int ip = -1;
+    int ivc = -1;
+    for (int ii = 0; ii < m_num_port; ++ii) {
+      if (ii == op)
+        continue;
+
+      for (int jj = 0; jj < m_num_vc; ++jj) {
+        int iv = ii * m_num_vc + jj;
+        if (m_ivc_route[iv] == op && m_ivc_oport[iv] == op && 
+            !m_ibuf.empty(iv) && m_ibuf.front(iv)->m_state == SA) {
+          ip = ii;
+          ivc = jj;
+          break;
+        }
+      }
+    }
+
+    if (ip == -1)
+      continue;
+
+    int iv = ip * m_num_vc + ivc;
+    flit_c* flit = m_ibuf.front(iv);
+    flit->m_state = ST;
+
+    // move the flit to the output buffer
+    int ovc = m_ivc_ovc[iv];
+    bool inserted = m_obuf.push_back(op * m_num_vc + ovc, flit);
+    ASSERTM(inserted, "output buffer overflow node:%d port:%d vc:%d\n", m_id, op, ovc);
+    m_ibuf.pop_front(iv);
+
+    // all flits traversed, so need to free a input vc
+    if (flit->m_tail) {
+      m_ivc_route[iv] = -1;
+      m_ivc_ovc[iv]   = -1;
+      m_ivc_oport[iv] = -1;
+    }
+
+    // send a credit back to previous router
+    if (ip != LOCAL) {
+      link(ip)->return_credit(opposite_dir[ip], ivc, m_cycle + 1);
+    }
+
+    DEBUG("cycle:%-10lld node:%d [ST] req_id:%d flit_id:%d src:%d dst:%d ip:%d ic:%d port:%d ovc:%d\n",
+        m_cycle, m_id, flit->m_req->m_id, flit->m_id, flit->m_req->m_msg_src, 
+        flit->m_req->m_msg_dst, ip, ivc, m_ivc_oport[iv], ovc);
+  }
+}
+
+
+// LT (Link Traversal) stage
+void router_flat_c::stage_lt(void)
+{
+  for (int port = 0; port < m_num_port; ++port) {
+    if (m_link_avail[port] > m_cycle) 
+      continue;
+
+    // first vc with a flit and a credit, starting from a rotating vc
+    flit_c* f = NULL;
+    int vc = -1;
+    for (int ii_d = 0; ii_d < m_num_vc; ++ii_d) {
+      int ii = (ii_d + m_cycle) % m_num_vc;
+      int ov = port * m_num_vc + ii;
+      if (m_obuf.empty(ov) || m_ovc_credit[ov] == 0)
+        continue;
+
+      f = m_obuf.front(ov);
+      assert(f->m_state == ST);
+      vc = ii;
+      break;
+    }
+
+    if (vc == -1)
+      continue;
+
+    int ov = port * m_num_vc + vc;
+
+    // insert to next router
+    if (port != LOCAL) {
+      DEBUG("cycle:%-10lld node:%d [LT] req_id:%d flit_id:%d src:%d dst:%d port:%d vc:%d\n",
+          m_cycle, m_id, f->m_req->m_id, f->m_id, f->m_req->m_msg_src, 
+          f->m_req->m_msg_dst, port, vc);
+
+      link(port)->insert_packet(f, opposite_dir[port], vc);
+      f->m_rdy_cycle = m_cycle + m_link_latency + 1;
+      m_link_avail[port] = m_cycle + m_link_latency; // link busy
+      STAT_EVENT(NOC_LINK_ACTIVE);
+    }
+
+    // delete flit in the buffer
+    m_obuf.pop_front(ov);
+    --m_occupancy;
+
+    if (port != LOCAL)
+      --m_ovc_credit[ov];
+
+    // free the output vc
+    if (f->m_tail) {
+      STAT_EVENT(NOC_AVG_WAIT_IN_ROUTER_BASE);
+      STAT_EVENT_N(NOC_AVG_WAIT_IN_ROUTER, m_cycle - f->m_timestamp);
+
+      STAT_EVENT(NOC_AVG_WAIT_IN_ROUTER_BASE_CPU + m_type);
+      STAT_EVENT_N(NOC_AVG_WAIT_IN_ROUTER_CPU + m_type, m_cycle - f->m_timestamp);
+
+      m_ovc_avail[ov] = true;
+
+      if (port == LOCAL) {
+        --g_total_packet;
+        if (f->m_req->m_ptx) {
+          --g_total_gpu_packet;
+        }
+        else {
+          --g_total_cpu_packet;
+        }
+        m_req_buffer->push(f->m_req);
+        DEBUG("cycle:%-10lld node:%d [TT] req_id:%d flit_id:%d src:%d dst:%d vc:%d\n",
+            m_cycle, m_id, f->m_req->m_id, f->m_id, f->m_req->m_msg_src,
+            f->m_req->m_msg_dst, vc);
+
+        STAT_EVENT(NOC_AVG_LATENCY_BASE);
+        STAT_EVENT_N(NOC_AVG_LATENCY, m_cycle - f->m_req->m_noc_cycle);
+
+        STAT_EVENT(NOC_AVG_LATENCY_BASE_CPU + f->m_req->m_ptx);
+        STAT_EVENT_N(NOC_AVG_LATENCY_CPU + f->m_req->m_ptx, m_cycle - f->m_req->m_noc_cycle);
+      }
+    }
+
+    if (port == LOCAL) {
+      f->init();
+      m_flit_pool->release_entry(f);
+    }
+  }
+}
+
+
+// IB (Input Buffering) stage
+void router_flat_c::insert_packet(flit_c* flit, int port, int vc)
+{
+  if (flit->m_head)
+    DEBUG("cycle:%-10lld node:%d [IB] req_id:%d src:%d dst:%d ip:%d vc:%d\n",
+        m_cycle, m_id, flit->m_req->m_id, flit->m_req->m_msg_src, flit->m_req->m_msg_dst, port, vc);
+
+  bool inserted = m_ibuf.push_back(port * m_num_vc + vc, flit);
+  ASSERTM(inserted, "input buffer overflow node:%d port:%d vc:%d\n", m_id, port, vc);
+  flit->m_state = IB;
+  ++m_occupancy;
+}
+
+
+void router_flat_c::return_credit(int port, int vc, Counter rdy_cycle)
+{
+  credit_s credit;
+  credit.m_rdy_cycle = rdy_cycle;
+  credit.m_port      = port;
+  credit.m_vc        = vc;
+  m_credit_queue.push_back(credit);
+  ++m_occupancy;
+}
+
+
+void router_flat_c::process_pending_credit(void)
+{
+  size_t ii = 0;
+  while (ii < m_credit_queue.size()) {
+    credit_s& credit = m_credit_queue[ii];
+    if (credit.m_rdy_cycle > CYCLE) {
+      ++ii;
+      continue;
+    }
+
+    ++m_ovc_credit[credit.m_port * m_num_vc + credit.m_vc];
+    credit = m_credit_queue.back();
+    m_credit_queue.pop_back();
+    --m_occupancy;
+  }
+}
+
+
+bool router_flat_c::is_idle(void)
+{
+  if (!m_injection.empty(0) || !m_req_buffer->empty() || !m_credit_queue.empty())
+    return false;
+
+  for (int ii = 0; ii < m_num_port * m_num_vc; ++ii) {
+    if (!m_ibuf.empty(ii) || !m_obuf.empty(ii))
+      return false;
+  }
+
+  return true;
+}
+
+
+void router_flat_c::print_link_info(void)
+{
+  if (m_dimension == 1) {
+    report("FLAT RING topology");
+    cout << m_id << " <-> ";
+    router_c* current = m_link[RIGHT];
+    do {
+      cout << current->get_id() << " <-> ";
+      current = current->get_router(RIGHT);
+    } while (current != this);
+    cout << "\n";
+    return;
+  }
+
+  report("FLAT MESH topology");
+  cout << m_id << " <-> ";
+  int dir = RIGHT; 
+  router_c* current = m_link[dir];
+  while (1) {
+    cout << current->get_id() << " <-> ";
+    if (current->get_router(dir) == NULL) {
+      cout << "\n";
+      dir = opposite_dir[dir];
+      if (current->get_router(DOWN) == NULL) {
+        break;
+      }
+      current = current->get_router(DOWN);
+    }
+    else {
+      current = current->get_router(dir);
+    }
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
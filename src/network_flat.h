@@ -0,0 +1,302 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : network_flat.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : router with flat-array virtual channel buffers (ring/mesh)
+ *********************************************************************************************/
+
+
+#ifndef NETWORK_FLAT_H
+#define NETWORK_FLAT_H
+
+
+#include <vector>
+
+#include "macsim.h"
+#include "network.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Fixed-capacity FIFOs stored back to back in one array
+///
+/// Queue q occupies slots [q * capacity, (q + 1) * capacity). Used for all input or all
+/// output virtual channels of a router, so a stage walks one contiguous block of memory.
+///////////////////////////////////////////////////////////////////////////////////////////////
+template<class T> class ring_buffer_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    ring_buffer_c() : m_capacity(0) { }
+
+    /**
+     * Allocate num_queue FIFOs of capacity entries each
+     */
+    void init(int num_queue, int capacity)
+    {
+      m_capacity = capacity;
+      m_slot.assign(num_queue * capacity, T());
+      m_head.assign(num_queue, 0);
+      m_count.assign(num_queue, 0);
+    }
+
+    /**
+     * Is queue q empty?
+     */
+    inline bool empty(int q) const { return m_count[q] == 0; }
+
+    /**
+     * Number of entries in queue q
+     */
+    inline int size(int q) const { return m_count[q]; }
+
+    /**
+     * Oldest entry of queue q
+     */
+    inline T front(int q) const { return m_slot[q * m_capacity + m_head[q]]; }
+
+    /**
+     * Append an entry to queue q. Return false if the queue is full.
+     */
+    inline bool push_back(int q, T entry)
+    {
+      if (m_count[q] == m_capacity)
+        return false;
+
+      int tail = m_head[q] + m_count[q];
+      if (tail >= m_capacity)
+        tail -= m_capacity;
+      m_slot[q * m_capacity + tail] = entry;
+      ++m_count[q];
+      return true;
+    }
+
+    /**
+     * Remove the oldest entry of queue q
+     */
+    inline void pop_front(int q)
+    {
+      if (++m_head[q] == m_capacity)
+        m_head[q] = 0;
+      --m_count[q];
+    }
+
+  private:
+    int m_capacity; /**< entries per queue */
+    vector<T> m_slot; /**< entries of all queues */
+    vector<int> m_head; /**< index of the oldest entry per queue */
+    vector<int> m_count; /**< number of entries per queue */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Router with flat-array buffers
+///
+/// Same pipeline, arbitration and routing as router_ring_c and router_mesh_c, but every
+/// virtual channel is a fixed-capacity ring of m_buffer_max_size flits and all per-vc state
+/// (route, output port/vc, credit) lives in contiguous arrays indexed by port * m_num_vc + vc.
+/// Credits are plain records in a per-router vector instead of pooled credit_c objects.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class router_flat_c : public router_c
+{
+  public:
+    /**
+     * Constructor
+     * @param dimension 1 : ring, 2 : mesh
+     */
+    router_flat_c(macsim_c* simBase, int type, int id, int dimension);
+
+    /**
+     * Destructor
+     */
+    ~router_flat_c();
+
+    /**
+     * Initialize the router
+     */
+    void init(int total_router, int* total_packet, pool_c<flit_c>* flit_pool, 
+        pool_c<credit_c>* credit_pool);
+
+    /**
+     * Run a cycle
+     */
+    void run_a_cycle(bool pll_lock);
+
+    /**
+     * Insert a packet from the network interface
+     */
+    bool inject_packet(mem_req_s* req);
+
+    /**
+     * Insert a flit from a neighbor router
+     */
+    void insert_packet(flit_c* flit, int port, int vc);
+
+    /**
+     * Return a credit from a neighbor router
+     */
+    void return_credit(int port, int vc, Counter rdy_cycle);
+
+    /**
+     * Check whether the router holds any packet or credit
+     */
+    bool is_idle(void);
+
+    /**
+     * Print link information
+     */
+    void print_link_info(void);
+
+    /**
+     * RC (Route Calculation) stage
+     */
+    void stage_rc(void);
+
+    /**
+     * VCA (Virtual Channel Allocation) stage
+     */
+    void stage_vca(void);
+
+    /**
+     * VC arbitration
+     */
+    void stage_vca_pick_winner(int oport, int ovc, int& iport, int& ivc);
+
+    /**
+     * SA (Switch Allocation) stage
+     */
+    void stage_sa(void);
+
+    /**
+     * Switch arbitration
+     */
+    void stage_sa_pick_winner(int op, int& ip, int& ivc, int sw_id);
+
+    /**
+     * ST (Switch Traversal) stage
+     */
+    void stage_st(void);
+
+    /**
+     * LT (Link Traversal) stage
+     */
+    void stage_lt(void);
+
+    /**
+     * Move packets from the injection buffer to the local input port
+     */
+    void local_packet_injection(void);
+
+    /**
+     * Apply credits whose latency has passed
+     */
+    void process_pending_credit(void);
+
+  private:
+    router_flat_c(); // do not implement
+
+    /**
+     * Return the neighbor router in direction dir
+     */
+    inline router_flat_c* link(int dir) { return static_cast<router_flat_c*>(m_link[dir]); }
+
+  private:
+    /**
+     * Returned credit
+     */
+    typedef struct credit_s {
+      Counter m_rdy_cycle; /**< credit ready cycle */
+      int m_port; /**< credit port */
+      int m_vc; /**< credit vc */
+    } credit_s;
+
+    int m_dimension; /**< 1 : ring, 2 : mesh */
+    int m_width; /**< mesh width */
+
+    ring_buffer_c<mem_req_s*> m_injection; /**< injection queue */
+
+    // per input port * vc
+    ring_buffer_c<flit_c*> m_ibuf; /**< input buffer */
+    vector<uns32> m_route_mask; /**< candidate output ports (bitmask), 2 per input vc */
+    vector<int> m_ivc_route; /**< determined output port (m_route_fixed) */
+    vector<int> m_ivc_oport; /**< output port id */
+    vector<int> m_ivc_ovc; /**< output vc id */
+
+    // per output port * vc
+    ring_buffer_c<flit_c*> m_obuf; /**< output buffer */
+    vector<uns8> m_ovc_avail; /**< output vc availability */
+    vector<int> m_ovc_credit; /**< credit counter for the flow control */
+
+    vector<credit_s> m_credit_queue; /**< credits in flight to this router */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Ring or mesh network of router_flat_c (noc_topology flat_ring / flat_mesh)
+///////////////////////////////////////////////////////////////////////////////////////////////
+class network_flat_c : public network_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    network_flat_c(macsim_c* simBase, int dimension);
+
+    /**
+     * Destructor
+     */
+    ~network_flat_c();
+
+    /**
+     * Initialize interconnection network
+     */
+    void init(int num_cpu, int num_gpu, int num_l3, int num_llc, int num_mc);
+
+    /**
+     * Run a cycle
+     */
+    void run_a_cycle(bool pll_lock);
+
+    /**
+     * Print all router information
+     */
+    void print(void);
+
+  private:
+    network_flat_c(); // do not implement
+
+  private:
+    int m_dimension; /**< 1 : ring, 2 : mesh */
+};
+
+#endif
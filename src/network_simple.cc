@@ -69,11 +69,7 @@ void network_simple_c::run_a_cycle(bool pll_lock)
   for (int ii = 0; ii < m_num_router; ++ii)
     m_router[ii]->reset();
 
-  // randomized tick function
-  int index = CYCLE % m_num_router;
-  for (int ii = index; ii < index + m_num_router; ++ii) {
-    m_router[ii % m_num_router]->run_a_cycle(pll_lock);
-  }
+  run_routers(pll_lock);
   ++m_cycle;
 }
 
@@ -169,6 +165,7 @@ void router_simple_c::process(void)
       
       // remove from the current buffer
       m_injection_buffer->erase(I_tmp);
+      --m_occupancy;
 
       // increment current injection count from src
       ++num_count;
@@ -182,6 +179,12 @@ int* router_simple_c::get_num_packet_inserted(void)
 }
 
 
+// router clock is not used in the simple network
+void router_simple_c::skip_cycles(Counter num_cycles)
+{
+}
+
+
 // dummy functions
 // wrong oop design - should be removed
 void router_simple_c::stage_rc(void)
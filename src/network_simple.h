@@ -57,6 +57,7 @@ class router_simple_c : public router_c
     virtual void stage_vca_pick_winner(int, int, int&, int&);
     virtual void reset(void);
     virtual int* get_num_packet_inserted(void);
+    virtual void skip_cycles(Counter);
 
   private:
     router_simple_c();
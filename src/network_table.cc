@@ -0,0 +1,354 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : network_table.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : 2D torus and concentrated mesh with table-driven routing
+ *********************************************************************************************/
+
+
+#include <fstream>
+#include <cmath>
+
+#include "network_table.h"
+#include "all_knobs.h"
+#include "all_stats.h"
+#include "utils.h"
+#include "debug_macros.h"
+#include "assert_macros.h"
+#include "memreq_info.h"
+
+
+#define DEBUG(args...) _DEBUG(*m_simBase->m_knobs->KNOB_DEBUG_NOC, ## args)
+
+
+extern int g_total_packet;
+extern int g_total_cpu_packet;
+extern int g_total_gpu_packet;
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+
+network_table_c::network_table_c(macsim_c* simBase, bool torus)
+  : network_c(simBase), m_torus(torus)
+{
+  m_topology      = torus ? "torus" : "cmesh";
+  m_concentration = torus ? 1 : *KNOB(KNOB_NOC_CONCENTRATION);
+  m_width         = 0;
+  m_num_node      = 0;
+
+  ASSERTM(m_concentration >= 1 && DOWN + m_concentration <= 32, 
+      "noc_concentration should be between 1 and %d\n", 32 - DOWN);
+}
+
+
+network_table_c::~network_table_c()
+{
+}
+
+
+// run one cycle for all routers
+void network_table_c::run_a_cycle(bool pll_lock)
+{
+  run_routers(pll_lock);
+  ++m_cycle;
+}
+
+
+#define CREATE_NODE(index, type, level, offset) \
+  for (int ii = 0; ii < index; ++ii) { \
+    m_router_map[level*1000+ii+offset] = m_num_node++; \
+    node_type.push_back(type); \
+  }
+
+
+void network_table_c::init(int num_cpu, int num_gpu, int num_l3, int num_llc, int num_mc)
+{
+  m_num_router = 0;
+  m_num_node = 0;
+  m_num_cpu = num_cpu;
+  m_num_gpu = num_gpu;
+  m_num_l3  = num_l3;
+  m_num_llc = num_llc;
+  m_num_mc  = num_mc;
+
+  // same node placement as network_mesh_c
+  vector<int> node_type;
+  CREATE_NODE(m_num_cpu, CPU_ROUTER, MEM_L2, 0);
+  CREATE_NODE(m_num_l3, L3_ROUTER, MEM_L3, 0);
+  CREATE_NODE(m_num_llc, LLC_ROUTER, MEM_LLC, 0);
+  CREATE_NODE(m_num_mc, MC_ROUTER, MEM_MC, 0);
+  CREATE_NODE(m_num_gpu, GPU_ROUTER, MEM_L2, m_num_cpu);
+
+  // routers in a square, padded with dummy routers
+  int num_used = (m_num_node + m_concentration - 1) / m_concentration;
+  m_width = sqrt(num_used);
+  if (m_width * m_width != num_used)
+    ++m_width;
+
+  for (; m_num_router < m_width * m_width; ++m_num_router) {
+    int node = m_num_router * m_concentration;
+    int type = (node < m_num_node) ? node_type[node] : 0;
+    if (node >= m_num_node)
+      report("router:" << m_num_router << " type:dummy created");
+
+    router_c* new_router = 
+      new router_table_c(m_simBase, type, m_num_router, m_concentration, m_topology);
+    m_router.push_back(new_router);
+  }
+
+  report("TOTAL_ROUTER:" << m_num_router << " TOTAL_NODE:" << m_num_node 
+      << " CPU:" << m_num_cpu << " GPU:" << m_num_gpu << " L3:" << m_num_l3 
+      << " LLC:" << m_num_llc << " MC:" << m_num_mc);
+
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    m_router[ii]->init(m_num_router, &g_total_packet, m_flit_pool, m_credit_pool);
+  }
+
+  // connect routers
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    int x = ii % m_width;
+    int y = ii / m_width;
+
+    if (y > 0)  // north link
+      m_router[ii]->set_link(UP, m_router[ii-m_width]);
+    else if (m_torus && m_width > 1)
+      m_router[ii]->set_link(UP, m_router[ii+(m_width-1)*m_width]);
+
+    if (y < m_width - 1)  // south link
+      m_router[ii]->set_link(DOWN, m_router[ii+m_width]);
+    else if (m_torus && m_width > 1)
+      m_router[ii]->set_link(DOWN, m_router[x]);
+
+    if (x > 0)  // west link
+      m_router[ii]->set_link(LEFT, m_router[ii-1]);
+    else if (m_torus && m_width > 1)
+      m_router[ii]->set_link(LEFT, m_router[ii+m_width-1]);
+
+    if (x < m_width - 1)  // east link
+      m_router[ii]->set_link(RIGHT, m_router[ii+1]);
+    else if (m_torus && m_width > 1)
+      m_router[ii]->set_link(RIGHT, m_router[y*m_width]);
+  }
+
+  // routing tables
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    router_table_c* router = static_cast<router_table_c*>(m_router[ii]);
+    vector<uns32> route_table(m_num_node * 2, 0);
+    int x_src = ii % m_width;
+    int y_src = ii / m_width;
+
+    for (int node = 0; node < m_num_node; ++node) {
+      int dst = node / m_concentration;
+      if (dst == ii) {
+        route_table[node*2]   = 1 << router->local_port(node % m_concentration);
+        route_table[node*2+1] = route_table[node*2];
+        continue;
+      }
+
+      int x_dst = dst % m_width;
+      int y_dst = dst / m_width;
+
+      // adaptive routing : productive port of each dimension
+      int x_port = route_dimension(x_src, x_dst, LEFT, RIGHT, m_torus);
+      int y_port = route_dimension(y_src, y_dst, UP, DOWN, m_torus);
+      if (x_port != -1)
+        route_table[node*2] |= 1 << x_port;
+      if (y_port != -1)
+        route_table[node*2] |= 1 << y_port;
+
+      // escape routing : XY without the wraparound links
+      x_port = route_dimension(x_src, x_dst, LEFT, RIGHT, false);
+      y_port = route_dimension(y_src, y_dst, UP, DOWN, false);
+      route_table[node*2+1] = 1 << (x_port != -1 ? x_port : y_port);
+    }
+
+    router->set_route_table(route_table);
+  }
+
+  m_router[0]->print_link_info();
+}
+
+
+int network_table_c::route_dimension(int src, int dst, int dec, int inc, bool wrap)
+{
+  if (src == dst)
+    return -1;
+
+  if (!wrap)
+    return (src > dst) ? dec : inc;
+
+  // shorter way around the ring of this dimension
+  int forward = (dst - src + m_width) % m_width;
+  return (forward <= m_width - forward) ? inc : dec;
+}
+
+
+bool network_table_c::send(mem_req_s* req, int src_level, int src_id, int dst_level, 
+    int dst_id)
+{
+  req->m_msg_src = m_router_map[src_level*1000+src_id];
+  req->m_msg_dst = m_router_map[dst_level*1000+dst_id]; 
+
+  DEBUG("src_level:%d src_id:%d (%d)  dst_level:%d dst_id:%d (%d)\n",
+      src_level, src_id, req->m_msg_src, dst_level, dst_id, req->m_msg_dst);
+
+  m_active = true;
+  return m_router[req->m_msg_src / m_concentration]->inject_packet(req, 
+      req->m_msg_src % m_concentration);
+}
+
+
+mem_req_s* network_table_c::receive(int level, int id)
+{
+  int node = m_router_map[level*1000+id];
+  return m_router[node / m_concentration]->receive_req(node % m_concentration);
+}
+
+
+void network_table_c::receive_pop(int level, int id)
+{
+  int node = m_router_map[level*1000+id];
+  m_router[node / m_concentration]->pop_req(node % m_concentration);
+}
+
+
+void network_table_c::print(void)
+{
+  ofstream out("router.out");
+  out << "total_packet:" << m_total_packet << "\n";
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    m_router[ii]->print(out);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+
+// constructor
+router_table_c::router_table_c(macsim_c* simBase, int type, int id, int num_local, 
+    const string& topology)
+  : router_c(simBase, type, id, DOWN + num_local, num_local)
+{
+  // configurations
+  m_topology = topology;
+  assert(m_num_vc >= 2);
+}
+
+
+// destructor
+router_table_c::~router_table_c()
+{
+}
+
+
+void router_table_c::set_route_table(const vector<uns32>& route_table)
+{
+  m_route_table = route_table;
+}
+
+
+void router_table_c::stage_rc(void)
+{
+  for (int port = 0; port < m_num_port; ++port) {
+    for (int vc = 0; vc < m_num_vc; ++vc) {
+      if (m_input_buffer[port][vc].empty())
+        continue;
+
+      flit_c* flit = m_input_buffer[port][vc].front();
+      if (flit->m_head == true && flit->m_state == IB && flit->m_rdy_cycle <= m_cycle) {
+        uns32 adaptive = m_route_table[flit->m_dst * 2];
+        uns32 escape   = m_route_table[flit->m_dst * 2 + 1];
+        for (int ii = 0; ii < m_num_port; ++ii) {
+          m_route[port][vc][0][ii] = (adaptive >> ii) & 1;
+          m_route[port][vc][1][ii] = (escape >> ii) & 1;
+        }
+
+        flit->m_state = RC;
+        DEBUG("cycle:%-10lld node:%d [RC] req_id:%d flit_id:%d src:%d dst:%d ip:%d vc:%d\n",
+            m_cycle, m_id, flit->m_req->m_id, flit->m_id, flit->m_req->m_msg_src, 
+            flit->m_req->m_msg_dst, port, vc);
+      }
+    }
+  }
+}
+
+
+// same as router_mesh_c : the last vc is the escape vc
+void router_table_c::stage_vca_pick_winner(int oport, int ovc, int& iport, int& ivc)
+{
+  int rc_index = ovc / (m_num_vc - 1);
+
+  // Oldest-first arbitration
+  if (m_arbitration_policy == OLDEST_FIRST) {
+    // search all input ports for the winner
+    Counter oldest_timestamp = ULLONG_MAX;
+    iport = -1;
+    for (int ii = 0; ii < m_num_port; ++ii) {
+      if (ii == oport)
+        continue;
+
+      for (int jj = 0; jj < m_num_vc; ++jj) {
+        if (m_input_buffer[ii][jj].empty() || !m_route[ii][jj][rc_index][oport])
+          continue;
+
+        flit_c* flit = m_input_buffer[ii][jj].front();
+
+        // header && RC stage && oldest
+        if (flit->m_head == true && flit->m_state == RC && flit->m_timestamp < oldest_timestamp) {
+          oldest_timestamp = flit->m_timestamp;
+          iport = ii;
+          ivc   = jj;
+        }
+      }
+    }
+  }
+  else
+    assert(0);
+}
+
+
+void router_table_c::print_link_info(void)
+{
+  report(m_topology << " topology");
+  static const char* dir_name[] = {"local", "left", "right", "up", "down"};
+  cout << m_id << " :";
+  for (int dir = LEFT; dir <= DOWN; ++dir) {
+    if (m_link[dir] != NULL)
+      cout << " " << dir_name[dir] << ":" << m_link[dir]->get_id();
+  }
+  cout << " local ports:" << m_num_local << "\n";
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,168 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : network_table.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : 2D torus and concentrated mesh with table-driven routing
+ *********************************************************************************************/
+
+
+#ifndef NETWORK_TABLE_H
+#define NETWORK_TABLE_H
+
+
+#include <vector>
+
+#include "macsim.h"
+#include "network.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Router with a precomputed routing table
+///
+/// The network fills a table with the candidate output ports (bitmask) of every destination
+/// node, so RC is a lookup instead of per-flit coordinate arithmetic. As in router_mesh_c,
+/// class 0 holds the minimal adaptive ports and class 1 the escape port used by the last vc.
+/// A router has 4 direction ports and noc_concentration local ports (LOCAL, then after DOWN).
+///////////////////////////////////////////////////////////////////////////////////////////////
+class router_table_c : public router_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    router_table_c(macsim_c* simBase, int type, int id, int num_local, const string& topology);
+
+    /**
+     * Destructor
+     */
+    ~router_table_c();
+
+    /**
+     * Set the routing table : 2 port masks (adaptive, escape) per destination node
+     */
+    void set_route_table(const vector<uns32>& route_table);
+
+    /**
+     * Print link information
+     */
+    void print_link_info();
+
+    /**
+     * RC (Route Calculation) stage
+     */
+    void stage_rc(void);
+
+    /**
+     * VC arbitration
+     */
+    void stage_vca_pick_winner(int, int, int&, int&);
+
+  private:
+    router_table_c(); // do not implement
+
+  private:
+    vector<uns32> m_route_table; /**< output port masks, 2 per destination node */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief 2D torus (noc_topology torus) or concentrated mesh (noc_topology cmesh)
+///
+/// Nodes are placed in the mesh order, noc_concentration nodes per router in cmesh, and the
+/// routers form a square (padded with dummy routers). The torus adds wraparound links; its
+/// adaptive routes take the shorter way around each dimension while the escape routes stay
+/// XY on the mesh links, so the escape network has no cyclic dependency.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class network_table_c : public network_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    network_table_c(macsim_c* simBase, bool torus);
+
+    /**
+     * Destructor
+     */
+    ~network_table_c();
+
+    /**
+     * Initialize interconnection network
+     */
+    void init(int num_cpu, int num_gpu, int num_l3, int num_llc, int num_mc);
+
+    /**
+     * Send a packet from the local port of the source node
+     */
+    bool send(mem_req_s* req, int src_level, int src_id, int dst_level, int dst_id);
+
+    /**
+     * Get a packet ejected at the local port of a node
+     */
+    mem_req_s* receive(int level, int id);
+
+    /**
+     * Remove a packet ejected at the local port of a node
+     */
+    void receive_pop(int level, int id);
+
+    /**
+     * Run a cycle
+     */
+    void run_a_cycle(bool pll_lock);
+
+    /**
+     * Print all router information
+     */
+    void print(void);
+
+  private:
+    network_table_c(); // do not implement
+
+    /**
+     * Output port toward the destination along one dimension (-1 if aligned)
+     * @param src source coordinate
+     * @param dst destination coordinate
+     * @param dec port decreasing the coordinate
+     * @param inc port increasing the coordinate
+     * @param wrap use the wraparound links
+     */
+    int route_dimension(int src, int dst, int dec, int inc, bool wrap);
+
+  private:
+    bool m_torus; /**< torus (true) or concentrated mesh */
+    int m_concentration; /**< nodes per router */
+    int m_width; /**< routers per row */
+    int m_num_node; /**< number of nodes */
+};
+
+#endif
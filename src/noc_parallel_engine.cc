@@ -0,0 +1,311 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : noc_parallel_engine.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : multi-threaded router stepping
+ *********************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "noc_parallel_engine.h"
+#include "network.h"
+#include "statistics.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+#include "utils.h"
+
+#include "all_knobs.h"
+
+
+thread_local int noc_parallel_engine_c::m_cur_partition = -1;
+
+
+// spin on a condition, yielding the host cpu after a short while
+#define SPIN_UNTIL(cond)                    \
+  do {                                      \
+    int spin_count = 0;                     \
+    while (!(cond)) {                       \
+      if (++spin_count > 128)               \
+        this_thread::yield();               \
+    }                                       \
+  } while (0)
+
+
+// mailboxes per router : one per direction port (LOCAL unused)
+#define NUM_MAIL_PORT 5
+
+
+noc_parallel_engine_c::noc_parallel_engine_c(macsim_c* simBase, deque<router_c*>& router,
+    int num_threads)
+  : m_simBase(simBase), m_router(router)
+{
+  m_num_router   = m_router.size();
+  m_step         = 0;
+  m_start        = 0;
+  m_phase        = 0;
+  m_num_finished = 0;
+  m_shutdown     = false;
+
+  // column bands : a router depends on its left and upper neighbors in most cycles, so
+  // bands overlap row by row
+  int width = sqrt(m_num_router);
+  m_num_threads = MIN2(num_threads, width);
+
+  m_partition.resize(m_num_router);
+  m_partition_router.resize(m_num_threads);
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    ASSERT(m_router[ii]->get_id() == ii);
+    m_partition[ii] = (ii % width) * m_num_threads / width;
+    m_partition_router[m_partition[ii]].push_back(ii);
+  }
+
+  m_remote_neighbor.resize(m_num_router);
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    for (int dir = LEFT; dir <= DOWN; ++dir) {
+      router_c* neighbor = m_router[ii]->get_router(dir);
+      if (neighbor != NULL && m_partition[neighbor->get_id()] != m_partition[ii])
+        m_remote_neighbor[ii].push_back(neighbor->get_id());
+    }
+  }
+
+  for (int ii = 0; ii < 2; ++ii)
+    m_mail[ii].resize(m_num_router * NUM_MAIL_PORT);
+
+  m_ticked.reset(new atomic<Counter>[m_num_router]);
+  for (int ii = 0; ii < m_num_router; ++ii)
+    m_ticked[ii] = 0;
+
+  for (int ii = 0; ii < m_num_router; ++ii)
+    m_router[ii]->set_parallel(this);
+
+  // stat counter block per host thread (the main thread swaps its block in per cycle)
+  for (int ii = 0; ii < m_num_threads; ++ii)
+    m_stat_shard.push_back(AbstractStat::newShard());
+
+  for (int ii = 1; ii < m_num_threads; ++ii)
+    m_workers.push_back(thread(&noc_parallel_engine_c::worker, this, ii));
+
+  report("parallel noc : " << m_num_threads << " host threads, " << m_num_router 
+      << " routers");
+}
+
+
+noc_parallel_engine_c::~noc_parallel_engine_c()
+{
+  m_shutdown = true;
+  ++m_phase;
+  for (auto itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    itr->join();
+
+  for (auto itr = m_stat_shard.begin(); itr != m_stat_shard.end(); ++itr)
+    AbstractStat::deleteShard(*itr);
+}
+
+
+// networks of router_c with a square layout
+bool noc_parallel_engine_c::is_supported(macsim_c* simBase, int num_router)
+{
+  macsim_c* m_simBase = simBase;
+  string reason;
+
+  string topology = KNOB(KNOB_NOC_TOPOLOGY)->getValue();
+  int width = sqrt(num_router);
+  if (topology != "mesh" && topology != "torus" && topology != "cmesh")
+    reason = "noc_topology " + topology;
+  else if (width < 2)
+    reason = "single router column";
+  else if (*KNOB(KNOB_DEBUG_NOC))
+    reason = "debug_noc";
+
+  if (reason != "") {
+    report("parallel noc disabled : " << reason);
+    return false;
+  }
+
+  return true;
+}
+
+
+bool noc_parallel_engine_c::run_a_cycle(int start, bool pll_lock)
+{
+  if (pll_lock) {
+    bool active = false;
+    for (int ii = 0; ii < m_num_router; ++ii) {
+      if (m_router[ii]->is_active())
+        m_router[ii]->run_a_cycle(true);
+      else
+        m_router[ii]->skip_inactive_cycle();
+
+      if (m_router[ii]->is_active() || has_mail(ii, m_step & 1))
+        active = true;
+    }
+    return active;
+  }
+
+  ++m_step;
+  m_start = start;
+
+  unsigned long long* main_shard = AbstractStat::m_shard;
+  AbstractStat::m_shard = m_stat_shard[0];
+  AbstractStat::m_sharded = true;
+
+  m_num_finished = 0;
+  ++m_phase;
+
+  run_partition(0);
+  SPIN_UNTIL(m_num_finished == m_num_threads - 1);
+
+  AbstractStat::m_sharded = false;
+  AbstractStat::m_shard = main_shard;
+
+  // packet count samples in serial order
+  bool active = false;
+  for (int ii = 0; ii < m_num_router; ++ii) {
+    int id = (start + ii) % m_num_router;
+    m_router[id]->replay_packet_count();
+    if (m_router[id]->is_active() || has_mail(id, m_step & 1))
+      active = true;
+  }
+
+  return active;
+}
+
+
+void noc_parallel_engine_c::worker(int tid)
+{
+  AbstractStat::m_shard = m_stat_shard[tid];
+
+  unsigned phase = 0;
+  while (true) {
+    SPIN_UNTIL(m_phase != phase);
+    phase = m_phase;
+
+    if (m_shutdown)
+      break;
+
+    run_partition(tid);
+    ++m_num_finished;
+  }
+}
+
+
+void noc_parallel_engine_c::run_partition(int tid)
+{
+  m_cur_partition = tid;
+  int parity = m_step & 1;
+  vector<int>& routers = m_partition_router[tid];
+  int num = routers.size();
+
+  // mail sent in the last cycle after the router ticked
+  for (int ii = 0; ii < num; ++ii)
+    deliver(routers[ii], !parity);
+
+  // serial order : routers from m_start, then the ones before it
+  int first = lower_bound(routers.begin(), routers.end(), m_start) - routers.begin();
+  for (int ii = 0; ii < num; ++ii) {
+    int id = routers[(first + ii) % num];
+
+    // earlier neighbors in other partitions may send flits or credits to this router
+    int my_rank = rank(id);
+    for (auto itr = m_remote_neighbor[id].begin(); itr != m_remote_neighbor[id].end(); ++itr) {
+      if (rank(*itr) < my_rank)
+        SPIN_UNTIL(m_ticked[*itr].load(memory_order_acquire) == m_step);
+    }
+    deliver(id, parity);
+
+    router_c* router = m_router[id];
+    if (router->is_active())
+      router->run_a_cycle(false);
+    else
+      router->skip_inactive_cycle();
+
+    m_ticked[id].store(m_step, memory_order_release);
+  }
+
+  if (tid == 0)
+    m_cur_partition = -1;
+}
+
+
+bool noc_parallel_engine_c::post_flit(int router, flit_c* flit, int port, int vc)
+{
+  if (m_cur_partition == -1 || m_partition[router] == m_cur_partition)
+    return false;
+
+  ASSERT(port > LOCAL && port < NUM_MAIL_PORT);
+  mail_s mail = {flit, NULL, port, vc};
+  m_mail[m_step & 1][router * NUM_MAIL_PORT + port].push_back(mail);
+  return true;
+}
+
+
+bool noc_parallel_engine_c::post_credit(int router, credit_c* credit)
+{
+  if (m_cur_partition == -1 || m_partition[router] == m_cur_partition)
+    return false;
+
+  // credits for a port come from the neighbor on that port
+  ASSERT(credit->m_port > LOCAL && credit->m_port < NUM_MAIL_PORT);
+  mail_s mail = {NULL, credit, credit->m_port, -1};
+  m_mail[m_step & 1][router * NUM_MAIL_PORT + credit->m_port].push_back(mail);
+  return true;
+}
+
+
+void noc_parallel_engine_c::deliver(int router, int parity)
+{
+  for (int port = 0; port < NUM_MAIL_PORT; ++port) {
+    vector<mail_s>& mail = m_mail[parity][router * NUM_MAIL_PORT + port];
+    if (mail.empty())
+      continue;
+
+    for (auto itr = mail.begin(); itr != mail.end(); ++itr) {
+      if (itr->m_flit != NULL)
+        m_router[router]->insert_packet(itr->m_flit, itr->m_port, itr->m_vc);
+      else
+        m_router[router]->insert_credit(itr->m_credit);
+    }
+    mail.clear();
+  }
+}
+
+
+bool noc_parallel_engine_c::has_mail(int router, int parity)
+{
+  for (int port = 0; port < NUM_MAIL_PORT; ++port) {
+    if (!m_mail[parity][router * NUM_MAIL_PORT + port].empty())
+      return true;
+  }
+  return false;
+}
@@ -0,0 +1,171 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : noc_parallel_engine.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : multi-threaded router stepping
+ *********************************************************************************************/
+
+#ifndef NOC_PARALLEL_ENGINE_H_INCLUDED
+#define NOC_PARALLEL_ENGINE_H_INCLUDED
+
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "global_defs.h"
+#include "global_types.h"
+
+
+class router_c;
+class flit_c;
+class credit_c;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Multi-threaded router stepping engine
+///
+/// Routers of a square network (mesh, torus, cmesh) are partitioned into column bands, one
+/// per host thread. In a NoC cycle, routers tick in the rotating serial order of
+/// network_c::run_routers; a router may see flits and credits sent in the same cycle by a
+/// neighbor that ticked before it. Each host thread therefore runs its routers in serial
+/// order, and a router waits until its earlier neighbors in other partitions have ticked.
+/// Rows of adjacent bands overlap like a pipeline.
+///
+/// Flits and credits sent to a router of another partition go to its mailbox (per input
+/// port, so each has one producer), double-buffered by cycle parity. Mail sent before the
+/// router ticks is delivered right before its tick; mail sent after its tick stays in the
+/// buffer of the cycle and is delivered at the start of the next cycle, while the other
+/// buffer collects the new cycle's mail. Packet count samples are replayed in serial order
+/// at the end of the cycle, so all results are identical to serial stepping.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class noc_parallel_engine_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    noc_parallel_engine_c(macsim_c* simBase, deque<router_c*>& router, int num_threads);
+
+    /**
+     * Destructor
+     */
+    ~noc_parallel_engine_c();
+
+    /**
+     * Check whether the routers of the network can be stepped in parallel
+     */
+    static bool is_supported(macsim_c* simBase, int num_router);
+
+    /**
+     * Tick all routers, starting from the router first in the serial order
+     * @return any router active after the cycle
+     */
+    bool run_a_cycle(int start, bool pll_lock);
+
+    /**
+     * Put a flit into the mailbox of a router owned by another host thread
+     * @return false if the current host thread owns the router
+     */
+    bool post_flit(int router, flit_c* flit, int port, int vc);
+
+    /**
+     * Put a credit into the mailbox of a router owned by another host thread
+     * @return false if the current host thread owns the router
+     */
+    bool post_credit(int router, credit_c* credit);
+
+  private:
+    noc_parallel_engine_c(); // do not implement
+
+    /**
+     * Mail to a router
+     */
+    typedef struct mail_s {
+      flit_c*   m_flit; /**< flit (NULL for a credit) */
+      credit_c* m_credit; /**< credit */
+      int       m_port; /**< input port of a flit */
+      int       m_vc; /**< input vc of a flit */
+    } mail_s;
+
+    /**
+     * Worker thread main loop
+     */
+    void worker(int tid);
+
+    /**
+     * Tick the routers of a partition
+     */
+    void run_partition(int tid);
+
+    /**
+     * Deliver the mail of a router in a buffer
+     */
+    void deliver(int router, int parity);
+
+    /**
+     * Is there undelivered mail for a router in a buffer?
+     */
+    bool has_mail(int router, int parity);
+
+    /**
+     * Position of a router in the serial order of the current cycle
+     */
+    inline int rank(int router) const 
+    { 
+      return (router - m_start + m_num_router) % m_num_router; 
+    }
+
+  private:
+    macsim_c*                     m_simBase; /**< macsim_c base class for simulation globals */
+    deque<router_c*>&             m_router; /**< all routers */
+    int                           m_num_router; /**< number of routers */
+    int                           m_num_threads; /**< number of host threads (incl. main) */
+    vector<thread>                m_workers; /**< worker threads */
+    vector<int>                   m_partition; /**< partition (host thread) per router */
+    vector<vector<int>>           m_partition_router; /**< routers per partition (id order) */
+    vector<vector<int>>           m_remote_neighbor; /**< neighbors in other partitions */
+    vector<vector<mail_s>>        m_mail[2]; /**< mail per parity, router * 5 + input port */
+    unique_ptr<atomic<Counter>[]> m_ticked; /**< last step in which a router ticked */
+    Counter                       m_step; /**< parallel steps run */
+    int                           m_start; /**< first router in the serial order */
+    atomic<unsigned>              m_phase; /**< phase generation */
+    atomic<int>                   m_num_finished; /**< workers done with the phase */
+    atomic<bool>                  m_shutdown; /**< terminate worker threads */
+    vector<unsigned long long*>   m_stat_shard; /**< stat counter block per host thread */
+
+    static thread_local int       m_cur_partition; /**< partition run by this host thread */
+};
+
+#endif
@@ -36,6 +36,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <list>
 #include "page_mapping.h"
+#include "checkpoint.h"
 
 /* macsim */
 #include "statistics.h"
@@ -44,6 +45,36 @@ POSSIBILITY OF SUCH DAMAGE.
 
 using namespace std;
 
+// save or restore a page/region table
+static void checkpoint_table(checkpoint_c* ckpt, map<uint64_t, uint64_t>& table)
+{
+  uint64_t num_entries = table.size();
+  ckpt->io(num_entries);
+
+  if (ckpt->is_saving()) {
+    for (auto it = table.begin(); it != table.end(); ++it) {
+      uint64_t key = it->first;
+      ckpt->io(key);
+      ckpt->io(it->second);
+    }
+  }
+  else {
+    table.clear();
+    for (uint64_t ii = 0; ii < num_entries; ++ii) {
+      uint64_t key, value;
+      ckpt->io(key);
+      ckpt->io(value);
+      table[key] = value;
+    }
+  }
+}
+
+void PageMapper::checkpoint(checkpoint_c* ckpt)
+{
+  ckpt->io(m_physical_tag);
+  checkpoint_table(ckpt, m_page_table);
+}
+
 //////////////////////////////////////////////////////////////////////
 // First-Come-First-Serve Page Mapper
 //////////////////////////////////////////////////////////////////////
@@ -155,3 +186,9 @@ uint64_t RegionBasedFCFSPageMapper::translate(uint64_t virtual_address)
     return physical_address;
   }
 }
+
+void RegionBasedFCFSPageMapper::checkpoint(checkpoint_c* ckpt)
+{
+  PageMapper::checkpoint(ckpt);
+  checkpoint_table(ckpt, m_region_table);
+}
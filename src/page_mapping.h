@@ -46,6 +46,7 @@ class PageMapper
   public:
     virtual ~PageMapper() {}
     virtual uint64_t translate(uint64_t virtual_address) = 0;
+    virtual void checkpoint(checkpoint_c* ckpt);   //!< save or restore the page table
     uint64_t getNumPhysicalPages() { return m_page_table.size(); }  //!< get the number of physical pages allocated
 
   protected:
@@ -85,6 +86,7 @@ class RegionBasedFCFSPageMapper : public PageMapper
   public:
     uint64_t getNumPhysicalRegions() { return m_region_table.size(); }  //!< get the number of physical regions allocated
     uint64_t translate(uint64_t virtual_address);   //!< provide physical translation for virtual address
+    void checkpoint(checkpoint_c* ckpt);            //!< save or restore the page and region tables
 
   private:
     std::map<uint64_t, uint64_t> m_region_table;    //!< region mapping table
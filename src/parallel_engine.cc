@@ -0,0 +1,321 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : parallel_engine.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : multi-threaded core stepping
+ *********************************************************************************************/
+
+#include <iostream>
+#include <string>
+
+#include "parallel_engine.h"
+#include "macsim.h"
+#include "memory.h"
+#include "statistics.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+#include "utils.h"
+
+#include "all_knobs.h"
+
+
+parallel_engine_c* parallel_engine_c::m_active = NULL;
+thread_local int parallel_engine_c::m_cur_item = -1;
+thread_local bool parallel_engine_c::m_cur_ordered = false;
+mutex parallel_engine_c::m_decode_mutex;
+
+
+// spin on a condition, yielding the host cpu after a short while
+#define SPIN_UNTIL(cond)                    \
+  do {                                      \
+    int spin_count = 0;                     \
+    while (!(cond)) {                       \
+      if (++spin_count > 128)               \
+        this_thread::yield();               \
+    }                                       \
+  } while (0)
+
+
+parallel_engine_c::parallel_engine_c(macsim_c* simBase, int num_threads)
+  : m_simBase(simBase), m_num_threads(num_threads)
+{
+  m_done_size       = 0;
+  m_num_items       = 0;
+  m_first_exclusive = 0;
+  m_deferring       = false;
+  m_done_prefix     = 0;
+  m_phase           = 0;
+  m_num_finished    = 0;
+  m_shutdown        = false;
+
+  m_thread_items.resize(m_num_threads);
+
+  // stat counter block per host thread
+  for (int ii = 0; ii < m_num_threads; ++ii)
+    m_stat_shard.push_back(AbstractStat::newShard());
+
+  // the main thread is host thread 0
+  AbstractStat::m_shard = m_stat_shard[0];
+  for (int ii = 1; ii < m_num_threads; ++ii)
+    m_workers.push_back(thread(&parallel_engine_c::worker, this, ii));
+
+  report("parallel simulation : " << m_num_threads << " host threads, quantum "
+      << *KNOB(KNOB_PARALLEL_QUANTUM));
+}
+
+
+parallel_engine_c::~parallel_engine_c()
+{
+  m_shutdown = true;
+  ++m_phase;
+  for (auto itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    itr->join();
+
+  AbstractStat::m_shard = NULL;
+  for (auto itr = m_stat_shard.begin(); itr != m_stat_shard.end(); ++itr)
+    AbstractStat::deleteShard(*itr);
+}
+
+
+// configurations in which a core touches another core's state outside the memory system
+bool parallel_engine_c::is_supported(macsim_c* simBase)
+{
+  macsim_c* m_simBase = simBase;
+  string reason;
+
+  string mem_type = KNOB(KNOB_MEMORY_TYPE)->getValue();
+  if (mem_type != "llc_decoupled_network" && mem_type != "l2_decoupled_network")
+    reason = "memory_type " + mem_type + " couples private caches to the llc";
+  else if (!*KNOB(KNOB_ENABLE_NEW_NOC))
+    reason = "enable_new_noc is off";
+  else if (*KNOB(KNOB_ENABLE_PHYSICAL_MAPPING))
+    reason = "enable_physical_mapping shares the mmu";
+  else if (*KNOB(KNOB_ENABLE_CACHE_COHERENCE))
+    reason = "enable_cache_coherence";
+  else if (*KNOB(KNOB_BUG_DETECTOR_ENABLE))
+    reason = "bug_detector_enable";
+  else if (*KNOB(KNOB_ENABLE_CONDITIONAL_EXECUTION))
+    reason = "enable_conditional_execution";
+  else if (*KNOB(KNOB_ENABLE_HMC_INST) || *KNOB(KNOB_ENABLE_HMC_TRANS))
+    reason = "hmc instructions";
+  else if (*KNOB(KNOB_DEBUG_PRINT_TRACE))
+    reason = "debug_print_trace";
+#if defined(USING_SST) || defined(IRIS)
+  reason = "external simulation framework";
+#endif
+#ifdef USING_QSIM
+  reason = "qsim trace generation";
+#endif
+
+  if (reason != "") {
+    report("parallel simulation disabled : " << reason);
+    return false;
+  }
+
+  return true;
+}
+
+
+void parallel_engine_c::begin_phase(bool deferring)
+{
+  m_num_items       = 0;
+  m_first_exclusive = -1;
+  m_deferring       = deferring;
+}
+
+
+void parallel_engine_c::add_item(int core_id, Counter cycle, bool pll_locked, bool exclusive)
+{
+  if (m_num_items == static_cast<int>(m_items.size()))
+    m_items.resize(m_num_items + 1);
+
+  parallel_item_s* item = &m_items[m_num_items];
+  item->m_core_id    = core_id;
+  item->m_cycle      = cycle;
+  item->m_pll_locked = pll_locked;
+  item->m_exclusive  = exclusive;
+  item->m_running    = false;
+  item->m_deferred.clear();
+
+  // everything after an exclusive tick is serialized, since the process manager may
+  // have changed the state of the cores that follow
+  if (exclusive && m_first_exclusive == -1)
+    m_first_exclusive = m_num_items;
+
+  ++m_num_items;
+}
+
+
+void parallel_engine_c::run_phase(void)
+{
+  if (m_num_items == 0)
+    return;
+
+  if (m_done_size < m_num_items) {
+    m_done_size = m_num_items * 2;
+    m_done.reset(new atomic<bool>[m_done_size]);
+  }
+
+  for (int ii = 0; ii < m_num_items; ++ii)
+    m_done[ii] = false;
+  m_done_prefix = 0;
+
+  // ticks of a core stay on the same host thread, in rank order
+  for (int ii = 0; ii < m_num_threads; ++ii)
+    m_thread_items[ii].clear();
+  for (int ii = 0; ii < m_num_items; ++ii)
+    m_thread_items[m_items[ii].m_core_id % m_num_threads].push_back(ii);
+
+  m_active = this;
+  AbstractStat::m_sharded = true;
+
+  m_num_finished = 0;
+  ++m_phase;
+
+  run_items(0);
+  SPIN_UNTIL(m_num_finished == m_num_threads - 1);
+
+  AbstractStat::m_sharded = false;
+  m_active = NULL;
+}
+
+
+void parallel_engine_c::worker(int tid)
+{
+  AbstractStat::m_shard = m_stat_shard[tid];
+
+  unsigned phase = 0;
+  while (true) {
+    SPIN_UNTIL(m_phase != phase);
+    phase = m_phase;
+
+    if (m_shutdown)
+      break;
+
+    run_items(tid);
+    ++m_num_finished;
+  }
+}
+
+
+void parallel_engine_c::run_items(int tid)
+{
+  for (auto itr = m_thread_items[tid].begin(); itr != m_thread_items[tid].end(); ++itr) {
+    int rank = *itr;
+    parallel_item_s* item = &m_items[rank];
+
+    m_cur_item    = rank;
+    m_cur_ordered = false;
+
+    // other cores may merge into outstanding requests of this core
+    if ((m_first_exclusive != -1 && rank >= m_first_exclusive) ||
+        m_simBase->m_memory->has_outstanding_req(item->m_core_id)) {
+      order();
+    }
+
+    item->m_running = m_simBase->run_core_cycle(item->m_core_id, item->m_pll_locked,
+        item->m_cycle);
+
+    m_cur_item = -1;
+    mark_done(rank);
+  }
+}
+
+
+void parallel_engine_c::wait_for(int rank)
+{
+  SPIN_UNTIL(m_done_prefix >= rank);
+}
+
+
+void parallel_engine_c::mark_done(int rank)
+{
+  m_done[rank] = true;
+
+  // advance the completed prefix as far as possible
+  int prefix = m_done_prefix;
+  while (prefix < m_num_items && m_done[prefix]) {
+    int next = prefix + 1;
+    if (m_done_prefix.compare_exchange_weak(prefix, next))
+      prefix = next;
+  }
+}
+
+
+void parallel_engine_c::order(void)
+{
+  if (m_active == NULL || m_cur_item == -1 || m_cur_ordered)
+    return;
+
+  m_active->wait_for(m_cur_item);
+  m_cur_ordered = true;
+}
+
+
+bool parallel_engine_c::is_deferring(void)
+{
+  return m_active != NULL && m_active->m_deferring;
+}
+
+
+void parallel_engine_c::defer(function<void (void)> action)
+{
+  macsim_c* m_simBase = m_active->m_simBase;
+  ASSERT(m_cur_item != -1);
+  m_active->m_items[m_cur_item].m_deferred.push_back(action);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+decode_lock_c::decode_lock_c(hash_c<inst_info_s>* htable, Addr key)
+{
+  m_locked = htable != NULL && parallel_engine_c::is_active();
+  if (!m_locked)
+    return;
+
+  parallel_engine_c::m_decode_mutex.lock();
+  if (htable->hash_table_access(key) == NULL) {
+    // a new instruction : decode it in serial order
+    parallel_engine_c::m_decode_mutex.unlock();
+    parallel_engine_c::order();
+    parallel_engine_c::m_decode_mutex.lock();
+  }
+}
+
+
+decode_lock_c::~decode_lock_c()
+{
+  if (m_locked)
+    parallel_engine_c::m_decode_mutex.unlock();
+}
@@ -0,0 +1,216 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : parallel_engine.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : multi-threaded core stepping
+ *********************************************************************************************/
+
+#ifndef PARALLEL_ENGINE_H_INCLUDED
+#define PARALLEL_ENGINE_H_INCLUDED
+
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "global_defs.h"
+#include "global_types.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief One core cycle scheduled in a parallel phase
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct parallel_item_s {
+  int     m_core_id; /**< core id */
+  Counter m_cycle; /**< global simulation cycle of this core tick */
+  bool    m_pll_locked; /**< pll lock state of the cycle */
+  bool    m_exclusive; /**< run with no other core in flight */
+  bool    m_running; /**< core executed a pipeline cycle */
+  vector<function<void (void)>> m_deferred; /**< global actions deferred to the phase end */
+} parallel_item_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Multi-threaded core stepping engine
+///
+/// Core ticks of one or more global cycles are collected in serial (pivot) order and
+/// distributed to host threads; the uncore is stepped by the main thread between phases.
+/// Each tick owns a rank in the serial order. Cores only touch private state until they
+/// reach a shared structure (MSHRs, memory request pools, decoded instruction table);
+/// order() then blocks the tick until all lower-ranked ticks have completed, so every
+/// shared access happens in the same order as in serial simulation. A core with
+/// outstanding MSHR entries is ordered from the start of its tick, since other cores may
+/// merge into (and complete) its requests. Ticks that may call the process manager are
+/// run exclusively, or their process manager calls are deferred to the end of a
+/// multi-cycle quantum.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class parallel_engine_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    parallel_engine_c(macsim_c* simBase, int num_threads);
+
+    /**
+     * Destructor
+     */
+    ~parallel_engine_c();
+
+    /**
+     * Check whether the current configuration can be stepped in parallel
+     */
+    static bool is_supported(macsim_c* simBase);
+
+    /**
+     * Start collecting core ticks for a new phase
+     * @param deferring - defer process manager calls to the end of the phase
+     */
+    void begin_phase(bool deferring);
+
+    /**
+     * Add a core tick (in serial order) to the current phase
+     */
+    void add_item(int core_id, Counter cycle, bool pll_locked, bool exclusive);
+
+    /**
+     * Run all collected core ticks and wait for their completion
+     */
+    void run_phase(void);
+
+    /**
+     * Get the number of core ticks of the last phase
+     */
+    int get_num_items(void) { return m_num_items; }
+
+    /**
+     * Get a core tick of the last phase
+     */
+    parallel_item_s* get_item(int index) { return &m_items[index]; }
+
+    /**
+     * Wait until all preceding core ticks of the current phase have completed.
+     * No-op outside parallel phases.
+     */
+    static void order(void);
+
+    /**
+     * Check whether process manager calls must be deferred
+     */
+    static bool is_deferring(void);
+
+    /**
+     * Defer a global action of the current core tick to the end of the phase
+     */
+    static void defer(function<void (void)> action);
+
+    /**
+     * Check whether a parallel phase is in progress
+     */
+    static bool is_active(void) { return m_active != NULL; }
+
+  private:
+    parallel_engine_c(); // do not implement
+
+    /**
+     * Worker thread main loop
+     */
+    void worker(int tid);
+
+    /**
+     * Run core ticks assigned to a host thread
+     */
+    void run_items(int tid);
+
+    /**
+     * Block until all core ticks below the rank have completed
+     */
+    void wait_for(int rank);
+
+    /**
+     * Mark a core tick as completed
+     */
+    void mark_done(int rank);
+
+  public:
+    static mutex m_decode_mutex; /**< protects decoded instruction tables */
+
+  private:
+    macsim_c*                   m_simBase; /**< macsim_c base class for simulation globals */
+    int                         m_num_threads; /**< number of host threads (incl. main) */
+    vector<thread>              m_workers; /**< worker threads */
+    vector<parallel_item_s>     m_items; /**< core ticks of the current phase */
+    vector<vector<int>>         m_thread_items; /**< core ticks per host thread */
+    unique_ptr<atomic<bool>[]>  m_done; /**< core tick completed */
+    int                         m_done_size; /**< size of m_done */
+    int                         m_num_items; /**< number of core ticks */
+    int                         m_first_exclusive; /**< rank of the first exclusive tick */
+    bool                        m_deferring; /**< defer process manager calls */
+    atomic<int>                 m_done_prefix; /**< all ticks below this rank completed */
+    atomic<unsigned>            m_phase; /**< phase generation */
+    atomic<int>                 m_num_finished; /**< workers done with the phase */
+    atomic<bool>                m_shutdown; /**< terminate worker threads */
+    vector<unsigned long long*> m_stat_shard; /**< stat counter block per host thread */
+
+    static parallel_engine_c*   m_active; /**< engine running a phase */
+    static thread_local int     m_cur_item; /**< core tick run by this host thread */
+    static thread_local bool    m_cur_ordered; /**< current tick has been ordered */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Scoped access to a decoded instruction table during parallel phases
+///
+/// Decoding a new instruction is ordered, so that the table is filled in serial order.
+/// No lock is taken without a table (instruction found in the decode cache).
+///////////////////////////////////////////////////////////////////////////////////////////////
+class decode_lock_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    decode_lock_c(hash_c<inst_info_s>* htable, Addr key);
+
+    /**
+     * Destructor
+     */
+    ~decode_lock_c();
+
+  private:
+    bool m_locked; /**< table lock held */
+};
+
+#endif
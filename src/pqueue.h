@@ -41,11 +41,11 @@ POSSIBILITY OF SUCH DAMAGE.
  *
  *   Priority queue models latency + priority.
  *   There are N+1 (same as modeled latency) slots.
- *   Each slot is a list that may have several elements.
- *   Elemented are sorted by priority (highest priority is in the front)
- *   New entry is inserted in the back.
- *   Each cycle (if possible), each list is moved one slot ahead.
- *   Dequeue() will get highest priority + oldest entry from the first list.
+ *   Each slot holds buckets of elements with the same priority, ordered by priority
+ *   (highest priority bucket is at the back), and each bucket is a FIFO.
+ *   New entry is appended to the bucket of its priority in the last slot.
+ *   Each cycle (if possible), each slot is moved one slot ahead.
+ *   Dequeue() will get highest priority + oldest entry from the first slot.
  */
 
 
@@ -54,10 +54,11 @@ POSSIBILITY OF SUCH DAMAGE.
 #define PQUEUE_H_INCLUDED
 
 
-#include <list>
+#include <algorithm>
 #include <string>
 #include <sys/types.h>
 #include <typeinfo>
+#include <vector>
 
 #include "macsim.h"
 #include "utils.h"
@@ -77,8 +78,18 @@ class pqueue_c
   typedef struct pqueue_entry_s {
     int64_t m_priority; /**< entry priority */
     T m_data;  /**< entry data */
+    pqueue_entry_s* m_next; /**< next entry in the bucket */
   } pqueue_entry_s;
 
+  /**
+   * entries of a slot with the same priority
+   */
+  typedef struct pqueue_bucket_s {
+    int64_t m_priority; /**< bucket priority */
+    pqueue_entry_s* m_head; /**< oldest entry */
+    pqueue_entry_s* m_tail; /**< youngest entry */
+  } pqueue_bucket_s;
+
   public:
     /**
      * pqueue constructor
@@ -94,7 +105,7 @@ class pqueue_c
 
       m_simBase       = simBase;
 
-      m_entry = new list<pqueue_entry_s *>[m_size];
+      m_bucket = new vector<pqueue_bucket_s>[m_size];
       m_entry_pool = new pool_c<pqueue_entry_s>(100, name + "_pqueue_entry_pool");
     }
 
@@ -104,7 +115,8 @@ class pqueue_c
     ~pqueue_c()
     {
       flush();
-      delete[] m_entry;
+      delete[] m_bucket;
+      delete m_entry_pool;
     }
 
     /**
@@ -112,7 +124,7 @@ class pqueue_c
      */
     bool ready()
     {
-      return !m_entry[m_current_index].empty();
+      return !m_bucket[m_current_index].empty();
     }
 
     /**
@@ -127,21 +139,29 @@ class pqueue_c
       pqueue_entry_s *new_entry = m_entry_pool->acquire_entry(); 
       new_entry->m_data     = data;
       new_entry->m_priority = priority;
+      new_entry->m_next     = NULL;
 
-      bool insert = false;
-      int count = 0;
-      for (auto I = m_entry[m_last_index].begin(), E = m_entry[m_last_index].end(); 
-          I != E; ++I) {
-          count++;
-        if ((*I)->m_priority < priority) {
-          m_entry[m_last_index].insert(I, new_entry);
-          insert = true;
-          break;
-        }
+      // new highest priority in the slot
+      vector<pqueue_bucket_s>& slot = m_bucket[m_last_index];
+      if (slot.empty() || slot.back().m_priority < priority) {
+        slot.push_back(pqueue_bucket_s{priority, new_entry, new_entry});
+        return true;
+      }
+
+      // find (or create) the bucket of the priority; entries with the same priority are FIFO
+      auto bucket = slot.end() - 1;
+      if (bucket->m_priority != priority) {
+        bucket = lower_bound(slot.begin(), slot.end(), priority, 
+            [](const pqueue_bucket_s& b, int64_t p) { return b.m_priority < p; });
+        if (bucket->m_priority != priority)
+          bucket = slot.insert(bucket, pqueue_bucket_s{priority, NULL, NULL});
       }
 
-      if (!insert)
-        m_entry[m_last_index].push_back(new_entry);
+      if (bucket->m_head == NULL)
+        bucket->m_head = new_entry;
+      else
+        bucket->m_tail->m_next = new_entry;
+      bucket->m_tail = new_entry;
 
       return true;
     }
@@ -151,16 +171,19 @@ class pqueue_c
      */
     T dequeue(int64_t *priority = 0)
     {
-      pqueue_entry_s *entry = m_entry[m_current_index].front();
+      pqueue_bucket_s& bucket = m_bucket[m_current_index].back();
+      pqueue_entry_s *entry = bucket.m_head;
       if (priority)
         *priority = entry->m_priority;
 
       T data = entry->m_data;
 
+      bucket.m_head = entry->m_next;
+      if (bucket.m_head == NULL)
+        m_bucket[m_current_index].pop_back();
+
       entry->m_data     = T(0);
       entry->m_priority = -1;
-
-      m_entry[m_current_index].pop_front();
       m_entry_pool->release_entry(entry); 
 
       --m_num_entry;
@@ -177,7 +200,7 @@ class pqueue_c
       if (m_num_entry == 0)
         return true;
 
-      if (!m_entry[m_current_index].empty())
+      if (!m_bucket[m_current_index].empty())
         return true;
 
       m_last_index    = m_current_index;
@@ -186,6 +209,14 @@ class pqueue_c
       return true;
     }
 
+    /**
+     * Check whether advance() leaves the queue unchanged (empty, or the oldest entry is ready)
+     */
+    bool is_settled()
+    {
+      return m_num_entry == 0 || ready();
+    }
+
     /**
      * Search N-th priority entry
      */
@@ -196,11 +227,12 @@ class pqueue_c
       T data = 0;
       int count = 0;
       for (int ii = m_current_index; ii < m_current_index + m_size; ++ii) {
-        int index = ii % m_size;
-        for (auto I = m_entry[index].begin(), E = m_entry[index].end(); I != E; ++I) {
-          if (count++ == entry) {
-            data = (*I)->m_data;
-            break;
+        vector<pqueue_bucket_s>& slot = m_bucket[ii % m_size];
+        for (auto I = slot.rbegin(), E = slot.rend(); I != E; ++I) {
+          for (pqueue_entry_s* cur = I->m_head; cur != NULL; cur = cur->m_next) {
+            if (count++ == entry) {
+              return cur->m_data;
+            }
           }
         }
       }
@@ -222,21 +254,24 @@ class pqueue_c
     void flush()
     {
       for (int ii = 0; ii < m_size; ++ii) {
-        while (!m_entry[ii].empty()) {
-          pqueue_entry_s *entry = m_entry[ii].front();
-
-          m_entry[ii].pop_front();
+        for (auto I = m_bucket[ii].begin(), E = m_bucket[ii].end(); I != E; ++I) {
+          pqueue_entry_s* entry = I->m_head;
+          while (entry != NULL) {
+            pqueue_entry_s* next = entry->m_next;
 
-          entry->m_data = T(0);
-          entry->m_priority = -1;
+            entry->m_data = T(0);
+            entry->m_priority = -1;
 
-          m_entry_pool->release_entry(entry);
+            m_entry_pool->release_entry(entry);
+            entry = next;
+          }
         }
+        m_bucket[ii].clear();
       }
 
       m_num_entry     = 0;
       m_current_index = 0;
-      m_last_index    = m_size;
+      m_last_index    = m_size - 1;
     }
 
     /**
@@ -250,7 +285,7 @@ class pqueue_c
   private:
     pqueue_c(); // do not implement
 
-    list<pqueue_entry_s *>* m_entry; /**< queue buckets */
+    vector<pqueue_bucket_s>* m_bucket; /**< priority buckets of each queue slot */
     pool_c<pqueue_entry_s>* m_entry_pool; /**< queue entry full */
     string m_name; /**< queue name */
     int m_size; /**< queue bucket size */
@@ -263,4 +298,3 @@ class pqueue_c
 };
 
 #endif
-
@@ -540,6 +540,9 @@ bool hwp_common_c::pref_addto_l1req_queue(Addr line_index, uns8 prefetcher_id)
   m_l1req_queue_req_pos = (m_l1req_queue_req_pos + 1) % *m_simBase->m_knobs->KNOB_PREF_DL0REQ_QUEUE_SIZE;
   m_l1req_queue[m_l1req_queue_req_pos] = new_req;
 
+  // the request is sent from the next cycle of the core
+  m_simBase->m_core_pointers[core_id]->wake_up();
+
   return true;
 }
 
@@ -745,6 +748,9 @@ bool hwp_common_c::pref_addto_l2req_queue_set(Addr line_index, uns8 prefetcher_i
   m_l2req_queue_req_pos = (m_l2req_queue_req_pos + 1) % *m_simBase->m_knobs->KNOB_PREF_UL1REQ_QUEUE_SIZE;
   m_l2req_queue[m_l2req_queue_req_pos] = new_req;
 
+  // the request is sent from the next cycle of the core
+  m_simBase->m_core_pointers[core_id]->wake_up();
+
   return true;
 }
 
@@ -868,6 +874,36 @@ void hwp_common_c::pref_update_queues(void)
 }
 
 
+// cycle skipping : no valid request in the queues
+bool hwp_common_c::is_idle(void)
+{
+  for (int ii = 0; ii < *m_simBase->m_knobs->KNOB_PREF_DL0REQ_QUEUE_SIZE; ++ii) {
+    if (m_l1req_queue[ii].valid)
+      return false;
+  }
+
+  for (int ii = 0; ii < *m_simBase->m_knobs->KNOB_PREF_UL1REQ_QUEUE_SIZE; ++ii) {
+    if (m_l2req_queue[ii].valid)
+      return false;
+  }
+
+  return true;
+}
+
+
+// cycle skipping : each cycle advances the send positions over invalid entries
+void hwp_common_c::skip_cycles(Counter num_cycles)
+{
+  int l1_size = *m_simBase->m_knobs->KNOB_PREF_DL0REQ_QUEUE_SIZE;
+  int l2_size = *m_simBase->m_knobs->KNOB_PREF_UL1REQ_QUEUE_SIZE;
+
+  m_l1req_queue_send_pos = (m_l1req_queue_send_pos + 
+      (num_cycles % l1_size) * *m_simBase->m_knobs->KNOB_PREF_DL0SCHEDULE_NUM) % l1_size;
+  m_l2req_queue_send_pos = (m_l2req_queue_send_pos + 
+      (num_cycles % l2_size) * *m_simBase->m_knobs->KNOB_PREF_UL1SCHEDULE_NUM) % l2_size;
+}
+
+
 // Event handler: when a prefetch misses in the LLC and sent to the dram
 void hwp_common_c::pref_l2sent(uns8 prefetcher_id)
 {
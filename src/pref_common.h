@@ -302,6 +302,17 @@ class hwp_common_c
      */
     void pref_update_queues(void);
 
+    /**
+     * Cycle skipping : check whether the request queues have no valid entry
+     */
+    bool is_idle(void);
+
+    /**
+     * Cycle skipping : rotate the send positions of idle request queues as
+     * pref_update_queues() would in each skipped cycle
+     */
+    void skip_cycles(Counter num_cycles);
+
     /**
      * Get region based accuracy
      */
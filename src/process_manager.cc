@@ -81,6 +81,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "process_manager.h"
 #include "pref_common.h"
 #include "trace_read.h"
+#include "trace_prefetch.h"
+#include "decode_cache.h"
+#include "checkpoint.h"
 
 #include "debug_macros.h"
 
@@ -129,6 +132,7 @@ process_s::process_s()
   m_max_block = 0;
   m_thread_start_info = NULL;
   m_thread_trace_info = NULL;
+  m_decode_cache = NULL;
   m_no_of_threads = 0;
   m_no_of_threads_created = 0;
   m_no_of_threads_terminated = 0;
@@ -160,8 +164,11 @@ thread_s::thread_s(macsim_c* simBase)
   m_fetch_data      = new frontend_s; 
   int buf_ele_size  = (CPU_TRACE_SIZE > GPU_TRACE_SIZE) ? CPU_TRACE_SIZE : GPU_TRACE_SIZE;
   m_buffer          = new char[1000 * buf_ele_size];
+  m_trace_file      = new trace_file_c(simBase);
   m_prev_trace_info = NULL;
   m_next_trace_info = NULL;
+  m_skip_inst_count = 0;
+  m_sample_id       = 0;
 
   for (int ii = 0; ii < MAX_PUP; ++ii) {
     m_trace_uop_array[ii] = new trace_uop_s;
@@ -338,6 +345,9 @@ int process_manager_c::create_process(string appl, int repeat, int pid)
   hash_c<inst_info_s>* new_inst_hash = m_inst_hash_pool->acquire_entry();
   m_simBase->m_inst_info_hash[m_simBase->m_process_count]  = new_inst_hash;
 
+  // decoded uops shared by all threads of the process
+  process->m_decode_cache = new decode_cache_c(m_simBase);
+
 
   // process data structure setup
   process->m_repeat             = repeat;
@@ -438,6 +448,13 @@ int process_manager_c::create_process(string appl, int repeat, int pid)
     process->m_core_pool = &m_simBase->m_x86_core_pool;
   }
 
+  // resume from a checkpoint : completed kernels are skipped
+  auto ckpt = m_checkpoint.find(process->m_orig_pid);
+  if (ckpt != m_checkpoint.end()) {
+    process->m_current_vector_index = ckpt->second.m_vector_index - 1;
+    m_appl_cyccount_info[process->m_orig_pid] = CYCLE;
+  }
+
   // now we set up a new process to execute it
   setup_process(process);
 
@@ -670,6 +687,28 @@ void process_manager_c::setup_process(process_s* process)
     }
   }
 
+  // resume from a checkpoint : retired blocks are not simulated again
+  if (process->m_ptx) {
+    auto ckpt = m_checkpoint.find(process->m_orig_pid);
+    if (ckpt != m_checkpoint.end() && 
+        ckpt->second.m_vector_index == process->m_current_vector_index && 
+        !ckpt->second.m_retired_block.empty()) {
+      int count = 0;
+      for (int ii = 0; ii < thread_count; ++ii) {
+        int block_id = process->m_thread_start_info[ii].m_thread_id >> BLOCK_ID_SHIFT;
+        if (ckpt->second.m_retired_block.find(block_id) == ckpt->second.m_retired_block.end())
+          process->m_thread_start_info[count++] = process->m_thread_start_info[ii];
+      }
+
+      // all blocks had been retired (finished process) : the kernel is simulated again
+      if (count > 0) {
+        report("checkpoint: " << thread_count - count << " retired warps are skipped");
+        thread_count = count;
+        process->m_no_of_threads = thread_count;
+      }
+    }
+  }
+
   // Initialize stats (this will be used to determine process termination
   process->m_no_of_threads_created    = 1;
   process->m_no_of_threads_terminated = 0;
@@ -700,6 +739,7 @@ bool process_manager_c::terminate_process(process_s* process)
   // TODO (jaekyu, 2-3-2010)
   // We may need to change this using pool_c
   m_simBase->m_inst_info_hash[process->m_process_id]->clear();
+  process->m_decode_cache->clear();
 
   // deallocate data structures
   thread_stat_s* thread_stat_data_to_delete = m_simBase->m_thread_stats[process->m_process_id];
@@ -732,6 +772,8 @@ bool process_manager_c::terminate_process(process_s* process)
   m_simBase->m_inst_info_hash.erase(process->m_process_id);
   inst_info_hash->clear();
   m_inst_hash_pool->release_entry(inst_info_hash);
+  delete process->m_decode_cache;
+  process->m_decode_cache = NULL;
 
 
   stringstream sstr;
@@ -818,8 +860,7 @@ thread_s *process_manager_c::create_thread(process_s* process, int tid, bool mai
 
   #ifndef USING_QSIM
   // open trace file
-  trace_info->m_trace_file = gzopen(filename.c_str(), "r");
-  if (trace_info->m_trace_file == NULL) 
+  if (!trace_info->m_trace_file->open(filename))
     ASSERTM(0, "error opening trace file:%s\n", filename.c_str());
   #endif
 
@@ -851,6 +892,23 @@ thread_s *process_manager_c::create_thread(process_s* process, int tid, bool mai
   trace_info->m_prev_hmc_trans_id = 0;
   trace_info->m_next_hmc_trans_id = 0;
   trace_info->m_cur_hmc_trans_cnt = 0;
+
+  trace_info->m_sample_id = 0;
+
+  // resume from a checkpoint : skip instructions that had been retired (see setup_trace)
+  trace_info->m_skip_inst_count = 0;
+  if (!process->m_ptx) {
+    auto ckpt = m_checkpoint.find(process->m_orig_pid);
+    if (ckpt != m_checkpoint.end() && 
+        ckpt->second.m_vector_index == process->m_current_vector_index) {
+      auto position = ckpt->second.m_thread_position.find(start_info->m_thread_id);
+      if (position != ckpt->second.m_thread_position.end())
+        trace_info->m_skip_inst_count = position->second;
+      else if (ckpt->second.m_finished)
+        trace_info->m_skip_inst_count = MAX_CTR;
+    }
+  }
+
   return trace_info;
 }
 
@@ -1005,7 +1063,7 @@ int process_manager_c::terminate_thread(int core_id, thread_s* trace_info, int t
     }
   }
 
-  gzclose(trace_info->m_trace_file);
+  trace_info->m_trace_file->close();
 
   // release thread_trace_info to the pool
   m_simBase->m_thread_pool->release_entry(trace_info);
@@ -1395,3 +1453,124 @@ int process_manager_c::sim_schedule_thread_block(int core_id, bool initial)
 
   return new_block_id; 
 }
+
+
+// save or restore the progress of all processes
+void process_manager_c::checkpoint(checkpoint_c* ckpt)
+{
+  ASSERTM(!*KNOB(KNOB_REPEAT_TRACE), "checkpoint does not support repeat_trace\n");
+
+  if (!ckpt->is_saving()) {
+    uint32_t num_process;
+    ckpt->io(num_process);
+    for (uint32_t ii = 0; ii < num_process; ++ii) {
+      int pid;
+      ckpt->io(pid);
+
+      process_checkpoint_s* process_ckpt = &m_checkpoint[pid];
+      ckpt->io(process_ckpt->m_vector_index);
+      ckpt->io(process_ckpt->m_finished);
+
+      uint32_t num_thread;
+      ckpt->io(num_thread);
+      for (uint32_t jj = 0; jj < num_thread; ++jj) {
+        uint32_t thread_id;
+        Counter position;
+        ckpt->io(thread_id);
+        ckpt->io(position);
+        process_ckpt->m_thread_position[thread_id] = position;
+      }
+
+      uint32_t num_block;
+      ckpt->io(num_block);
+      for (uint32_t jj = 0; jj < num_block; ++jj) {
+        int block_id;
+        ckpt->io(block_id);
+        process_ckpt->m_retired_block.insert(block_id);
+      }
+    }
+    return;
+  }
+
+  // retired instructions of running threads
+  unordered_map<thread_s*, Counter> progress;
+  for (int ii = 0; ii < *KNOB(KNOB_NUM_SIM_CORES); ++ii) {
+    m_simBase->m_core_pointers[ii]->get_thread_progress(&progress);
+  }
+
+  uint32_t num_process = m_simBase->m_sim_processes.size();
+  ckpt->io(num_process);
+  for (auto I = m_simBase->m_sim_processes.begin(), E = m_simBase->m_sim_processes.end(); 
+      I != E; ++I) {
+    process_s* process = I->second;
+    int pid = process->m_orig_pid;
+    bool finished = process->m_no_of_threads_terminated == process->m_no_of_threads_created &&
+      process->m_current_vector_index == process->m_applications.size();
+    ckpt->io(pid);
+    ckpt->io(process->m_current_vector_index);
+    ckpt->io(finished);
+
+    // progress restored from an earlier checkpoint is carried over
+    auto prev_ckpt = m_checkpoint.find(pid);
+    if (prev_ckpt != m_checkpoint.end() && 
+        prev_ckpt->second.m_vector_index != process->m_current_vector_index)
+      prev_ckpt = m_checkpoint.end();
+
+    vector<pair<uint32_t, Counter>> positions;
+    set<int> retired_block;
+    if (finished) {
+      // thread information has been deallocated
+    }
+    // GPU : blocks that are no longer in the block list have been retired
+    else if (process->m_ptx) {
+      if (prev_ckpt != m_checkpoint.end())
+        retired_block = prev_ckpt->second.m_retired_block;
+
+      for (unsigned int tid = 0; tid < process->m_no_of_threads; ++tid) {
+        int block_id = process->m_thread_start_info[tid].m_thread_id >> BLOCK_ID_SHIFT;
+        int mapped_block_id = m_simBase->m_block_id_mapper->find(process->m_process_id, 
+            block_id + process->m_kernel_block_start_count[process->m_current_vector_index-1]);
+        if (mapped_block_id != -1 && 
+            process->m_block_list.find(mapped_block_id) == process->m_block_list.end())
+          retired_block.insert(block_id);
+      }
+    }
+    // CPU : created threads are either waiting in the thread queue, running or terminated
+    else {
+      set<int> waiting;
+      for (auto itr = m_thread_queue->begin(); itr != m_thread_queue->end(); ++itr) {
+        if ((*itr)->m_process == process)
+          waiting.insert((*itr)->m_tid);
+      }
+
+      for (unsigned int tid = 0; tid < process->m_no_of_threads_created; ++tid) {
+        if (waiting.find(tid) != waiting.end())
+          continue;
+
+        // thread data of a terminated thread may have been reused by another thread
+        uint32_t thread_id = process->m_thread_start_info[tid].m_thread_id;
+        thread_s* thread = process->m_thread_trace_info[tid];
+        auto running = progress.find(thread);
+        Counter position = MAX_CTR;
+        if (running != progress.end() && thread->m_process == process && 
+            thread->m_unique_thread_id == static_cast<int>(thread_id % BLOCK_ID_MOD))
+          position = thread->m_skip_inst_count + running->second;
+        positions.push_back(make_pair(thread_id, position));
+      }
+    }
+
+    uint32_t num_thread = positions.size();
+    ckpt->io(num_thread);
+    for (auto itr = positions.begin(); itr != positions.end(); ++itr) {
+      ckpt->io(itr->first);
+      ckpt->io(itr->second);
+    }
+
+    uint32_t num_block = retired_block.size();
+    ckpt->io(num_block);
+    for (auto itr = retired_block.begin(); itr != retired_block.end(); ++itr) {
+      int block_id = *itr;
+      ckpt->io(block_id);
+    }
+  }
+}
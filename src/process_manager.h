@@ -142,6 +142,22 @@ typedef struct thread_start_info_s {
 } thread_start_info_s;
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Progress of a process restored from a checkpoint
+///
+/// A CPU thread resumes at its first instruction that had not been retired. A GPU kernel
+/// restarts without the blocks that had been retired; other blocks restart from the
+/// beginning, since their warps synchronize at barriers.
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct process_checkpoint_s {
+  unsigned int m_vector_index; /**< current index to the sub-application (kernel) */
+  bool         m_finished; /**< all threads have been terminated */
+  unordered_map<uint32_t, Counter> m_thread_position; /**< retired instructions per trace 
+                                                        thread id (MAX_CTR : terminated) */
+  set<int>     m_retired_block; /**< GPU : retired blocks (block id in the trace) */
+} process_checkpoint_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Thread statistics class
 ///
@@ -191,11 +207,14 @@ typedef struct thread_s {
   int                  m_orig_block_id; /**< original block id from a trace*/
   int                  m_orig_thread_id; /**< adjusted block id */
   int                  m_block_id; /**< block id */
-  gzFile               m_trace_file; /**< gzip trace file */
+  trace_file_c*        m_trace_file; /**< trace file */
   bool                 m_file_opened; /**< trace file opened? */
   bool                 m_main_thread; /**< main thread (usually thread id 0) */
   uint64_t             m_inst_count; /**< total instruction counts */
   uint64_t             m_uop_count;  /**< total uop counts */
+  Counter              m_skip_inst_count; /**< instructions skipped when a thread resumes 
+                                            from a checkpoint */
+  Counter              m_sample_id; /**< sample being fetched (sampled simulation) */
   bool                 m_trace_ended; /**< trace ended */
   process_s           *m_process; /**< point to the application belongs to */
   bool                 m_ptx; /**< GPU thread */
@@ -259,6 +278,7 @@ typedef struct process_s {
   int                  m_max_block; /**< max blocks per core for the application */
   thread_start_info_s *m_thread_start_info; /**< thread start information */
   thread_s**           m_thread_trace_info; /**< thread trace information */
+  decode_cache_c*      m_decode_cache; /**< decoded instructions shared by all threads */
   unsigned int         m_no_of_threads; /**< number of total threads */
   unsigned int         m_no_of_threads_created; /**< number of threads created */
   unsigned int         m_no_of_threads_terminated; /**< number of terminated threads */
@@ -366,6 +386,12 @@ class process_manager_c
      */
     void sim_thread_schedule(bool initial);
 
+    /**
+     * Save or restore the progress of all processes. Restored progress is applied when
+     * processes and threads are created.
+     */
+    void checkpoint(checkpoint_c* ckpt);
+
   private:
     /**
      * GPU simulation : schedule a thread from a block
@@ -412,6 +438,8 @@ class process_manager_c
     pool_c<hash_c<inst_info_s> >* m_inst_hash_pool; /**< instruction hash pool */
 
     unordered_map<int, Counter> m_appl_cyccount_info; /**< per application cycle count info */
+    unordered_map<int, process_checkpoint_s> m_checkpoint; /**< restored progress per original 
+                                                             process id */
     macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
 };
 
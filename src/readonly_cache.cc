@@ -52,6 +52,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "memory.h"
 #include "memreq_info.h"
 #include "readonly_cache.h"
+#include "rob_smc.h"
 #include "statistics.h"
 #include "uop.h"
 #include "utils.h"
@@ -155,7 +156,7 @@ bool readonly_cache_fill_line_wrapper(mem_req_s* req)
 {
   bool result = true;
   macsim_c* m_simBase = req->m_simBase;
-  list<mem_req_s*> done_list;
+  arena_list_c<mem_req_s*> done_list;
   for (auto I = req->m_merge.begin(), E = req->m_merge.end(); I != E; ++I) {
     if ((*I)->m_done_func && !((*I)->m_done_func((*I)))) {
       result = false;
@@ -202,6 +203,8 @@ bool readonly_cache_c::cache_fill_line(mem_req_s *req)
     DEBUG("uop:%lld done\n", uop->m_uop_num);
     uop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;
     uop->m_state = OS_SCHEDULED;
+    m_simBase->m_core_pointers[uop->m_core_id]->wake_up();
+    m_simBase->m_core_pointers[uop->m_core_id]->get_gpu_rob()->uop_done(uop);
 
     if (uop->m_mem_type == MEM_LD_CM) {
       POWER_CORE_EVENT(uop->m_core_id, POWER_CONST_CACHE_W);
@@ -225,6 +228,7 @@ bool readonly_cache_c::cache_fill_line(mem_req_s *req)
 
         puop->m_done_cycle = m_simBase->m_core_cycle[uop->m_core_id] + 1;;
         puop->m_state = OS_SCHEDULED;
+        m_simBase->m_core_pointers[puop->m_core_id]->get_gpu_rob()->uop_done(puop);
       }
     } // uop->m_parent_uop
     else {
@@ -252,3 +256,22 @@ uns8 readonly_cache_c::cache_line_size(void)
 {
   return m_cache_line_size;
 }
+
+
+// save or restore the cache contents
+void readonly_cache_c::checkpoint(checkpoint_c *ckpt)
+{
+  m_cache->checkpoint(ckpt);
+}
+
+
+// functional warmup
+bool readonly_cache_c::warmup(Addr addr, int appl_id)
+{
+  Addr line_addr, repl_line_addr;
+  if (m_cache->access_cache(addr, &line_addr, true, appl_id))
+    return true;
+
+  m_cache->insert_cache(addr, &line_addr, &repl_line_addr, appl_id, true);
+  return false;
+}
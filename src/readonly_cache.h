@@ -97,6 +97,17 @@ class readonly_cache_c
     */
     uns8 cache_line_size(void);
 
+   /*! \fn checkpoint(checkpoint_c *ckpt)
+    *  \brief save or restore the cache contents
+    */
+    void checkpoint(checkpoint_c *ckpt);
+
+   /*! \fn warmup(Addr addr, int appl_id)
+    *  \brief functional warmup : access the cache and fill the line on a miss
+    *  \return bool - cache hit
+    */
+    bool warmup(Addr addr, int appl_id);
+
   private:
     int        m_core_id; /**< core id */
     uns32      m_cache_size; /**< cache size */
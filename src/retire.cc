@@ -79,11 +79,13 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "bug_detector.h"
 #include "core.h"
 #include "frontend.h"
+#include "parallel_engine.h"
 #include "process_manager.h"
 #include "retire.h"
 #include "rob.h"
 #include "resource.h"
 #include "rob_smc.h"
+#include "sampling.h"
 #include "uop.h"
 
 #include "config.h"
@@ -107,6 +109,7 @@ retire_c::retire_c(RETIRE_INTERFACE_PARAMS(), macsim_c* simBase) : RETIRE_INTERF
 
   m_retire_running      = false;
   m_total_insts_retired = 0;
+  m_stall_fence         = false;
 
   RETIRE_CONFIG();
 
@@ -162,6 +165,7 @@ void retire_c::run_a_cycle()
 
       rob = m_gpu_rob->get_thread_rob(cur_uop->m_thread_id);
       rob->pop();
+      m_gpu_rob->update_head(cur_uop->m_thread_id);
     }
     // retirement logic for CPU simulation
     else {
@@ -278,6 +282,11 @@ void retire_c::run_a_cycle()
       ++m_total_insts_retired;
       ++m_period_inst_count;
 
+      // sampled simulation : close a sample every sample_detail_inst instructions
+      if (m_simBase->m_sampling->is_enabled())
+        m_simBase->m_sampling->retire(cur_uop->m_core_id, cur_uop->m_thread_id, 
+            m_insts_retired[cur_uop->m_thread_id]);
+
       STAT_CORE_EVENT(cur_uop->m_core_id, INST_COUNT);
       POWER_CORE_EVENT(cur_uop->m_core_id, POWER_PIPELINE);
       STAT_EVENT(INST_COUNT_TOT);
@@ -296,43 +305,28 @@ void retire_c::run_a_cycle()
 
     // Terminate thread : current uop is last uop of a thread, so we can retire a thread now
     thread_s* thread_trace_info = core->get_trace_info(cur_uop->m_thread_id);
-    process_s *process = thread_trace_info->m_process;
     if (cur_uop->m_last_uop || m_insts_retired[cur_uop->m_thread_id] >= *m_simBase->m_knobs->KNOB_MAX_INSTS) {
       core->m_thread_reach_end[cur_uop->m_thread_id] = true;
       if (!core->m_thread_finished[cur_uop->m_thread_id]) {
         ++core->m_num_thread_reach_end;
         DEBUG_CORE(m_core_id, "core_id:%d thread_id:%d terminated\n", m_core_id, cur_uop->m_thread_id);
 
-        // terminate thread
-        m_simBase->m_process_manager->terminate_thread(m_core_id, thread_trace_info, cur_uop->m_thread_id, cur_uop->m_block_id);
-
-        // disable current thread's fetch engine
-        if (!core->m_fetch_ended[cur_uop->m_thread_id]) {
-          core->m_fetch_ended[cur_uop->m_thread_id] = true;
-          core->m_fetching_thread_num--;
-        }
-
-        // all threads in an application have been retired. Thus, we can retire an appliacation
-        if (process->m_no_of_threads_terminated == process->m_no_of_threads_created) {
-          if (process->m_current_vector_index == process->m_applications.size()
-            || (*m_simBase->m_ProcessorStats)[INST_COUNT_TOT].getCount() >= *KNOB(KNOB_MAX_INSTS1)) {
-            update_stats(process);
-            m_simBase->m_process_manager->terminate_process(process);
-            if (m_simBase->m_process_count_without_repeat == 0) {
-              m_simBase->m_repeat_done = true;
-            }
-            repeat_traces(process);
-          }
-          else {
-            m_simBase->m_process_manager->terminate_process(process);
+        if (parallel_engine_c::is_deferring()) {
+          // other cores are running : the process manager is called after the quantum
+          int thread_id = cur_uop->m_thread_id;
+          int block_id  = cur_uop->m_block_id;
+          core->m_thread_finished[thread_id] = true;
+          if (!core->m_fetch_ended[thread_id]) {
+            core->m_fetch_ended[thread_id] = true;
+            core->m_fetching_thread_num--;
           }
-
-          // schedule new threads
-          m_simBase->m_process_manager->sim_thread_schedule(true);
+          parallel_engine_c::defer([this, thread_trace_info, thread_id, block_id] () {
+              terminate_thread(thread_trace_info, thread_id, block_id);
+          });
+        }
+        else {
+          terminate_thread(thread_trace_info, cur_uop->m_thread_id, cur_uop->m_block_id);
         }
-
-        // schedule new threads
-        m_simBase->m_process_manager->sim_thread_schedule(false);
       }
     } // terminate_thread
 
@@ -374,6 +368,59 @@ void retire_c::run_a_cycle()
   drain_wb();
 }
 
+// cycle skipping : the next cycle is a stall when the rob is empty or its head is not
+// completed (CPU only). Mirrors the CPU path of run_a_cycle() without changing any state.
+bool retire_c::check_stall(vector<Counter>* state, Counter* next_event)
+{
+  m_stall_fence = false;
+
+  // check whether retire stage is running
+  if (!m_retire_running) 
+    return true;
+
+  // completed stores drain from the write buffer
+  if (m_knob_ptx_sim || m_knob_igpu_sim || !m_write_buffer.empty())
+    return false;
+
+  // rob is empty
+  state->push_back(m_rob->entries());
+  if (m_rob->entries() == 0) 
+    return true;
+
+  uop_c* cur_uop = m_rob->front();
+  state->push_back(cur_uop->m_uop_num);
+
+  // uncompleted memory store UOPs can be placed in write buffer
+  if (KNOB(KNOB_USE_WB)->getValue() && cur_uop->m_mem_type == MEM_ST &&
+      cur_uop->m_exec_cycle != 0)
+    return false;
+
+  // uop can be retired, or will be at its done cycle
+  if (cur_uop->m_done_cycle && cur_uop->m_exec_cycle) {
+    if (cur_uop->m_done_cycle <= m_simBase->m_core_cycle[m_core_id] + 1)
+      return false;
+
+    *next_event = MIN2(*next_event, cur_uop->m_done_cycle);
+  }
+
+  m_stall_fence = (cur_uop->m_uop_type == UOP_FULL_FENCE ||
+                   cur_uop->m_uop_type == UOP_ACQ_FENCE  ||
+                   cur_uop->m_uop_type == UOP_REL_FENCE);
+
+  return true;
+}
+
+
+// cycle skipping : account stalled cycles
+void retire_c::skip_cycles(Counter num_cycles)
+{
+  m_cur_core_cycle = m_simBase->m_core_cycle[m_core_id];
+
+  if (m_stall_fence)
+    STAT_EVENT_N(FENCE_HEAD_ROB_WAIT, num_cycles);
+}
+
+
 // Check if the uop is older than all entries in WB
 // If not, check if its version is less than all entries in WB
 bool retire_c::check_ld_ordering_wb(uop_c* uop)
@@ -562,6 +609,45 @@ Counter retire_c::get_total_insts_retired()
 }
 
 
+// terminate a thread (and its application), then schedule new threads
+void retire_c::terminate_thread(thread_s* thread_trace_info, int thread_id, int block_id)
+{
+  core_c* core = m_simBase->m_core_pointers[m_core_id];
+  process_s* process = thread_trace_info->m_process;
+
+  // terminate thread
+  m_simBase->m_process_manager->terminate_thread(m_core_id, thread_trace_info, thread_id, block_id);
+
+  // disable current thread's fetch engine
+  if (!core->m_fetch_ended[thread_id]) {
+    core->m_fetch_ended[thread_id] = true;
+    core->m_fetching_thread_num--;
+  }
+
+  // all threads in an application have been retired. Thus, we can retire an appliacation
+  if (process->m_no_of_threads_terminated == process->m_no_of_threads_created) {
+    if (process->m_current_vector_index == process->m_applications.size()
+      || (*m_simBase->m_ProcessorStats)[INST_COUNT_TOT].getCount() >= *KNOB(KNOB_MAX_INSTS1)) {
+      update_stats(process);
+      m_simBase->m_process_manager->terminate_process(process);
+      if (m_simBase->m_process_count_without_repeat == 0) {
+        m_simBase->m_repeat_done = true;
+      }
+      repeat_traces(process);
+    }
+    else {
+      m_simBase->m_process_manager->terminate_process(process);
+    }
+
+    // schedule new threads
+    m_simBase->m_process_manager->sim_thread_schedule(true);
+  }
+
+  // schedule new threads
+  m_simBase->m_process_manager->sim_thread_schedule(false);
+}
+
+
 // whan an application is completed, update corresponding stats
 void retire_c::update_stats(process_s* process)
 {
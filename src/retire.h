@@ -147,6 +147,19 @@ class retire_c
      */
     void stop();
 
+    /**
+     * Cycle skipping : check whether the next cycle retires nothing
+     * @param state - appended with the retire state that a stalled cycle does not change
+     * @param next_event - lowered to the cycle the stall ends, if known
+     * @return true if the next cycle is a stall
+     */
+    bool check_stall(vector<Counter>* state, Counter* next_event);
+
+    /**
+     * Cycle skipping : account stalled cycles (see check_stall) without running them
+     */
+    void skip_cycles(Counter num_cycles);
+
     /**
      * Check retirement stage is running
      */
@@ -201,6 +214,11 @@ class retire_c
      */
     retire_c& operator=(const retire_c& rhs);
 
+    /**
+     * Terminate a thread whose last uop has retired
+     */
+    void terminate_thread(thread_s* thread_trace_info, int thread_id, int block_id);
+
     /**
      * Update stats when an application is done
      */
@@ -248,6 +266,7 @@ class retire_c
     uns16                       m_knob_width; /**< pipeline width */
     bool                        m_knob_ptx_sim; /**< gpu simulation */
     bool                        m_knob_igpu_sim; /**< intel gpu simulation */
+    bool                        m_stall_fence; /**< stalled cycles wait for a fence */
     unordered_map<int, Counter> m_insts_retired; /**< number of retired inst. per thread */
     unordered_map<int, Counter> m_uops_retired; /**< number of retired uop per thread */
 
@@ -103,6 +103,15 @@ class rob_c
       return m_free_cnt;
     }
 
+    /*! \fn int max_entries()
+     *  \brief Function to return the number of ROB slots.
+     *  \return int Number of ROB slots. 
+     */
+    int max_entries() 
+    {
+      return m_max_cnt;
+    }
+
     /*! \fn uop_c*& operator[](int index)
      *  \brief Function to overload "[]" for indexing into the ROB.
      *  \return uop_c* Entry at the index in ROB. 
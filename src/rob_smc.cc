@@ -91,6 +91,11 @@ smc_rob_c::smc_rob_c(Unit_Type type, int core_id, macsim_c* simBase)
     m_free_list.push_back(i);
   }
 
+  m_head_done  = new Counter[m_knob_num_threads];
+  m_head_cycle = new Counter[m_knob_num_threads];
+  fill_n(m_head_done, m_knob_num_threads, 0);
+  fill_n(m_head_cycle, m_knob_num_threads, 0);
+
   m_core_id = core_id;
 }
 
@@ -102,6 +107,8 @@ smc_rob_c::~smc_rob_c()
     delete m_thread_robs[i];
   }
   delete [] m_thread_robs; 
+  delete [] m_head_done;
+  delete [] m_head_cycle;
 }
 
 
@@ -167,6 +174,7 @@ int smc_rob_c::reserve_rob(int thread_id)
 
   m_thread_to_rob_map.insert(std::pair<int, int>(thread_id, index));
   m_thread_robs[index]->reinit();
+  m_head_done[index] = 0;
 
   return index;
 }
@@ -205,28 +213,75 @@ bool sort_uops(uop_c *a, uop_c *b)
 
 // get a list of retireable uops from multiple threads
 // called by retire stage
+// completed heads are queued by update_head and uop_done, so that only retireable
+// threads are visited, in sort_uops order
 vector<uop_c *>* smc_rob_c::get_n_uops_in_ready_order(int n, Counter core_cycle) 
 {
-  for (auto I = m_thread_to_rob_map.begin(), E = m_thread_to_rob_map.end(); I != E; ++I) {
-    int index = I->second;
-    rob_c *rob = m_thread_robs[index];
+  while (!m_retire_queue.empty() && m_retire_queue.top().m_done_cycle <= core_cycle) {
+    smc_retire_entry_s entry = m_retire_queue.top();
+    m_retire_queue.pop();
 
-    if (rob->entries()) {
-      uop_c* uop = rob->front();
-      if (uop->m_done_cycle && uop->m_done_cycle <= core_cycle) {
-        m_uop_list.push_back(uop);
-      }
-      else {
-        // uop cannot be retired due to cache miss
-        // increase memory stall cycle
-        if (uop->m_uop_info.m_l2_miss == true) {
-          STAT_CORE_EVENT(uop->m_core_id, MEM_STALL_CYCLE);
-        }
-      }
+    // drop stale entries : thread terminated, head retired or done cycle changed
+    auto itr = m_thread_to_rob_map.find(entry.m_thread_id);
+    if (itr == m_thread_to_rob_map.end())
+      continue;
+
+    int index = itr->second;
+    rob_c *rob = m_thread_robs[index];
+    uop_c* uop = entry.m_uop;
+    if (!rob->entries() || rob->front() != uop || uop->m_uop_num != entry.m_uop_num ||
+        uop->m_done_cycle != entry.m_done_cycle || m_head_done[index] != entry.m_done_cycle)
+      continue;
+
+    // uop could not be retired due to cache miss : memory stall cycles
+    if (uop->m_uop_info.m_l2_miss == true && uop->m_done_cycle > m_head_cycle[index]) {
+      STAT_CORE_EVENT_N(uop->m_core_id, MEM_STALL_CYCLE, 
+          uop->m_done_cycle - m_head_cycle[index]);
     }
+
+    m_uop_list.push_back(uop);
   }
 
   return &m_uop_list;
 }
 
 
+// track the head of a thread rob
+void smc_rob_c::update_head(int thread_id)
+{
+  int index = m_thread_to_rob_map[thread_id];
+  rob_c *rob = m_thread_robs[index];
+
+  m_head_done[index]  = 0;
+  m_head_cycle[index] = m_simBase->m_core_cycle[m_core_id];
+
+  if (rob->entries())
+    uop_done(rob->front());
+}
+
+
+// queue a completed rob head for retirement
+void smc_rob_c::uop_done(uop_c* uop)
+{
+  if (!uop->m_done_cycle)
+    return;
+
+  auto itr = m_thread_to_rob_map.find(uop->m_thread_id);
+  if (itr == m_thread_to_rob_map.end())
+    return;
+
+  int index = itr->second;
+  rob_c *rob = m_thread_robs[index];
+  if (!rob->entries() || rob->front() != uop || m_head_done[index] == uop->m_done_cycle)
+    return;
+
+  smc_retire_entry_s entry;
+  entry.m_done_cycle  = uop->m_done_cycle;
+  entry.m_sched_cycle = uop->m_sched_cycle;
+  entry.m_thread_id   = uop->m_thread_id;
+  entry.m_uop         = uop;
+  entry.m_uop_num     = uop->m_uop_num;
+  m_retire_queue.push(entry);
+
+  m_head_done[index] = uop->m_done_cycle;
+}
@@ -42,6 +42,8 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <cassert>
+#include <functional>
+#include <queue>
 #include <unordered_map>
 #include <vector>
 
@@ -49,6 +51,29 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "rob.h"
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Completed thread rob head, waiting for retirement
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct smc_retire_entry_s {
+  Counter m_done_cycle; /**< done cycle of the head */
+  Counter m_sched_cycle; /**< schedule cycle of the head */
+  int     m_thread_id; /**< thread id */
+  uop_c*  m_uop; /**< head uop */
+  Counter m_uop_num; /**< uop number of the head, to drop stale entries */
+
+  /**
+   * Retirement order (same as sort_uops) : done cycle, schedule cycle, thread id
+   */
+  bool operator>(const smc_retire_entry_s& rhs) const {
+    if (m_done_cycle != rhs.m_done_cycle)
+      return m_done_cycle > rhs.m_done_cycle;
+    if (m_sched_cycle != rhs.m_sched_cycle)
+      return m_sched_cycle > rhs.m_sched_cycle;
+    return m_thread_id > rhs.m_thread_id;
+  }
+} smc_retire_entry_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Reorder buffer class for GPU simulation
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -107,6 +132,22 @@ class smc_rob_c
      */
     vector<uop_c *>* get_n_uops_in_ready_order(int n, Counter cur_core_cycle);
 
+    /**
+     *  \brief Function to track the new head of a thread rob, after a push into an
+     *  empty rob or a pop. A head with a known done cycle is queued for retirement.
+     *  \param thread_id Thread identifier
+     *  \return void. 
+     */
+    void update_head(int thread_id);
+
+    /**
+     *  \brief Function to be called whenever the done cycle of a uop is set. If the uop
+     *  is the head of its thread rob, it is queued for retirement.
+     *  \param uop Completed uop
+     *  \return void. 
+     */
+    void uop_done(uop_c* uop);
+
   private:
     int             m_knob_num_threads; /**< max threads per core */
     rob_c **        m_thread_robs; /**< reorder buffer per thread */
@@ -116,6 +157,10 @@ class smc_rob_c
     Unit_Type       m_unit_type;  /**< core type */
     
     unordered_map<int, int> m_thread_to_rob_map; /**< thread id to rob mapping */
+    Counter*        m_head_done; /**< queued done cycle of the head per rob */
+    Counter*        m_head_cycle; /**< cycle the head reached the front per rob */
+    priority_queue<smc_retire_entry_s, vector<smc_retire_entry_s>,
+                   greater<smc_retire_entry_s>> m_retire_queue; /**< completed heads */
 
     macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
    
@@ -0,0 +1,290 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : sampling.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : sampled simulation (periodic or SimPoint intervals)
+ *********************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#include "sampling.h"
+#include "macsim.h"
+#include "core.h"
+#include "statistics.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+#include "utils.h"
+
+#include "all_knobs.h"
+
+
+// two-sided standard normal quantile : z such that P(|Z| < z) = confidence
+static double normal_quantile(double confidence)
+{
+  double lo = 0.0, hi = 10.0;
+  for (int ii = 0; ii < 100; ++ii) {
+    double mid = (lo + hi) / 2;
+    if (erf(mid / sqrt(2.0)) < confidence)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return (lo + hi) / 2;
+}
+
+
+sampling_c::sampling_c(macsim_c* simBase)
+{
+  m_simBase     = simBase;
+  m_period_inst = *KNOB(KNOB_SAMPLE_PERIOD_INST);
+  m_detail_inst = *KNOB(KNOB_SAMPLE_DETAIL_INST) ? *KNOB(KNOB_SAMPLE_DETAIL_INST) : m_period_inst;
+  m_enable      = m_period_inst > 0;
+
+  if (!m_enable)
+    return;
+
+  ASSERTM(m_detail_inst <= m_period_inst, "sample_detail_inst (%llu) is larger than "
+      "sample_period_inst (%llu)\n", m_detail_inst, m_period_inst);
+  ASSERTM(!strcmp(KNOB(KNOB_CHECKPOINT_SAVE)->getValue().c_str(), "NULL"), 
+      "checkpoint_save cannot be combined with sampled simulation\n");
+
+  string simpoint_file = KNOB(KNOB_SAMPLE_SIMPOINT_FILE)->getValue();
+  if (strcmp(simpoint_file.c_str(), "NULL"))
+    read_simpoints(simpoint_file, KNOB(KNOB_SAMPLE_WEIGHT_FILE)->getValue());
+
+  int num_cores = *KNOB(KNOB_NUM_SIM_CORES);
+  m_start.resize(num_cores);
+  m_samples.resize(num_cores);
+}
+
+
+sampling_c::~sampling_c()
+{
+}
+
+
+// SimPoint output : one 'interval cluster' (simpoints) or 'weight cluster' (weights) per line
+void sampling_c::read_simpoints(const string& simpoint_file, const string& weight_file)
+{
+  map<int, double> cluster_weight;
+  if (strcmp(weight_file.c_str(), "NULL")) {
+    ifstream weights(weight_file.c_str());
+    ASSERTM(weights.good(), "cannot open sample weight file %s\n", weight_file.c_str());
+
+    double weight;
+    int cluster;
+    while (weights >> weight >> cluster)
+      cluster_weight[cluster] = weight;
+  }
+
+  ifstream simpoints(simpoint_file.c_str());
+  ASSERTM(simpoints.good(), "cannot open simpoint file %s\n", simpoint_file.c_str());
+
+  vector<pair<Counter, double>> intervals;
+  Counter interval;
+  int cluster;
+  while (simpoints >> interval >> cluster) {
+    double weight = 1.0;
+    if (!cluster_weight.empty()) {
+      ASSERTM(cluster_weight.find(cluster) != cluster_weight.end(), 
+          "no weight for simpoint cluster %d in %s\n", cluster, weight_file.c_str());
+      weight = cluster_weight[cluster];
+    }
+    intervals.push_back(make_pair(interval, weight));
+  }
+  ASSERTM(!intervals.empty(), "no simpoint in %s\n", simpoint_file.c_str());
+
+  // simulated in trace order
+  sort(intervals.begin(), intervals.end());
+  for (auto itr = intervals.begin(); itr != intervals.end(); ++itr) {
+    ASSERTM(m_simpoints.empty() || m_simpoints.back() != itr->first, 
+        "simpoint interval %llu is listed twice\n", itr->first);
+    m_simpoints.push_back(itr->first);
+    m_weights.push_back(itr->second);
+  }
+}
+
+
+// sample k covers the last m_detail_inst instructions of its interval : the interval is
+// k in periodic mode, and the k-th simpoint otherwise
+Counter sampling_c::get_skip(Counter index)
+{
+  if (m_simpoints.empty())
+    return m_period_inst - m_detail_inst;
+
+  if (index >= m_simpoints.size())
+    return MAX_CTR;
+
+  Counter prev_end = index ? (m_simpoints[index - 1] + 1) * m_period_inst : 0;
+  return (m_simpoints[index] + 1) * m_period_inst - m_detail_inst - prev_end;
+}
+
+
+void sampling_c::snapshot(int core_id, sample_s* sample)
+{
+  ProcessorStatistics* stats = m_simBase->m_ProcessorStats;
+
+  sample->m_cycle       = m_simBase->m_core_pointers[core_id]->get_cycle_count();
+  sample->m_br_mispred  = getCoreWideStat(core_id, BP_ON_PATH_MISPREDICT, stats).getCount();
+  sample->m_icache_miss = getCoreWideStat(core_id, ICACHE_MISS, stats).getCount();
+  sample->m_dcache_miss = getCoreWideStat(core_id, DCACHE_MISS, stats).getCount();
+  sample->m_llc_miss    = getCoreWideStat(core_id, LLC_MISS, stats).getCount();
+}
+
+
+void sampling_c::start_thread(int core_id, int thread_id)
+{
+  snapshot(core_id, &m_start[core_id][thread_id]);
+}
+
+
+void sampling_c::retire(int core_id, int thread_id, Counter retired)
+{
+  if (retired % m_detail_inst)
+    return;
+
+  auto itr = m_start[core_id].find(thread_id);
+  if (itr == m_start[core_id].end())
+    return;
+
+  sample_s& start = itr->second;
+  sample_s sample;
+  snapshot(core_id, &sample);
+
+  sample_s delta = sample;
+  delta.m_core_id     = core_id;
+  delta.m_thread_id   = thread_id;
+  delta.m_index       = retired / m_detail_inst - 1;
+  delta.m_weight      = m_simpoints.empty() ? 1.0 : 
+    (delta.m_index < m_weights.size() ? m_weights[delta.m_index] : 0.0);
+  delta.m_inst        = m_detail_inst;
+  delta.m_cycle       -= start.m_cycle;
+  delta.m_br_mispred  -= start.m_br_mispred;
+  delta.m_icache_miss -= start.m_icache_miss;
+  delta.m_dcache_miss -= start.m_dcache_miss;
+  delta.m_llc_miss    -= start.m_llc_miss;
+  m_samples[core_id].push_back(delta);
+
+  start = sample;
+  STAT_EVENT(SAMPLE_COUNT);
+}
+
+
+void sampling_c::print_stats(string ext)
+{
+  if (!m_enable)
+    return;
+
+  string filename = *KNOB(KNOB_STATISTICS_OUT_DIRECTORY);
+  filename = filename + "/sampling.stat.out" + ext;
+  FILE* file = fopen(filename.c_str(), "w");
+  if (file == NULL)
+    return;
+
+  const int num_metric = 6;
+  const char* metric_name[num_metric] = {"IPC", "CPI", "BR_MPKI", "ICACHE_MPKI", 
+    "DCACHE_MPKI", "LLC_MPKI"};
+
+  fprintf(file, "# period:%llu detail:%llu mode:%s\n", m_period_inst, m_detail_inst, 
+      m_simpoints.empty() ? "periodic" : "simpoint");
+  fprintf(file, "%-6s %-8s %-8s %10s %12s %14s", "core", "thread", "sample", "weight", "inst", 
+      "cycle");
+  for (int ii = 0; ii < num_metric; ++ii) 
+    fprintf(file, " %12s", metric_name[ii]);
+  fprintf(file, "\n");
+
+  // per-sample values, and weighted sums for the estimates
+  double sum_w = 0.0, sum_w2 = 0.0;
+  double sum_wx[num_metric] = {0.0};
+  vector<pair<double, vector<double>>> values;
+  for (auto core_itr = m_samples.begin(); core_itr != m_samples.end(); ++core_itr) {
+    for (auto itr = core_itr->begin(); itr != core_itr->end(); ++itr) {
+      double kilo_inst = itr->m_inst / 1000.0;
+      vector<double> x(num_metric);
+      x[0] = itr->m_cycle ? (double)itr->m_inst / itr->m_cycle : 0.0;
+      x[1] = (double)itr->m_cycle / itr->m_inst;
+      x[2] = itr->m_br_mispred / kilo_inst;
+      x[3] = itr->m_icache_miss / kilo_inst;
+      x[4] = itr->m_dcache_miss / kilo_inst;
+      x[5] = itr->m_llc_miss / kilo_inst;
+
+      fprintf(file, "%-6d %-8d %-8llu %10.6f %12llu %14llu", itr->m_core_id, itr->m_thread_id, 
+          itr->m_index, itr->m_weight, itr->m_inst, itr->m_cycle);
+      for (int ii = 0; ii < num_metric; ++ii) 
+        fprintf(file, " %12.4f", x[ii]);
+      fprintf(file, "\n");
+
+      sum_w  += itr->m_weight;
+      sum_w2 += itr->m_weight * itr->m_weight;
+      for (int ii = 0; ii < num_metric; ++ii) 
+        sum_wx[ii] += itr->m_weight * x[ii];
+      values.push_back(make_pair(itr->m_weight, x));
+    }
+  }
+
+  // weighted mean and confidence interval. The standard error uses the effective number
+  // of samples (sum w)^2 / sum w^2, which is the sample count for equal weights.
+  Counter num_sample = values.size();
+  double confidence  = *KNOB(KNOB_SAMPLE_CONFIDENCE);
+  double z           = normal_quantile(confidence);
+
+  fprintf(file, "\n# samples:%llu confidence:%.2f (z=%.4f)\n", num_sample, confidence, z);
+  fprintf(file, "%-12s %14s %14s %10s\n", "metric", "mean", "+-", "+-(%)");
+  for (int ii = 0; ii < num_metric; ++ii) {
+    if (sum_w <= 0.0) 
+      break;
+
+    double mean = sum_wx[ii] / sum_w;
+    fprintf(file, "%-12s %14.4f", metric_name[ii], mean);
+    if (num_sample < 2) {
+      fprintf(file, " %14s %10s\n", "-", "-");
+      continue;
+    }
+
+    double sum_wd2 = 0.0;
+    for (auto itr = values.begin(); itr != values.end(); ++itr) {
+      double diff = itr->second[ii] - mean;
+      sum_wd2 += itr->first * diff * diff;
+    }
+    double variance   = sum_wd2 / sum_w * num_sample / (num_sample - 1);
+    double effective  = sum_w * sum_w / sum_w2;
+    double half_width = z * sqrt(variance / effective);
+    fprintf(file, " %14.4f %10.2f\n", half_width, mean ? 100.0 * half_width / mean : 0.0);
+  }
+
+  fclose(file);
+}
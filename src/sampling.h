@@ -0,0 +1,152 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : sampling.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : sampled simulation (periodic or SimPoint intervals)
+ *********************************************************************************************/
+
+#ifndef SAMPLING_H_INCLUDED
+#define SAMPLING_H_INCLUDED
+
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "global_defs.h"
+#include "global_types.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Measurement of one sample
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct sample_s {
+  int     m_core_id; /**< core id */
+  int     m_thread_id; /**< thread id */
+  Counter m_index; /**< sample index within the thread */
+  double  m_weight; /**< sample weight */
+  Counter m_inst; /**< retired instructions */
+  Counter m_cycle; /**< core cycles */
+  Counter m_br_mispred; /**< branch mispredictions */
+  Counter m_icache_miss; /**< instruction cache misses */
+  Counter m_dcache_miss; /**< L1 data cache misses */
+  Counter m_llc_miss; /**< LLC misses */
+} sample_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Sampled simulation driver
+///
+/// Each thread alternates between functional warmup and detailed simulation. In periodic
+/// mode, the last SAMPLE_DETAIL_INST instructions of every SAMPLE_PERIOD_INST instructions
+/// are simulated in detail. In SimPoint mode, the intervals listed in SAMPLE_SIMPOINT_FILE
+/// are simulated and the rest of the trace is warmed up (up to the last simpoint) or skipped.
+///
+/// The trace reader asks for the number of instructions to warm up before each sample
+/// (get_skip), so that KNOB_MAX_INSTS and the fetch/retire counters only count detailed
+/// instructions. The retire stage closes a sample every SAMPLE_DETAIL_INST retired
+/// instructions and records per-core counter deltas. Per-sample values and weighted means
+/// with confidence intervals are written next to the other stat files.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class sampling_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    sampling_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~sampling_c();
+
+    /**
+     * Sampled simulation enabled
+     */
+    bool is_enabled(void) { return m_enable; }
+
+    /**
+     * Number of detailed instructions per sample
+     */
+    Counter get_detail_inst(void) { return m_detail_inst; }
+
+    /**
+     * Number of instructions to warm up before a sample
+     * @param index - sample index
+     * @return MAX_CTR after the last simpoint (skip the rest of the trace)
+     */
+    Counter get_skip(Counter index);
+
+    /**
+     * Start measuring a thread (called when the thread is set up)
+     */
+    void start_thread(int core_id, int thread_id);
+
+    /**
+     * Called for each retired instruction : close a sample every SAMPLE_DETAIL_INST
+     * instructions. Only state of core_id is touched (parallel-safe).
+     * @param retired - number of retired instructions of the thread
+     */
+    void retire(int core_id, int thread_id, Counter retired);
+
+    /**
+     * Print per-sample values and weighted estimates
+     * @param ext - stat file extension
+     */
+    void print_stats(string ext);
+
+  private:
+    sampling_c(); // do not implement
+
+    /**
+     * Read SimPoint intervals and weights
+     */
+    void read_simpoints(const string& simpoint_file, const string& weight_file);
+
+    /**
+     * Take a snapshot of the per-core counters
+     */
+    void snapshot(int core_id, sample_s* sample);
+
+  private:
+    macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
+    bool      m_enable; /**< sampled simulation enabled */
+    Counter   m_period_inst; /**< sample period (interval size of SimPoint) */
+    Counter   m_detail_inst; /**< detailed instructions per sample */
+    vector<Counter> m_simpoints; /**< sorted simpoint intervals (empty : periodic) */
+    vector<double>  m_weights; /**< weight of each simpoint */
+    vector<unordered_map<int, sample_s>> m_start; /**< per-core counters at sample start */
+    vector<vector<sample_s>> m_samples; /**< per-core completed samples */
+};
+
+#endif
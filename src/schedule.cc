@@ -42,6 +42,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "exec.h"
 #include "core.h"
 #include "statistics.h"
+#include "utils.h"
+#include "assert_macros.h"
 
 #include "config.h"
 
@@ -80,6 +82,15 @@ schedule_c::schedule_c(exec_c* exec, int core_id, Unit_Type unit_type, frontend_
 
   std::fill_n(m_schedule_list, MAX_SCHED_SIZE, - 1); 
   m_last_sched_cycle = 0;
+
+  m_wakeup            = false;
+  m_wakeup_list_slots = false;
+  m_wakeup_num_slots  = 0;
+
+  m_stall_running       = false;
+  m_stall_num_failed    = 0;
+  m_stall_num_peeked    = 0;
+  m_stall_num_fp_peeked = 0;
 }
 
 
@@ -319,6 +330,26 @@ bool schedule_c::uop_schedule(int entry, SCHED_FAIL_TYPE* sched_fail_reason)
 }
 
 
+// uop types that read the fp renaming table
+static bool is_fp_rename(Uop_Type type)
+{
+  switch (type) {
+    case UOP_FMEM:
+    case UOP_FCF:
+    case UOP_FCVT:
+    case UOP_FADD:                   
+    case UOP_FMUL:                    
+    case UOP_FDIV:                   
+    case UOP_FCMP:                  
+    case UOP_FBIT:                   
+    case UOP_FCMOV:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
 // move uops from alloc queue to schedule queue
 void schedule_c::advance(int q_index)
 {
@@ -338,21 +369,8 @@ void schedule_c::advance(int q_index)
     POWER_CORE_EVENT(m_core_id, POWER_UOP_QUEUE_R);
     POWER_CORE_EVENT(m_core_id, POWER_REG_RENAMING_TABLE_R);
     POWER_CORE_EVENT(m_core_id, POWER_FREELIST_R);
-    switch (cur_uop->m_uop_type) {
-      case UOP_FMEM:
-      case UOP_FCF:
-      case UOP_FCVT:
-      case UOP_FADD:                   
-      case UOP_FMUL:                    
-      case UOP_FDIV:                   
-      case UOP_FCMP:                  
-      case UOP_FBIT:                   
-      case UOP_FCMOV:
-        POWER_CORE_EVENT(m_core_id, POWER_FP_RENAME_R);
-        break;
-      default:
-        break;
-    }
+    if (is_fp_rename(cur_uop->m_uop_type))
+      POWER_CORE_EVENT(m_core_id, POWER_FP_RENAME_R);
 
     DEBUG_CORE(m_core_id, "cycle_m_count:%lld entry:%d m_core_id:%d thread_id:%d uop_num:%llu inst_num:%llu "
         "uop.va:0x%llx allocq:%d mem_type:%d \n", m_cur_core_cycle, entry, m_core_id, cur_uop->m_thread_id, 
@@ -393,9 +411,340 @@ void schedule_c::advance(int q_index)
     // Add the uop's entry identifier in the ROB to the schedule list (scheduler insertion) 
     // -------------------------------------
     m_schedule_list[m_last_schlist_ptr] = entry;
+    if (m_wakeup && m_wakeup_list_slots)
+      wakeup_track(m_last_schlist_ptr, 0);
     m_last_schlist_ptr = (m_last_schlist_ptr + 1) % MAX_SCHED_SIZE;
 
     // update the element m_count for the corresponding sched queue
     m_num_per_sched[q_type] = m_num_per_sched[q_type] + 1;
   }
 }
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// cycle skipping
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// account stalled cycles : same events as run_a_cycle() with every uop failing on operands
+void schedule_c::skip_cycles(Counter num_cycles)
+{
+  m_cur_core_cycle = m_simBase->m_core_cycle[m_core_id];
+
+  if (!m_stall_running)
+    return;
+
+  if (m_stall_num_failed) {
+    STAT_CORE_EVENT_N(m_core_id, SCHED_FAILED_REASON_SUCCESS + SCHED_FAIL_OPERANDS_NOT_READY,
+        m_stall_num_failed * num_cycles);
+  }
+
+  if (m_num_in_sched) {
+    STAT_CORE_EVENT_N(m_core_id, NUM_NO_SCHED_CYCLE, num_cycles);
+  }
+  else {
+    STAT_CORE_EVENT_N(m_core_id, NUM_SCHED_IDLE_CYCLE, num_cycles);
+  }
+
+  if (m_stall_num_peeked) {
+    Counter num_reads = m_stall_num_peeked * num_cycles;
+    POWER_CORE_EVENT_N(m_core_id, POWER_INST_QUEUE_R, num_reads);
+    POWER_CORE_EVENT_N(m_core_id, POWER_UOP_QUEUE_R, num_reads);
+    POWER_CORE_EVENT_N(m_core_id, POWER_REG_RENAMING_TABLE_R, num_reads);
+    POWER_CORE_EVENT_N(m_core_id, POWER_FREELIST_R, num_reads);
+  }
+
+  if (m_stall_num_fp_peeked) {
+    POWER_CORE_EVENT_N(m_core_id, POWER_FP_RENAME_R, m_stall_num_fp_peeked * num_cycles);
+  }
+}
+
+
+// check whether an uop fails on its operands (same conditions as uop_schedule/check_srcs)
+bool schedule_c::is_operand_stalled(uop_c* cur_uop, Counter cycle, Counter* next_event)
+{
+  if (cur_uop->m_bogus || cur_uop->m_srcs_rdy)
+    return false;
+
+  if (cur_uop->m_last_dep_exec && cycle < *(cur_uop->m_last_dep_exec)) {
+    *next_event = MIN2(*next_event, *(cur_uop->m_last_dep_exec));
+    return true;
+  }
+
+  for (int i = 0; i < cur_uop->m_num_srcs; ++i) {
+    uop_c* src_uop = cur_uop->m_map_src_info[i].m_uop;
+    if (!src_uop || 
+        !src_uop->m_valid ||
+        (src_uop->m_uop_num != cur_uop->m_map_src_info[i].m_uop_num) ||
+        (src_uop->m_thread_id != cur_uop->m_thread_id)) {
+      continue;
+    }
+
+    // completion cycle not known yet : a memory response wakes up the core
+    if (src_uop->m_done_cycle == 0)
+      return true;
+
+    if (cycle < src_uop->m_done_cycle) {
+      *next_event = MIN2(*next_event, src_uop->m_done_cycle);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+// check whether advance() moves no uop into the scheduler
+bool schedule_c::check_advance_stall(void)
+{
+  m_stall_num_peeked    = 0;
+  m_stall_num_fp_peeked = 0;
+
+  for (int ii = 0; ii < max_ALLOCQ; ++ii) {
+    if (!m_alloc_q[ii]->ready())
+      continue;
+
+    // scheduler is full
+    if ((m_last_schlist_ptr + 1) % MAX_SCHED_SIZE == m_first_schlist_ptr)
+      continue;
+
+    uop_c* cur_uop = (*m_rob)[(int) m_alloc_q[ii]->peek(0)];
+    ++m_stall_num_peeked;
+    if (is_fp_rename(cur_uop->m_uop_type))
+      ++m_stall_num_fp_peeked;
+
+    // sched queue of the corresponding type has space
+    ALLOCQ_Type q_type = cur_uop->m_allocq_num;
+    if (m_sched_rate[q_type] > 0 && m_num_per_sched[q_type] < m_sched_size[q_type])
+      return false;
+  }
+
+  return true;
+}
+
+
+// check whether no slot is ready or wakes up (same conditions as process_wakeups)
+bool schedule_c::is_wakeup_idle(Counter cycle, Counter* next_event)
+{
+  if (!m_wakeup_timer.empty()) {
+    if (m_wakeup_timer.top().m_cycle <= cycle)
+      return false;
+
+    *next_event = MIN2(*next_event, m_wakeup_timer.top().m_cycle);
+  }
+
+  for (auto itr = m_wakeup_watch.begin(); itr != m_wakeup_watch.end(); ++itr) {
+    uop_c* src_uop = itr->m_uop;
+    if (!src_uop->m_valid ||
+        src_uop->m_uop_num != itr->m_uop_num ||
+        src_uop->m_done_cycle != 0)
+      return false;
+  }
+
+  for (auto port = m_ready_bits.begin(); port != m_ready_bits.end(); ++port) {
+    for (auto word = port->begin(); word != port->end(); ++word) {
+      if (*word)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// wakeup-based scheduling
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// enable wakeup-based scheduling
+void schedule_c::init_wakeup(int num_slots, int num_ports, bool list_slots)
+{
+  m_wakeup            = true;
+  m_wakeup_list_slots = list_slots;
+  m_wakeup_num_slots  = num_slots;
+
+  m_ready_bits.resize(num_ports);
+  for (int ii = 0; ii < num_ports; ++ii)
+    m_ready_bits[ii].assign((num_slots + 63) / 64, 0);
+
+  m_slot_state.assign(num_slots, SCHED_SLOT_IDLE);
+  m_slot_port.assign(num_slots, 0);
+}
+
+
+// get the uop in a schedule list slot
+uop_c* schedule_c::get_slot_uop(int slot)
+{
+  if (m_schedule_list[slot] == -1)
+    return NULL;
+
+  return (*m_rob)[m_schedule_list[slot]];
+}
+
+
+// start tracking the source operands of a slot
+void schedule_c::wakeup_track(int slot, int port)
+{
+  if (m_slot_state[slot] == SCHED_SLOT_READY)
+    m_ready_bits[m_slot_port[slot]][slot >> 6] &= ~(1ULL << (slot & 63));
+
+  m_slot_port[slot] = port;
+  wakeup_eval(slot, get_slot_uop(slot));
+}
+
+
+// stop tracking a slot
+void schedule_c::wakeup_remove(int slot)
+{
+  if (m_slot_state[slot] == SCHED_SLOT_READY)
+    m_ready_bits[m_slot_port[slot]][slot >> 6] &= ~(1ULL << (slot & 63));
+
+  // stale timer and watch entries are dropped when they fire
+  m_slot_state[slot] = SCHED_SLOT_IDLE;
+}
+
+
+// find the cycle all sources of a uop are ready (same conditions as check_srcs)
+uop_c* schedule_c::find_wakeup_src(uop_c* uop, Counter* cycle)
+{
+  *cycle = 0;
+  if (uop->m_bogus || uop->m_srcs_rdy)
+    return NULL;
+
+  for (int ii = 0; ii < uop->m_num_srcs; ++ii) {
+    uop_c* src_uop = uop->m_map_src_info[ii].m_uop;
+    if (!src_uop ||
+        !src_uop->m_valid ||
+        (src_uop->m_uop_num != uop->m_map_src_info[ii].m_uop_num) ||
+        (src_uop->m_thread_id != uop->m_thread_id)) {
+      continue;
+    }
+
+    // completion cycle not known yet : wait for the producer
+    if (src_uop->m_done_cycle == 0)
+      return src_uop;
+
+    *cycle = MAX2(*cycle, src_uop->m_done_cycle);
+  }
+
+  return NULL;
+}
+
+
+// put a slot into the ready bitmap, the timer queue, or the producer watch list
+void schedule_c::wakeup_eval(int slot, uop_c* uop)
+{
+  Counter cycle;
+  uop_c* src_uop = find_wakeup_src(uop, &cycle);
+
+  sched_wait_s wait;
+  wait.m_cycle   = cycle;
+  wait.m_slot    = slot;
+  wait.m_uop     = uop;
+  wait.m_uop_num = uop->m_uop_num;
+
+  if (src_uop) {
+    m_slot_state[slot] = SCHED_SLOT_WAIT;
+
+    for (auto itr = m_wakeup_watch.begin(); itr != m_wakeup_watch.end(); ++itr) {
+      if (itr->m_uop == src_uop && itr->m_uop_num == src_uop->m_uop_num) {
+        itr->m_waiters.push_back(wait);
+        return;
+      }
+    }
+
+    sched_watch_s watch;
+    watch.m_uop     = src_uop;
+    watch.m_uop_num = src_uop->m_uop_num;
+    watch.m_waiters.push_back(wait);
+    m_wakeup_watch.push_back(watch);
+  }
+  else if (cycle > m_simBase->m_core_cycle[m_core_id]) {
+    m_slot_state[slot] = SCHED_SLOT_WAIT;
+    m_wakeup_timer.push(wait);
+  }
+  else {
+    m_slot_state[slot] = SCHED_SLOT_READY;
+    m_ready_bits[m_slot_port[slot]][slot >> 6] |= (1ULL << (slot & 63));
+  }
+}
+
+
+// wake up a waiting slot, unless it has been scheduled in the meantime
+void schedule_c::wakeup_waiter(const sched_wait_s& wait)
+{
+  if (m_slot_state[wait.m_slot] != SCHED_SLOT_WAIT)
+    return;
+
+  uop_c* uop = get_slot_uop(wait.m_slot);
+  if (uop != wait.m_uop || uop->m_uop_num != wait.m_uop_num)
+    return;
+
+  wakeup_eval(wait.m_slot, uop);
+}
+
+
+// wake up slots whose timer expired or whose producer got its done cycle
+void schedule_c::process_wakeups(void)
+{
+  Counter cycle = m_simBase->m_core_cycle[m_core_id];
+
+  while (!m_wakeup_timer.empty() && m_wakeup_timer.top().m_cycle <= cycle) {
+    sched_wait_s wait = m_wakeup_timer.top();
+    m_wakeup_timer.pop();
+    wakeup_waiter(wait);
+  }
+
+  // only producers with outstanding dependents are polled
+  for (size_t ii = 0; ii < m_wakeup_watch.size(); ) {
+    uop_c* src_uop = m_wakeup_watch[ii].m_uop;
+    if (src_uop->m_valid &&
+        src_uop->m_uop_num == m_wakeup_watch[ii].m_uop_num &&
+        src_uop->m_done_cycle == 0) {
+      ++ii;
+      continue;
+    }
+
+    vector<sched_wait_s> waiters;
+    waiters.swap(m_wakeup_watch[ii].m_waiters);
+    if (ii != m_wakeup_watch.size() - 1)
+      m_wakeup_watch[ii] = std::move(m_wakeup_watch.back());
+    m_wakeup_watch.pop_back();
+
+    for (auto itr = waiters.begin(); itr != waiters.end(); ++itr)
+      wakeup_waiter(*itr);
+  }
+}
+
+
+// find the first ready slot of a port in [from, to)
+int schedule_c::next_ready_slot_linear(int port, int from, int to)
+{
+  const uns64* bits = &m_ready_bits[port][0];
+  while (from < to) {
+    int word   = from >> 6;
+    uns64 mask = bits[word] & (~0ULL << (from & 63));
+    if (mask) {
+      int slot = (word << 6) + __builtin_ctzll(mask);
+      return slot < to ? slot : -1;
+    }
+    from = (word + 1) << 6;
+  }
+
+  return -1;
+}
+
+
+// find the first ready slot of a port in the circular range [from, to)
+int schedule_c::next_ready_slot(int port, int from, int to)
+{
+  if (from <= to)
+    return next_ready_slot_linear(port, from, to);
+
+  int slot = next_ready_slot_linear(port, from, m_wakeup_num_slots);
+  if (slot == -1)
+    slot = next_ready_slot_linear(port, 0, to);
+
+  return slot;
+}
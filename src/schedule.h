@@ -39,6 +39,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #define SCHEDULE_H_INCLUDED 
 
 
+#include <functional>
+
 #include "global_types.h"
 #include "global_defs.h"
 #include "uop.h"
@@ -125,6 +127,43 @@ enum SCHED_FAIL_TYPE
 };  
 
 
+/**
+ * Wakeup state of a scheduler slot
+ */
+enum SCHED_SLOT_STATE
+{
+  SCHED_SLOT_IDLE,  /**< not tracked */
+  SCHED_SLOT_READY, /**< source operands ready, in the ready bitmap */
+  SCHED_SLOT_WAIT,  /**< waiting for a producer */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Scheduler slot waiting for its source operands
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct sched_wait_s {
+  Counter m_cycle; /**< wakeup cycle (timer queue only) */
+  int     m_slot; /**< scheduler slot */
+  uop_c*  m_uop; /**< waiting uop */
+  Counter m_uop_num; /**< uop number of the waiting uop, to drop stale entries */
+
+  /**
+   * Order by wakeup cycle
+   */
+  bool operator>(const sched_wait_s& rhs) const { return m_cycle > rhs.m_cycle; }
+} sched_wait_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Producer without a known completion cycle and its waiting slots
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct sched_watch_s {
+  uop_c*               m_uop; /**< producer uop */
+  Counter              m_uop_num; /**< uop number of the producer */
+  vector<sched_wait_s> m_waiters; /**< slots to wake up on completion */
+} sched_watch_s;
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Instruction scheduler base class
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -164,6 +203,20 @@ class schedule_c
      *  \return void 
      */
     virtual bool is_running(void);
+
+    /**
+     * Cycle skipping : check whether the next cycle schedules nothing and moves no uop
+     * from the allocation queues (not supported by default)
+     * @param state - appended with the scheduler state that a stalled cycle does not change
+     * @param next_event - lowered to the cycle the stall ends, if known
+     * @return true if the next cycle is a stall
+     */
+    virtual bool check_stall(vector<Counter>* state, Counter* next_event) { return false; }
+
+    /**
+     * Cycle skipping : account stalled cycles (see check_stall) without running them
+     */
+    void skip_cycles(Counter num_cycles);
     
   protected:
     /**
@@ -188,6 +241,90 @@ class schedule_c
      */
     virtual void advance(int ALLOCQ_index);
 
+    /**
+     * Enable wakeup-based scheduling (sched_wakeup). Instead of polling every uop in the
+     * window, a uop whose operands are not ready sleeps until the cycle its producers
+     * complete; a producer without a known completion cycle (e.g. a cache miss) is
+     * watched and wakes its dependents once its done cycle is set. Ready slots are kept
+     * in a bitmap per issue port, in slot (age) order.
+     * @param num_slots - number of scheduler slots
+     * @param num_ports - number of issue ports
+     * @param list_slots - slots are schedule list indices, tracked by advance()
+     */
+    void init_wakeup(int num_slots, int num_ports, bool list_slots);
+
+    /**
+     * Get the uop held by a scheduler slot (NULL if empty)
+     */
+    virtual uop_c* get_slot_uop(int slot);
+
+    /**
+     * Start (or restart, after an operand failure) tracking the operands of a slot
+     */
+    void wakeup_track(int slot, int port);
+
+    /**
+     * Stop tracking a slot, after its uop has been scheduled
+     */
+    void wakeup_remove(int slot);
+
+    /**
+     * Wake up slots whose timer expired or whose producer completed
+     */
+    void process_wakeups(void);
+
+    /**
+     * Find the first ready slot of a port in the circular slot range [from, to)
+     * @return slot index, -1 if none
+     */
+    int next_ready_slot(int port, int from, int to);
+
+    /**
+     * Check whether a slot is waiting for its operands
+     */
+    bool is_slot_waiting(int slot) { return m_slot_state[slot] == SCHED_SLOT_WAIT; }
+
+    /**
+     * Cycle skipping : check whether an uop fails on its operands in a cycle, as
+     * uop_schedule() would, without changing any state
+     * @param next_event - lowered to the cycle an operand is ready, if known
+     */
+    bool is_operand_stalled(uop_c* uop, Counter cycle, Counter* next_event);
+
+    /**
+     * Cycle skipping : check whether advance() moves no uop into the scheduler
+     * @return true if no uop moves (the reads of the head uops are recorded)
+     */
+    bool check_advance_stall(void);
+
+    /**
+     * Cycle skipping : check whether no slot is ready or wakes up in a cycle (wakeup mode)
+     * @param next_event - lowered to the next timer expiry
+     */
+    bool is_wakeup_idle(Counter cycle, Counter* next_event);
+
+  private:
+    /**
+     * Put a slot into the ready bitmap, timer queue or producer watch list
+     */
+    void wakeup_eval(int slot, uop_c* uop);
+
+    /**
+     * Wake up a waiting slot if the entry is still current
+     */
+    void wakeup_waiter(const sched_wait_s& wait);
+
+    /**
+     * Find the cycle the sources of a uop become ready
+     * @return producer whose completion cycle is not known yet, NULL otherwise
+     */
+    uop_c* find_wakeup_src(uop_c* uop, Counter* cycle);
+
+    /**
+     * Find the first ready slot of a port in [from, to)
+     */
+    int next_ready_slot_linear(int port, int from, int to);
+
   protected:
     static const int MAX_SCHED_SIZE = 8192; /**< maximum scheduler table size */
 
@@ -210,6 +347,19 @@ class schedule_c
     int             m_first_schlist_ptr; /**< first index to sched list in OOO */
     int             m_last_schlist_ptr; /**< last index to sched list in OOO */
     uns16           m_knob_sched_to_width; /**< knob sched to width FIXME */
+    bool            m_stall_running; /**< stalled cycles run the scheduler */
+    int             m_stall_num_failed; /**< uops failing on operands per stalled cycle */
+    int             m_stall_num_peeked; /**< alloc queue heads read per stalled cycle */
+    int             m_stall_num_fp_peeked; /**< fp alloc queue heads read per stalled cycle */
+    bool            m_wakeup; /**< wakeup-based scheduling */
+    bool            m_wakeup_list_slots; /**< wakeup slots are schedule list indices */
+    int             m_wakeup_num_slots; /**< number of wakeup slots */
+    vector<vector<uns64>> m_ready_bits; /**< ready slot bitmap per issue port */
+    vector<uns8>    m_slot_state; /**< wakeup state per slot */
+    vector<int>     m_slot_port; /**< issue port per slot */
+    vector<sched_watch_s> m_wakeup_watch; /**< producers with unknown done cycle */
+    priority_queue<sched_wait_s, vector<sched_wait_s>, greater<sched_wait_s>>
+                    m_wakeup_timer; /**< slots waiting for a known cycle */
 
    macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
 
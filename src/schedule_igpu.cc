@@ -150,6 +150,7 @@ void schedule_igpu_c::advance(int q_index)
     // if the entry has been flushed
     if (cur_uop->m_bogus || (cur_uop->m_done_cycle) ) {
       cur_uop->m_done_cycle = (m_simBase->m_core_cycle[m_core_id]);
+      m_gpu_rob->uop_done(cur_uop);
       continue;
     }
 
@@ -70,6 +70,10 @@ schedule_io_c::schedule_io_c(int core_id, pqueue_c<int>** alloc_q, rob_c* rob,
   m_rob                      = rob;
   m_next_inorder_to_schedule = 0;
   m_simBase                  = simBase;
+
+  // wakeup slots are rob entries : only the next in-order uop is tracked
+  if (*KNOB(KNOB_SCHED_WAKEUP))
+    init_wakeup(m_rob->max_entries(), 1, false);
 }
 
 
@@ -91,6 +95,9 @@ void schedule_io_c::run_a_cycle(void)
   // clear execution ports
   m_exec->clear_ports();
 
+  if (m_wakeup)
+    process_wakeups();
+
   int count = 0;
   if (m_num_in_sched) {
     // iterate until we schedule knob width number of uops
@@ -99,6 +106,10 @@ void schedule_io_c::run_a_cycle(void)
       // uop invalid or not in scheduler yet
       if (uop == NULL || !uop->m_in_scheduler)
         break;
+
+      // still waiting for its producers
+      if (m_wakeup && is_slot_waiting(m_next_inorder_to_schedule))
+        break;
    
       SCHED_FAIL_TYPE sched_fail_reason;
       
@@ -106,8 +117,14 @@ void schedule_io_c::run_a_cycle(void)
       if (!uop_schedule(m_next_inorder_to_schedule, &sched_fail_reason)) {
         STAT_CORE_EVENT(m_core_id, SCHED_FAILED_REASON_SUCCESS +
             MIN2((int)sched_fail_reason, 6));
+
+        if (m_wakeup && sched_fail_reason == SCHED_FAIL_OPERANDS_NOT_READY)
+          wakeup_track(m_next_inorder_to_schedule, 0);
         break;
       }
+
+      if (m_wakeup)
+        wakeup_remove(m_next_inorder_to_schedule);
  
       STAT_CORE_EVENT(m_core_id, SCHED_FAILED_REASON_SUCCESS);  
 
@@ -138,3 +155,51 @@ void schedule_io_c::run_a_cycle(void)
     advance(ii);
 }
 
+
+
+// cycle skipping : the next cycle is a stall when the next in-order uop waits for its
+// operands and no uop moves from the allocation queues
+bool schedule_io_c::check_stall(vector<Counter>* state, Counter* next_event)
+{
+  m_stall_running    = false;
+  m_stall_num_failed = 0;
+
+  // Check if the schedule is running
+  if (!is_running())
+    return true;
+
+  Counter cycle = m_simBase->m_core_cycle[m_core_id] + 1;
+  state->push_back(m_next_inorder_to_schedule);
+  state->push_back(m_num_in_sched);
+
+  if (m_wakeup && !is_wakeup_idle(cycle, next_event))
+    return false;
+
+  if (m_num_in_sched) {
+    uop_c *uop = (*m_rob)[m_next_inorder_to_schedule];
+    if (uop != NULL && uop->m_in_scheduler && 
+        !(m_wakeup && is_slot_waiting(m_next_inorder_to_schedule))) {
+      // a failing uop starts waiting for its producers in wakeup mode
+      if (m_wakeup || !is_operand_stalled(uop, cycle, next_event))
+        return false;
+
+      m_stall_num_failed = 1;
+    }
+  }
+
+  m_stall_running = true;
+  state->push_back(m_stall_num_failed);
+
+  return check_advance_stall();
+}
+
+
+// get the uop in a rob slot (wakeup mode)
+uop_c* schedule_io_c::get_slot_uop(int slot)
+{
+  uop_c* uop = (*m_rob)[slot];
+  if (uop == NULL || !uop->m_in_scheduler)
+    return NULL;
+
+  return uop;
+}
@@ -79,6 +79,18 @@ class schedule_io_c : public schedule_c
      */
     void run_a_cycle();
 
+    /**
+     *  \brief Cycle skipping : check whether the next cycle is a stall
+     *  @see schedule_c::check_stall
+     */
+    bool check_stall(vector<Counter>* state, Counter* next_event);
+
+  private:
+    /**
+     *  \brief Get the uop in a rob slot, if it is in the scheduler
+     */
+    uop_c* get_slot_uop(int slot);
+
   private:
     int m_next_inorder_to_schedule; /**< index to rob for next uop to schedule */
 
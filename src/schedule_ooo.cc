@@ -65,6 +65,9 @@ schedule_ooo_c::schedule_ooo_c(int core_id, pqueue_c<int>** alloc_q, rob_c* rob,
 {
   m_rob = rob;
   m_simBase = simBase;
+
+  if (*KNOB(KNOB_SCHED_WAKEUP))
+    init_wakeup(MAX_SCHED_SIZE, 1, true);
 }
 
 
@@ -88,7 +91,14 @@ void schedule_ooo_c::run_a_cycle(void)
   m_exec->clear_ports();
 
   int count = 0;
-  if (m_num_in_sched) { 
+  if (m_num_in_sched && m_wakeup) {
+    count = schedule_ready_uops();
+
+    // no uop has been scheduled
+    if (count == 0) 
+      STAT_CORE_EVENT(m_core_id, NUM_NO_SCHED_CYCLE);
+  }
+  else if (m_num_in_sched) { 
     for (int i = m_first_schlist_ptr; i != m_last_schlist_ptr; i = (i + 1) % MAX_SCHED_SIZE) {
       if (m_schedule_list[i] != -1) {
         SCHED_FAIL_TYPE sched_fail_reason;
@@ -135,3 +145,96 @@ void schedule_ooo_c::run_a_cycle(void)
   }
 }
 
+
+// cycle skipping : the next cycle is a stall when every uop in the scheduler waits for
+// its operands and no uop moves from the allocation queues
+bool schedule_ooo_c::check_stall(vector<Counter>* state, Counter* next_event)
+{
+  m_stall_running    = false;
+  m_stall_num_failed = 0;
+
+  // Check if the schedule isn't running
+  if (!is_running())
+    return true;
+
+  Counter cycle = m_simBase->m_core_cycle[m_core_id] + 1;
+  state->push_back(m_first_schlist_ptr);
+  state->push_back(m_last_schlist_ptr);
+  state->push_back(m_num_in_sched);
+
+  if (m_num_in_sched) {
+    // leading empty slots are released
+    if (m_schedule_list[m_first_schlist_ptr] == -1)
+      return false;
+
+    if (m_wakeup) {
+      if (!is_wakeup_idle(cycle, next_event))
+        return false;
+    }
+    else {
+      for (int i = m_first_schlist_ptr; i != m_last_schlist_ptr; i = (i + 1) % MAX_SCHED_SIZE) {
+        if (m_schedule_list[i] == -1)
+          continue;
+
+        if (!is_operand_stalled((*m_rob)[m_schedule_list[i]], cycle, next_event))
+          return false;
+
+        ++m_stall_num_failed;
+      }
+    }
+  }
+
+  m_stall_running = true;
+  state->push_back(m_stall_num_failed);
+
+  return check_advance_stall();
+}
+
+
+// schedule uops from the ready bitmap, oldest first (wakeup mode)
+// uops waiting for their operands are not visited, but the selection and the
+// schedule list pointers are the same as in the full scan above
+int schedule_ooo_c::schedule_ready_uops(void)
+{
+  process_wakeups();
+
+  int count = 0;
+  int stop  = -1;
+  for (int i = next_ready_slot(0, m_first_schlist_ptr, m_last_schlist_ptr); i != -1;
+       i = next_ready_slot(0, (i + 1) % MAX_SCHED_SIZE, m_last_schlist_ptr)) {
+    SCHED_FAIL_TYPE sched_fail_reason;
+
+    // schedule un uop
+    if (uop_schedule(m_schedule_list[i], &sched_fail_reason)) {
+      STAT_CORE_EVENT(m_core_id, SCHED_FAILED_REASON_SUCCESS);
+
+      wakeup_remove(i);
+      m_schedule_list[i] = -1;
+      ++count;
+
+      // schedule enough uops, break it
+      if (m_knob_sched_to_width && count >= m_knob_width) {
+        stop = i;
+        break;
+      }
+    }
+    else {
+      STAT_CORE_EVENT(m_core_id, 
+          SCHED_FAILED_REASON_SUCCESS + MIN2(sched_fail_reason, 6));
+
+      if (sched_fail_reason == SCHED_FAIL_OPERANDS_NOT_READY)
+        wakeup_track(i, 0);
+    }
+  }
+
+  // release leading empty slots up to where the scan stopped
+  while (m_first_schlist_ptr != m_last_schlist_ptr && 
+         m_schedule_list[m_first_schlist_ptr] == -1) {
+    bool last = (m_first_schlist_ptr == stop);
+    m_first_schlist_ptr = (m_first_schlist_ptr + 1) % MAX_SCHED_SIZE;
+    if (last)
+      break;
+  }
+
+  return count;
+}
@@ -75,6 +75,19 @@ class schedule_ooo_c : public schedule_c
      */
     void run_a_cycle();
 
+    /**
+     *  \brief Cycle skipping : check whether the next cycle is a stall
+     *  @see schedule_c::check_stall
+     */
+    bool check_stall(vector<Counter>* state, Counter* next_event);
+
+  private:
+    /**
+     *  \brief Schedule uops from the ready bitmap (wakeup mode)
+     *  \return int - number of scheduled uops
+     */
+    int schedule_ready_uops(void);
+
   private:
      macsim_c* m_simBase;         /**< macsim_c base class for simulation globals */
    
@@ -118,6 +118,10 @@ schedule_smc_c::schedule_smc_c(int core_id, pqueue_c<gpu_allocq_entry_s>** gpu_a
     factor * uop_dispatch_latency_ptx[i].m_latency;
   }
   m_next_sched_id = 0;
+
+  // wakeup slots are schedule list indices, one ready bitmap per warp scheduler
+  if (*KNOB(KNOB_SCHED_WAKEUP))
+    init_wakeup(m_schlist_size, *KNOB(KNOB_NUM_WARP_SCHEDULER), false);
 }
 
 
@@ -178,6 +182,7 @@ void schedule_smc_c::advance(int q_index) {
     // if the entry has been flushed
     if (cur_uop->m_bogus || (cur_uop->m_done_cycle) ) {
       cur_uop->m_done_cycle = (m_simBase->m_core_cycle[m_core_id]);
+      m_gpu_rob->uop_done(cur_uop);
       continue;
     }
 
@@ -191,7 +196,17 @@ void schedule_smc_c::advance(int q_index) {
     int entry = allocq_entry.m_rob_entry;
 
     m_schlist_entry[m_last_schlist] = entry;
-    m_schlist_tid[m_last_schlist++] = tid;
+    m_schlist_tid[m_last_schlist] = tid;
+
+    // only the oldest uop of a thread can be scheduled
+    if (m_wakeup) {
+      queue<int>& slots = m_thread_slots[tid];
+      slots.push(m_last_schlist);
+      if (slots.size() == 1)
+        wakeup_track(m_last_schlist, tid % *KNOB(KNOB_NUM_WARP_SCHEDULER));
+    }
+
+    ++m_last_schlist;
     m_last_schlist %= m_schlist_size;
     ++m_num_in_sched;
     ++m_num_per_sched[allocq];
@@ -426,6 +441,9 @@ void schedule_smc_c::run_a_cycle(void)
   // clear execution port
   m_exec->clear_ports(); 
 
+  if (m_wakeup)
+    process_wakeups();
+
 
   // GPU : recent GPUs have dual warp schedulers. In each schedule cycle, each warp scheduler
   // can schedule instructions from different threads. We enforce threads selected by
@@ -438,6 +456,12 @@ void schedule_smc_c::run_a_cycle(void)
     if (m_dispatch_busy_cycle[sched_id] > m_cur_core_cycle) {
       continue;
     }
+    if (m_wakeup) {
+      if (schedule_ready_uop(sched_id))
+        ++count;
+      continue;
+    }
+
     round_count = 0;
   for (int ii = m_first_schlist; ii != m_last_schlist; ii = (ii + 1) % m_schlist_size) {
     // -------------------------------------
@@ -628,6 +652,86 @@ void schedule_smc_c::run_a_cycle(void)
 }
 #endif
 
+// schedule the oldest ready thread head of a warp scheduler (wakeup mode)
+// thread heads waiting for their operands are not visited, but the selection and
+// the schedule list pointers are the same as in the full scan of run_a_cycle
+bool schedule_smc_c::schedule_ready_uop(int sched_id)
+{
+  if (!m_num_in_sched || m_first_schlist == m_last_schlist)
+    return false;
+
+  int stop = -1;
+  for (int ii = next_ready_slot(sched_id, m_first_schlist, m_last_schlist); ii != -1;
+       ii = next_ready_slot(sched_id, (ii + 1) % m_schlist_size, m_last_schlist)) {
+    int thread_id = m_schlist_tid[ii];
+    int entry     = m_schlist_entry[ii];
+
+    rob_c *thread_m_rob = m_gpu_rob->get_thread_rob(thread_id);
+    uop_c *cur_uop = (*thread_m_rob)[entry];
+
+    bool sfu_inst = is_sfu_inst(cur_uop);
+    if (sfu_inst && m_sfu_dispatch_busy_cycle > m_cur_core_cycle) {
+      continue;
+    }
+
+    SCHED_FAIL_TYPE sched_fail_reason;
+    if (!uop_schedule_smc(thread_id, entry, &sched_fail_reason)) {
+      STAT_CORE_EVENT(m_core_id, 
+          SCHED_FAILED_REASON_SUCCESS + MIN2(sched_fail_reason, 6));
+
+      if (sched_fail_reason == SCHED_FAIL_OPERANDS_NOT_READY)
+        wakeup_track(ii, sched_id);
+      continue;
+    }
+
+    STAT_CORE_EVENT(m_core_id, SCHED_FAILED_REASON_SUCCESS);
+
+    wakeup_remove(ii);
+    m_schlist_entry[ii] = -1;
+    m_schlist_tid[ii] = -1;
+
+    if (sfu_inst) {
+      m_sfu_dispatch_busy_cycle = m_cur_core_cycle + m_dispatch_latency[cur_uop->m_uop_type];
+    }
+    else {
+      m_dispatch_busy_cycle[sched_id] = m_cur_core_cycle + m_dispatch_latency[cur_uop->m_uop_type];
+    }
+
+    // the next uop of the thread becomes its head
+    auto slots = m_thread_slots.find(thread_id);
+    slots->second.pop();
+    if (slots->second.empty())
+      m_thread_slots.erase(slots);
+    else
+      wakeup_track(slots->second.front(), sched_id);
+
+    stop = ii;
+    break;
+  }
+
+  // release leading empty slots up to where the scan stopped
+  while (m_first_schlist != m_last_schlist && m_schlist_entry[m_first_schlist] == -1) {
+    bool last = (m_first_schlist == stop);
+    m_first_schlist = (m_first_schlist + 1) % m_schlist_size;
+    if (last)
+      break;
+  }
+
+  return stop != -1;
+}
+
+
+// get the uop in a schedule list slot (wakeup mode)
+uop_c* schedule_smc_c::get_slot_uop(int slot)
+{
+  if (m_schlist_entry[slot] == -1)
+    return NULL;
+
+  rob_c *thread_m_rob = m_gpu_rob->get_thread_rob(m_schlist_tid[slot]);
+  return (*thread_m_rob)[m_schlist_entry[slot]];
+}
+
+
 bool schedule_smc_c::is_sfu_inst(uop_c *uop) {
   if (uop->m_uop_type == UOP_GPU_FCOS ||
       uop->m_uop_type == UOP_GPU_FEX2 || 
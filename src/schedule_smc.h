@@ -110,6 +110,20 @@ class schedule_smc_c : public schedule_c
      */
     bool is_sfu_inst(uop_c *uop);
 
+    /*! \fn bool schedule_ready_uop(int sched_id)
+     *  \brief Function to schedule a uop from the ready bitmap (wakeup mode)
+     *  \param sched_id - Warp scheduler id
+     *  \return bool - True if a uop has been scheduled
+     */
+    bool schedule_ready_uop(int sched_id);
+
+    /*! \fn uop_c* get_slot_uop(int slot)
+     *  \brief Function to get the uop in a schedule list slot
+     *  \param slot - Schedule list index
+     *  \return uop_c* - Uop in the slot, NULL if empty
+     */
+    uop_c* get_slot_uop(int slot);
+
   private:
     static const int MAX_GPU_SCHED_SIZE = 128; /**< max sched table size */
 
@@ -127,6 +141,7 @@ class schedule_smc_c : public schedule_c
     Counter m_sfu_dispatch_busy_cycle; /**<track when a SFU instruction can be dispatched */
     int m_dispatch_latency[NUM_UOP_TYPES]; /**<dispatch latency of different instructions */
     int m_next_sched_id; /**<id of warp scheduler for which instructions will be scheduled next */
+    unordered_map<int, queue<int>> m_thread_slots; /**< schedule list slots per thread (wakeup mode) */
 
     macsim_c* m_simBase; /**< macsim_c base class for simulation globals */
    
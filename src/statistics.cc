@@ -36,6 +36,8 @@ POSSIBILITY OF SUCH DAMAGE.
  *********************************************************************************************/
 
 
+#include <cstdlib>
+#include <cstring>
 #include <stdio.h>
 #include <unistd.h>
 #include <sys/stat.h>
@@ -44,6 +46,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "all_knobs.h"
 #include "macsim.h"
+#include "sampling.h"
 #include "statistics.h"
 
 using namespace std;
@@ -51,6 +54,105 @@ using namespace std;
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
+bool AbstractStat::m_sharded = false;
+thread_local unsigned long long* AbstractStat::m_shard = NULL;
+int AbstractStat::m_num_shard = 0;
+
+
+/** Bytes per cache line */
+#define STAT_SHARD_ALIGN 64
+
+
+/** Stat of each counter index (NULL after the stat is destroyed) */
+static vector<AbstractStat*> g_slot_stat;
+
+/** Counter blocks of host threads with their number of counters */
+static vector<pair<unsigned long long*, unsigned> > g_shard;
+
+
+// assign a counter index to a new stat
+unsigned AbstractStat::registerSlot(AbstractStat* pStat)
+{
+  g_slot_stat.push_back(pStat);
+  return g_slot_stat.size() - 1;
+}
+
+
+// release the counter index of a stat
+void AbstractStat::unregisterSlot(unsigned slot)
+{
+  g_slot_stat[slot] = NULL;
+}
+
+
+// sum of a counter over all shards
+unsigned long long AbstractStat::getShardedCount(unsigned slot)
+{
+  unsigned long long count = 0;
+  for (auto itr = g_shard.begin(), end = g_shard.end(); itr != end; ++itr) {
+    if (slot < itr->second)
+      count += __atomic_load_n(&itr->first[slot], __ATOMIC_RELAXED);
+  }
+  return count;
+}
+
+
+// allocate a counter block; blocks are padded to whole cache lines, so that host threads
+// never share a line
+unsigned long long* AbstractStat::newShard(void)
+{
+  unsigned num_slot = g_slot_stat.size();
+  size_t size = num_slot * sizeof(unsigned long long);
+  size = (size + STAT_SHARD_ALIGN - 1) / STAT_SHARD_ALIGN * STAT_SHARD_ALIGN;
+  if (size == 0)
+    size = STAT_SHARD_ALIGN;
+
+  unsigned long long* shard =
+    static_cast<unsigned long long*>(aligned_alloc(STAT_SHARD_ALIGN, size));
+  memset(shard, 0, size);
+
+  g_shard.push_back(make_pair(shard, num_slot));
+  m_num_shard = g_shard.size();
+
+  return shard;
+}
+
+
+// merge a counter block into the stats and release it
+void AbstractStat::deleteShard(unsigned long long* shard)
+{
+  mergeShards();
+
+  for (auto itr = g_shard.begin(), end = g_shard.end(); itr != end; ++itr) {
+    if (itr->first == shard) {
+      g_shard.erase(itr);
+      break;
+    }
+  }
+  m_num_shard = g_shard.size();
+
+  free(shard);
+}
+
+
+// merge all counter blocks into the stats
+void AbstractStat::mergeShards(void)
+{
+  for (auto itr = g_shard.begin(), end = g_shard.end(); itr != end; ++itr) {
+    for (unsigned slot = 0; slot < itr->second; ++slot) {
+      if (itr->first[slot] == 0)
+        continue;
+
+      if (g_slot_stat[slot] != NULL)
+        g_slot_stat[slot]->m_count += itr->first[slot];
+      itr->first[slot] = 0;
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
 // get the output stream
 ofstream* getOutputStream(const string& filename, macsim_c* m_simBase)
 {
@@ -470,6 +572,9 @@ void ProcessorStatistics::saveStats(string ext)
   //if (chdir(Path) != 0)
   //  exit(0);
 
+  // fold counts of host threads into the stats
+  AbstractStat::mergeShards();
+
   // svae global statistics
   m_globalStatistics->saveStats(ext);
 
@@ -484,6 +589,10 @@ void ProcessorStatistics::saveStats(string ext)
 
     iterCoreStats++;
   }
+
+  // save per-sample statistics
+  if (m_simBase->m_sampling)
+    m_simBase->m_sampling->print_stats(ext);
 }
 
 
@@ -112,12 +112,18 @@ class AbstractStat
         bool corewide = false, bool isTemplate = true):
       m_pRatioStat(NULL), m_count(0), m_total_count(0), m_ID(ID),
       m_coreID(0), m_name(str), m_fileName(outputfilename), m_suffix(""),
-      m_bCoreWide(corewide), m_isTemplate(isTemplate) {}
+      m_bCoreWide(corewide), m_isTemplate(isTemplate)
+    {
+      m_slot = registerSlot(this);
+    }
 
     /**
      * Destructor.
      */
-    virtual ~AbstractStat() {}
+    virtual ~AbstractStat()
+    {
+      unregisterSlot(m_slot);
+    }
 
     /**
      * Clone a stat.
@@ -167,7 +173,7 @@ class AbstractStat
      */
     inline void inc()
     {
-      m_count += 1;
+      add(1);
     }
 
     /**
@@ -175,7 +181,7 @@ class AbstractStat
      */
     inline void inc(unsigned int delta)
     {
-      m_count += delta;
+      add(delta);
     }
 
     /**
@@ -183,7 +189,7 @@ class AbstractStat
      */
     inline void operator++(int)
     {
-      m_count += 1;
+      add(1);
     }
 
     /**
@@ -191,7 +197,7 @@ class AbstractStat
      */
     inline void operator--(int)
     {
-      m_count -= 1;
+      add(-1ULL);
     }
 
     /**
@@ -199,17 +205,49 @@ class AbstractStat
      */
     inline void operator+=(unsigned int delta)
     {
-      m_count += delta;
+      add(delta);
+    }
+
+    /**
+     * Add to the counter. While cores are stepped on multiple host threads, the counter
+     * block of the current host thread is updated instead (no sharing between threads).
+     */
+    inline void add(unsigned long long delta)
+    {
+      if (m_sharded) {
+        unsigned long long* counter = &m_shard[m_slot];
+        __atomic_store_n(counter, *counter + delta, __ATOMIC_RELAXED);
+      }
+      else {
+        m_count += delta;
+      }
     }
 
     /**
-     * Get the value of the counter.
+     * Get the value of the counter (including counts not yet merged from shards).
      */
     inline unsigned long long getCount()
     {
-      return m_count;
+      if (m_num_shard == 0)
+        return m_count;
+      return m_count + getShardedCount(m_slot);
     }
 
+    /**
+     * Allocate a (cache line aligned) counter block for a host thread
+     */
+    static unsigned long long* newShard(void);
+
+    /**
+     * Merge a counter block into the stats and release it
+     */
+    static void deleteShard(unsigned long long* shard);
+
+    /**
+     * Merge all counter blocks into the stats
+     */
+    static void mergeShards(void);
+
     /**
      * Dump out all stats to the file.
      */
@@ -236,6 +274,28 @@ class AbstractStat
     string m_suffix; /**< stat suffix */
     bool m_bCoreWide; /**< when set, add suffix to the name of a stat */
     bool m_isTemplate; /**< is template */
+    unsigned m_slot; /**< counter index in the shards */
+
+  private:
+    /**
+     * Assign a counter index to a new stat
+     */
+    static unsigned registerSlot(AbstractStat* pStat);
+
+    /**
+     * Release the counter index of a stat
+     */
+    static void unregisterSlot(unsigned slot);
+
+    /**
+     * Sum of a counter over all shards
+     */
+    static unsigned long long getShardedCount(unsigned slot);
+
+  public:
+    static bool m_sharded; /**< update the counter blocks of host threads */
+    static thread_local unsigned long long* m_shard; /**< counter block of this host thread */
+    static int m_num_shard; /**< number of counter blocks */
 };
 
 
@@ -697,9 +757,14 @@ class PER_1000_INST_Stat : public AbstractStat
   public:
     /**
      * Constructor.
+     * @param InstID - stat holding the instruction count
      */
-    PER_1000_INST_Stat(const string& str, const string& outputfilename, long ID):
-      AbstractStat(str, outputfilename, ID) {}
+    PER_1000_INST_Stat(const string& str, const string& outputfilename, long ID,
+                       long InstID, ProcessorStatistics* procStat):
+      AbstractStat(str, outputfilename, ID), m_InstID(InstID)
+    {
+      m_ProcStat = procStat;
+    }
 
     /**
      * Destructor.
@@ -713,7 +778,8 @@ class PER_1000_INST_Stat : public AbstractStat
      */
     virtual AbstractStat* clone(unsigned int coreID)
     {
-      PER_1000_INST_Stat* pStat = new PER_1000_INST_Stat(m_name, m_fileName, m_ID);
+      PER_1000_INST_Stat* pStat = new PER_1000_INST_Stat(m_name, m_fileName, m_ID, m_InstID,
+                                                         m_ProcStat);
       pStat->setCoreID(coreID);
       pStat->m_isTemplate = false;
       return pStat;
@@ -724,22 +790,36 @@ class PER_1000_INST_Stat : public AbstractStat
      */
     virtual void writeTo(ofstream& stream)
     {
-      unsigned int numInstructions = getInstructionCount();
-      float ratio = (float)m_count / (float)numInstructions;
-      per_1000_inst_value = 1000 * ratio;
-
       string name = m_name;
-      name.append(m_suffix);
+      unsigned long long numInstructions;
+      if (m_bCoreWide) {
+        name.append(m_suffix);
+        numInstructions = getCoreWideStat(m_coreID, m_InstID, m_ProcStat).getCount();
+      }
+      else {
+        numInstructions = getGlobalStat(m_InstID, m_ProcStat).getCount();
+      }
+
       stream.setf(ios::left, ios::adjustfield);
       stream << setw(FILED1_LENGTH) << name;
 
       stream.setf (ios::right, ios::adjustfield);
       stream << setw(FILED2_LENGTH) << m_count;
-      stream << setw(FILED3_LENGTH) << per_1000_inst_value << endl << endl;
+      stream << setw(FILED3_LENGTH);
+
+      if (numInstructions) {
+        per_1000_inst_value = 1000 * ((float)m_count / (float)numInstructions);
+        stream << per_1000_inst_value << endl << endl;
+      }
+      else {
+        stream << "NaN" << endl << endl;
+      }
     }
 
   private:
+    long m_InstID; /**< instruction count stat id */
     float per_1000_inst_value; /**< per 1000 instruction value */
+    ProcessorStatistics* m_ProcStat; /**< reference to simulation-scoped processor stats */
 };
 
 
@@ -963,6 +1043,14 @@ class CoreStatistics
       return (*pStat);
     }
 
+    /**
+     * Return number of core stats.
+     */
+    int size() const
+    {
+      return m_CoreStats.size();
+    }
+
     /**
      * Make a clone stats for the core.
      */
@@ -1085,6 +1173,14 @@ class ProcessorStatistics
      */
     void setNumCores(unsigned int numCores);
 
+    /**
+     * Get number of cores.
+     */
+    unsigned int getNumCores(void) const
+    {
+      return m_allCoresStats.size();
+    }
+
     /**
      * Print all stats after the simulation.
      * @param ext extension to the stat.out file
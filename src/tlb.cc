@@ -35,6 +35,7 @@ POSSIBILITY OF SUCH DAMAGE.
  *********************************************************************************************/
 
 #include "tlb.h"
+#include "checkpoint.h"
 #include "debug_macros.h"
 #include "assert_macros.h"
 #include "all_knobs.h"
@@ -146,4 +147,25 @@ void TLB::invalidate(Addr page_number)
     m_table.erase(page_number);
     DEBUG("page:%llx invalidated - free_entries:%zu\n", page_number, m_free_entries.size());
   }
-}
\ No newline at end of file
+}
+
+void TLB::checkpoint(checkpoint_c *ckpt)
+{
+  uint64_t num_entries = m_table.size();
+  ckpt->io(num_entries);
+
+  if (ckpt->is_saving()) {
+    for (Entry *node = m_tail->prev; node != m_head; node = node->prev) {
+      ckpt->io(node->page_number);
+      ckpt->io(node->page_desc.frame_number);
+    }
+  } else {
+    ASSERT(m_table.empty());
+    for (uint64_t i = 0; i < num_entries; ++i) {
+      Addr page_number, frame_number;
+      ckpt->io(page_number);
+      ckpt->io(frame_number);
+      insert(page_number << m_offset_bits, frame_number);
+    }
+  }
+}
@@ -72,6 +72,7 @@ public:
   Addr translate(Addr addr);
   void insert(Addr addr, Addr frame_number);
   void invalidate(Addr page_number);
+  void checkpoint(checkpoint_c *ckpt); // entries are saved in LRU to MRU order
 
 private:
   void detach(Entry *node)
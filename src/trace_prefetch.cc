@@ -0,0 +1,611 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : trace_prefetch.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : trace file access (asynchronous prefetch, memory-mapped traces)
+ *********************************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "trace_prefetch.h"
+#include "trace_read.h"
+#include "macsim.h"
+#include "statistics.h"
+#include "assert_macros.h"
+#include "debug_macros.h"
+
+#include "all_knobs.h"
+
+
+trace_file_c::trace_file_c(macsim_c* simBase)
+  : m_simBase(simBase)
+{
+  m_prefetcher  = NULL;
+  m_file        = NULL;
+  m_map         = NULL;
+  m_map_size    = 0;
+  m_map_pos     = 0;
+  m_record_size = 0;
+  m_num_records = 0;
+  m_stream      = NULL;
+  m_raw         = NULL;
+  m_raw_buf     = NULL;
+  m_stream_end  = false;
+  m_base        = 0;
+  m_produced    = 0;
+
+  // one more chunk is retained for unread()
+  m_num_slots = *KNOB(KNOB_TRACE_PREFETCH_DEPTH);
+  if (m_num_slots > 0)
+    ++m_num_slots;
+
+  // a chunk has the size of the thread trace buffer (see thread_s)
+  int rec_size = (CPU_TRACE_SIZE > GPU_TRACE_SIZE) ? CPU_TRACE_SIZE : GPU_TRACE_SIZE;
+  m_chunk_size = 1000 * rec_size;
+
+  // chunk buffers are allocated on their first use
+  m_chunk.resize(m_num_slots, NULL);
+  m_chunk_bytes.resize(m_num_slots, 0);
+
+  m_head    = 0;
+  m_tail    = 0;
+  m_eof     = false;
+  m_cur     = 0;
+  m_pos     = 0;
+  m_started = false;
+}
+
+
+trace_file_c::~trace_file_c()
+{
+  close();
+  for (auto itr = m_chunk.begin(); itr != m_chunk.end(); ++itr)
+    delete[] *itr;
+}
+
+
+bool trace_file_c::open(const string& filename)
+{
+  ASSERT(m_file == NULL && m_map == NULL);
+
+  if (open_mapped(filename)) {
+    m_filename = filename;
+    STAT_EVENT(TRACE_FILE_MAPPED);
+    return true;
+  }
+
+  m_file = gzopen(filename.c_str(), "r");
+  if (m_file == NULL)
+    return false;
+
+  m_filename = filename;
+  m_head     = 0;
+  m_tail     = 0;
+  m_eof      = false;
+  m_cur      = 0;
+  m_pos      = 0;
+  m_started  = false;
+  m_base     = 0;
+  m_produced = 0;
+
+  open_index(filename);
+
+  if (m_num_slots > 0 && m_simBase->m_trace_prefetcher) {
+    m_prefetcher = m_simBase->m_trace_prefetcher;
+    m_prefetcher->add(this);
+  }
+
+  return true;
+}
+
+
+bool trace_file_c::open_mapped(const string& filename)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+    return false;
+
+  trace_file_header_s header;
+  struct stat file_stat;
+  bool mapped = false;
+  if (::read(fd, &header, sizeof(header)) == sizeof(header) &&
+      memcmp(header.m_magic, TRACE_FILE_MAGIC, sizeof(header.m_magic)) == 0 &&
+      fstat(fd, &file_stat) == 0) {
+    ASSERTM(header.m_version == TRACE_FILE_VERSION, "trace file %s : unsupported version %u\n",
+        filename.c_str(), header.m_version);
+
+    m_map_size = sizeof(header) + header.m_num_records * header.m_record_size;
+    ASSERTM(static_cast<size_t>(file_stat.st_size) >= m_map_size,
+        "trace file %s is truncated\n", filename.c_str());
+
+    void* map = mmap(NULL, m_map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ASSERTM(map != MAP_FAILED, "cannot map trace file %s\n", filename.c_str());
+    madvise(map, m_map_size, MADV_SEQUENTIAL);
+
+    m_map         = static_cast<char*>(map);
+    m_map_pos     = sizeof(header);
+    m_record_size = header.m_record_size;
+    m_num_records = header.m_num_records;
+    mapped        = true;
+  }
+
+  ::close(fd);
+  return mapped;
+}
+
+
+void trace_file_c::open_index(const string& filename)
+{
+  string index_filename = filename + ".idx";
+  FILE* file = fopen(index_filename.c_str(), "rb");
+  if (file == NULL)
+    return;
+
+  trace_index_header_s header;
+  struct stat file_stat;
+  if (fread(&header, sizeof(header), 1, file) == 1 &&
+      memcmp(header.m_magic, TRACE_INDEX_MAGIC, sizeof(header.m_magic)) == 0 &&
+      stat(filename.c_str(), &file_stat) == 0) {
+    ASSERTM(header.m_version == TRACE_INDEX_VERSION, "trace index %s : unsupported version %u\n",
+        index_filename.c_str(), header.m_version);
+
+    // an index of an older trace is ignored
+    if (header.m_file_size != static_cast<uint64_t>(file_stat.st_size)) {
+      report("trace index " << index_filename << " does not match the trace (ignored)");
+    }
+    else if (header.m_num_points > 0) {
+      m_index.resize(header.m_num_points);
+      ASSERTM(fread(&m_index[0], sizeof(trace_index_point_s), header.m_num_points, file) ==
+          header.m_num_points && m_index[0].m_out == 0, "trace index %s is truncated\n",
+          index_filename.c_str());
+
+      m_record_size = header.m_record_size;
+      m_num_records = header.m_num_records;
+      STAT_EVENT(TRACE_FILE_INDEXED);
+    }
+  }
+
+  fclose(file);
+}
+
+
+void trace_file_c::close(void)
+{
+  if (m_map) {
+    munmap(m_map, m_map_size);
+    m_map         = NULL;
+    m_record_size = 0;
+    m_num_records = 0;
+    return;
+  }
+
+  if (m_file == NULL)
+    return;
+
+  if (m_prefetcher) {
+    m_prefetcher->remove(this);
+    m_prefetcher = NULL;
+  }
+
+  // wait for a fill in progress
+  lock_guard<mutex> lock(m_mutex);
+  gzclose(m_file);
+  m_file = NULL;
+
+  if (m_stream) {
+    inflateEnd(m_stream);
+    delete m_stream;
+    m_stream = NULL;
+
+    fclose(m_raw);
+    m_raw = NULL;
+
+    delete[] m_raw_buf;
+    m_raw_buf = NULL;
+  }
+
+  m_index.clear();
+  m_record_size = 0;
+  m_num_records = 0;
+}
+
+
+// the window of an access point is read from the index file when decompression restarts there
+void trace_file_c::start_stream(size_t point)
+{
+  const trace_index_point_s& here = m_index[point];
+
+  if (m_stream == NULL) {
+    m_stream = new z_stream;
+    memset(m_stream, 0, sizeof(z_stream));
+    ASSERTM(inflateInit2(m_stream, -15) == Z_OK, "cannot decompress %s\n", m_filename.c_str());
+
+    m_raw = fopen(m_filename.c_str(), "rb");
+    ASSERTM(m_raw, "cannot open trace file %s\n", m_filename.c_str());
+
+    m_raw_buf = new char[TRACE_INDEX_WINDOW];
+  }
+  else {
+    inflateReset(m_stream);
+  }
+
+  // the access point may start in the middle of a byte
+  ASSERTM(fseeko(m_raw, here.m_in - (here.m_bits ? 1 : 0), SEEK_SET) == 0,
+      "cannot seek in trace file %s\n", m_filename.c_str());
+  if (here.m_bits) {
+    int value = getc(m_raw);
+    ASSERTM(value != EOF, "trace file %s is truncated\n", m_filename.c_str());
+    inflatePrime(m_stream, here.m_bits, value >> (8 - here.m_bits));
+  }
+
+  string index_filename = m_filename + ".idx";
+  FILE* index = fopen(index_filename.c_str(), "rb");
+  ASSERTM(index && fseeko(index, sizeof(trace_index_header_s) +
+        m_index.size() * sizeof(trace_index_point_s) + point * TRACE_INDEX_WINDOW, SEEK_SET) == 0 &&
+      fread(m_raw_buf, TRACE_INDEX_WINDOW, 1, index) == 1,
+      "cannot read trace index %s\n", index_filename.c_str());
+  fclose(index);
+  inflateSetDictionary(m_stream, reinterpret_cast<Bytef*>(m_raw_buf), TRACE_INDEX_WINDOW);
+
+  m_stream->avail_in = 0;
+  m_stream_end       = false;
+
+  // restart the chunk ring at the access point
+  m_head     = 0;
+  m_tail     = 0;
+  m_eof      = false;
+  m_cur      = 0;
+  m_pos      = 0;
+  m_started  = false;
+  m_base     = here.m_out;
+  m_produced = 0;
+}
+
+
+int trace_file_c::decompress(void* buf, int size)
+{
+  int bytes;
+  if (m_stream == NULL) {
+    bytes = gzread(m_file, buf, size);
+    if (bytes < 0)
+      bytes = 0;
+  }
+  else {
+    m_stream->next_out  = static_cast<Bytef*>(buf);
+    m_stream->avail_out = size;
+    while (m_stream->avail_out > 0 && !m_stream_end) {
+      if (m_stream->avail_in == 0) {
+        m_stream->avail_in = fread(m_raw_buf, 1, TRACE_INDEX_WINDOW, m_raw);
+        m_stream->next_in  = reinterpret_cast<Bytef*>(m_raw_buf);
+        if (m_stream->avail_in == 0)
+          break;
+      }
+
+      int result = inflate(m_stream, Z_NO_FLUSH);
+      ASSERTM(result == Z_OK || result == Z_STREAM_END, "trace file %s is corrupted\n",
+          m_filename.c_str());
+      if (result == Z_STREAM_END)
+        m_stream_end = true;
+    }
+    bytes = size - m_stream->avail_out;
+  }
+
+  m_produced += bytes;
+  return bytes;
+}
+
+
+bool trace_file_c::fill(void)
+{
+  if (m_file == NULL || m_eof || m_head - m_tail >= static_cast<uint64_t>(m_num_slots))
+    return false;
+
+  uint64_t head = m_head;
+  int slot = head % m_num_slots;
+  if (m_chunk[slot] == NULL)
+    m_chunk[slot] = new char[m_chunk_size];
+
+  // a short chunk is the last one
+  int bytes = decompress(m_chunk[slot], m_chunk_size);
+  if (bytes < m_chunk_size)
+    m_eof = true;
+  m_chunk_bytes[slot] = bytes;
+
+  // publish the chunk
+  m_head = head + 1;
+
+  return true;
+}
+
+
+bool trace_file_c::next_chunk(void)
+{
+  if (m_head > m_cur)
+    return true;
+
+  // the prefetch thread has not caught up : decompress the chunk here
+  // (depends on host timing, hence not a stat)
+  if (m_prefetcher)
+    m_prefetcher->stall();
+
+  lock_guard<mutex> lock(m_mutex);
+  if (m_head <= m_cur)
+    fill();
+
+  return m_head > m_cur;
+}
+
+
+int trace_file_c::read(void* buf, int size)
+{
+  if (m_map) {
+    size_t count = min(static_cast<size_t>(size), m_map_size - m_map_pos);
+    memcpy(buf, m_map + m_map_pos, count);
+    m_map_pos += count;
+    return count;
+  }
+
+  if (m_num_slots == 0)
+    return decompress(buf, size);
+
+  char* dst = static_cast<char*>(buf);
+  int done = 0;
+  while (done < size) {
+    if (!m_started) {
+      if (!next_chunk())
+        break;
+      m_started = true;
+      STAT_EVENT(TRACE_PREFETCH_CHUNK);
+    }
+
+    int slot  = m_cur % m_num_slots;
+    int avail = m_chunk_bytes[slot] - m_pos;
+    if (avail == 0) {
+      if (m_chunk_bytes[slot] < m_chunk_size)
+        break;
+
+      // move to the next chunk and release all but the previous one
+      ++m_cur;
+      m_pos     = 0;
+      m_started = false;
+      m_tail    = m_cur - 1;
+      if (m_prefetcher)
+        m_prefetcher->notify();
+      continue;
+    }
+
+    int count = min(avail, size - done);
+    memcpy(dst + done, m_chunk[slot] + m_pos, count);
+    m_pos += count;
+    done  += count;
+  }
+
+  return done;
+}
+
+
+bool trace_file_c::unread(int size)
+{
+  if (m_map) {
+    if (m_map_pos < sizeof(trace_file_header_s) + size)
+      return false;
+    m_map_pos -= size;
+    return true;
+  }
+
+  if (m_num_slots == 0) {
+    if (m_stream)
+      return tell() >= static_cast<uint64_t>(size) && seek(tell() - size);
+
+    if (gzseek(m_file, -1 * size, SEEK_CUR) == -1)
+      return false;
+    m_produced -= size;
+    return true;
+  }
+
+  if (size <= m_pos) {
+    m_pos -= size;
+    return true;
+  }
+
+  // step back into the retained chunk (completely consumed, hence full)
+  int remain = size - m_pos;
+  if (m_cur == 0 || m_tail >= m_cur || remain > m_chunk_size)
+    return false;
+
+  --m_cur;
+  m_pos     = m_chunk_size - remain;
+  m_started = true;
+
+  return true;
+}
+
+
+void trace_file_c::restart(void)
+{
+  if (m_map) {
+    m_map_pos = sizeof(trace_file_header_s);
+    return;
+  }
+
+  if (m_num_slots == 0 && m_stream == NULL) {
+    gzrewind(m_file);
+    m_produced = 0;
+    return;
+  }
+
+  string filename = m_filename;
+  close();
+  open(filename);
+}
+
+
+bool trace_file_c::seek(uint64_t offset)
+{
+  if (m_map) {
+    if (offset > m_map_size - sizeof(trace_file_header_s))
+      return false;
+    m_map_pos = sizeof(trace_file_header_s) + offset;
+    return true;
+  }
+
+  if (m_file == NULL || m_index.empty() || offset > m_num_records * m_record_size)
+    return false;
+
+  // restart at the last access point before the offset, unless the read position is closer
+  auto point = upper_bound(m_index.begin(), m_index.end(), offset, 
+      [] (uint64_t value, const trace_index_point_s& here) { return value < here.m_out; });
+  --point;
+
+  uint64_t pos = tell();
+  if (offset < pos || point->m_out > pos) {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      start_stream(point - m_index.begin());
+    }
+    if (m_prefetcher)
+      m_prefetcher->notify();
+
+    pos = point->m_out;
+    STAT_EVENT(TRACE_INDEX_SEEK);
+  }
+
+  // decompress the rest
+  char buf[4096];
+  while (pos < offset) {
+    int bytes = read(buf, static_cast<int>(min<uint64_t>(sizeof(buf), offset - pos)));
+    if (bytes <= 0)
+      return false;
+    pos += bytes;
+  }
+
+  return true;
+}
+
+
+uint64_t trace_file_c::tell(void)
+{
+  if (m_map)
+    return m_map_pos - sizeof(trace_file_header_s);
+
+  if (m_num_slots == 0)
+    return m_base + m_produced;
+
+  return m_base + m_cur * m_chunk_size + m_pos;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+trace_prefetcher_c::trace_prefetcher_c(macsim_c* simBase)
+  : m_simBase(simBase)
+{
+  m_work       = 0;
+  m_shutdown   = false;
+  m_num_stalls = 0;
+  m_thread     = thread(&trace_prefetcher_c::run, this);
+}
+
+
+trace_prefetcher_c::~trace_prefetcher_c()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_shutdown = true;
+  }
+  m_cond.notify_one();
+  m_thread.join();
+
+  report("trace prefetch stalls: " << m_num_stalls);
+}
+
+
+void trace_prefetcher_c::add(trace_file_c* file)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_files.push_back(file);
+  ++m_work;
+  m_cond.notify_one();
+}
+
+
+void trace_prefetcher_c::remove(trace_file_c* file)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto itr = find(m_files.begin(), m_files.end(), file);
+  ASSERT(itr != m_files.end());
+  *itr = m_files.back();
+  m_files.pop_back();
+}
+
+
+void trace_prefetcher_c::notify(void)
+{
+  lock_guard<mutex> lock(m_mutex);
+  ++m_work;
+  m_cond.notify_one();
+}
+
+
+void trace_prefetcher_c::run(void)
+{
+  unique_lock<mutex> lock(m_mutex);
+  while (!m_shutdown) {
+    unsigned work = m_work;
+    bool filled = false;
+
+    // one chunk per file per pass; files being filled by their consumer are skipped
+    for (size_t ii = 0; ii < m_files.size(); ++ii) {
+      trace_file_c* file = m_files[ii];
+      unique_lock<mutex> file_lock(file->m_mutex, try_to_lock);
+      if (!file_lock.owns_lock())
+        continue;
+
+      lock.unlock();
+      if (file->fill())
+        filled = true;
+      file_lock.unlock();
+      lock.lock();
+    }
+
+    // sleep until a chunk is released or a file is added
+    if (!filled && work == m_work)
+      m_cond.wait(lock);
+  }
+}
@@ -0,0 +1,313 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : trace_prefetch.h
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : trace file access (asynchronous prefetch, memory-mapped traces)
+ *********************************************************************************************/
+
+#ifndef TRACE_PREFETCH_H_INCLUDED
+#define TRACE_PREFETCH_H_INCLUDED
+
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+
+#include "global_defs.h"
+#include "global_types.h"
+
+
+#define TRACE_FILE_MAGIC "MSIMTRC\0"
+#define TRACE_FILE_VERSION 1
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Header of an uncompressed (memory-mapped) trace file
+///
+/// The header is followed by m_num_records fixed-size records in the same layout as the
+/// records of a gzip trace. Such files are created by tools/trace_converter.
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct trace_file_header_s {
+  char     m_magic[8]; /**< TRACE_FILE_MAGIC */
+  uint32_t m_version; /**< TRACE_FILE_VERSION */
+  uint32_t m_record_size; /**< size of a record in bytes */
+  uint64_t m_num_records; /**< number of records */
+  char     m_reserved[40]; /**< pad the header to a cache line */
+} trace_file_header_s;
+
+
+#define TRACE_INDEX_MAGIC "MSIMIDX\0"
+#define TRACE_INDEX_VERSION 1
+#define TRACE_INDEX_WINDOW 32768
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Header of a trace index (<trace>.idx, created by tools/trace_indexer)
+///
+/// A trace index lists access points of a gzip trace : positions at deflate block
+/// boundaries from which decompression can restart, given the preceding 32KB of output.
+/// The header is followed by m_num_points trace_index_point_s and then by the
+/// TRACE_INDEX_WINDOW-byte window of each point.
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct trace_index_header_s {
+  char     m_magic[8]; /**< TRACE_INDEX_MAGIC */
+  uint32_t m_version; /**< TRACE_INDEX_VERSION */
+  uint32_t m_record_size; /**< size of a record in bytes */
+  uint64_t m_num_points; /**< number of access points */
+  uint64_t m_num_records; /**< number of records */
+  uint64_t m_file_size; /**< size of the indexed trace file (detects a stale index) */
+  char     m_reserved[24]; /**< pad the header */
+} trace_index_header_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Access point of a trace index
+///////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct trace_index_point_s {
+  uint64_t m_out; /**< offset in the decompressed trace */
+  uint64_t m_in; /**< offset of the first complete byte in the compressed file */
+  uint32_t m_bits; /**< number of bits of the preceding byte that belong to the point */
+  uint32_t m_reserved; /**< padding */
+} trace_index_point_s;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Trace file of a simulated thread
+///
+/// Decompressed trace data is kept in a ring of fixed-size chunks. A single producer (the
+/// prefetch thread) fills chunks ahead of the single consumer (the simulation) and
+/// publishes them with m_head; the consumer returns them with m_tail. The chunk preceding
+/// the current one is retained so that a peeked instruction can be pushed back. When the
+/// consumer runs ahead of the producer, it decompresses the next chunk itself (stall).
+/// With a depth of 0, the file is read synchronously.
+///
+/// Uncompressed trace files (see trace_file_header_s) are detected on open and
+/// memory-mapped instead; records are then copied straight from the mapping.
+///
+/// When a gzip trace has an index (see trace_index_header_s), seek() restarts decompression
+/// from the closest access point instead of decompressing the trace from the beginning.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class trace_file_c
+{
+  friend class trace_prefetcher_c;
+
+  public:
+    /**
+     * Constructor
+     */
+    trace_file_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~trace_file_c();
+
+    /**
+     * Open a trace file and start prefetching it
+     * @return false if the file cannot be opened
+     */
+    bool open(const string& filename);
+
+    /**
+     * Close the trace file
+     */
+    void close(void);
+
+    /**
+     * Read decompressed trace data (same semantics as gzread)
+     * @return number of bytes read, less than size at the end of the file
+     */
+    int read(void* buf, int size);
+
+    /**
+     * Push back data that has been read (gzseek(-size, SEEK_CUR))
+     * @return false if the data is no longer available
+     */
+    bool unread(int size);
+
+    /**
+     * Restart from the beginning of the trace file
+     */
+    void restart(void);
+
+    /**
+     * Move to an offset of the decompressed trace (memory-mapped or indexed traces)
+     * @return false if the trace cannot be accessed randomly or the offset is out of range
+     */
+    bool seek(uint64_t offset);
+
+    /**
+     * Get the offset of the read position in the decompressed trace
+     */
+    uint64_t tell(void);
+
+    /**
+     * Get the record size of a memory-mapped or indexed trace (0 for other gzip traces)
+     */
+    int get_record_size(void) { return m_record_size; }
+
+    /**
+     * Get the number of records of a memory-mapped or indexed trace (0 if unknown)
+     */
+    uint64_t get_num_records(void) { return m_num_records; }
+
+  private:
+    trace_file_c(); // do not implement
+
+    /**
+     * Decompress the next chunk, if a slot is free. Called with m_mutex held.
+     * @return true if a chunk has been filled
+     */
+    bool fill(void);
+
+    /**
+     * Make the chunk at the read position available
+     * @return false at the end of the file
+     */
+    bool next_chunk(void);
+
+    /**
+     * Memory-map the file if it is an uncompressed trace
+     * @return false if the file is not an uncompressed trace
+     */
+    bool open_mapped(const string& filename);
+
+    /**
+     * Load the access points of <filename>.idx, if the index exists and matches the trace
+     */
+    void open_index(const string& filename);
+
+    /**
+     * Restart raw decompression at an access point. Called with m_mutex held.
+     */
+    void start_stream(size_t point);
+
+    /**
+     * Decompress the next bytes of the trace (gzread, or raw inflate after a seek)
+     * @return number of bytes decompressed
+     */
+    int decompress(void* buf, int size);
+
+  private:
+    macsim_c*           m_simBase; /**< macsim_c base class for simulation globals */
+    trace_prefetcher_c* m_prefetcher; /**< prefetch thread (NULL: synchronous read) */
+    gzFile              m_file; /**< gzip trace file */
+    string              m_filename; /**< trace file name */
+    mutex               m_mutex; /**< protects m_file while a chunk is filled */
+    int                 m_num_slots; /**< number of chunk buffers */
+    int                 m_chunk_size; /**< chunk size in bytes */
+    vector<char*>       m_chunk; /**< chunk buffers */
+    vector<int>         m_chunk_bytes; /**< valid bytes per chunk */
+    atomic<uint64_t>    m_head; /**< number of chunks filled */
+    atomic<uint64_t>    m_tail; /**< number of chunks released */
+    bool                m_eof; /**< end of file reached by the filler */
+    uint64_t            m_cur; /**< chunk at the read position */
+    int                 m_pos; /**< read offset in the current chunk */
+    bool                m_started; /**< m_cur has been made available */
+    char*               m_map; /**< mapping of an uncompressed trace (NULL: gzip trace) */
+    size_t              m_map_size; /**< size of the mapping */
+    size_t              m_map_pos; /**< read offset in the mapping */
+    int                 m_record_size; /**< record size of a mapped or indexed trace */
+    uint64_t            m_num_records; /**< records of a mapped or indexed trace */
+    vector<trace_index_point_s> m_index; /**< access points of an indexed trace */
+    z_stream*           m_stream; /**< raw inflate stream after a seek (NULL : gzread) */
+    FILE*               m_raw; /**< compressed trace read by m_stream */
+    char*               m_raw_buf; /**< compressed input of m_stream */
+    bool                m_stream_end; /**< m_stream reached the end of the deflate data */
+    uint64_t            m_base; /**< decompressed offset of the first chunk */
+    uint64_t            m_produced; /**< bytes decompressed since m_base */
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Background thread that decompresses trace files ahead of the simulation
+///
+/// One host thread serves all open trace files round-robin, one chunk per file per pass,
+/// and sleeps when every ring is full.
+///////////////////////////////////////////////////////////////////////////////////////////////
+class trace_prefetcher_c
+{
+  public:
+    /**
+     * Constructor
+     */
+    trace_prefetcher_c(macsim_c* simBase);
+
+    /**
+     * Destructor
+     */
+    ~trace_prefetcher_c();
+
+    /**
+     * Start prefetching a trace file
+     */
+    void add(trace_file_c* file);
+
+    /**
+     * Stop prefetching a trace file
+     */
+    void remove(trace_file_c* file);
+
+    /**
+     * Wake up the prefetch thread (a chunk has been released)
+     */
+    void notify(void);
+
+    /**
+     * Count a chunk that its consumer had to decompress itself
+     */
+    void stall(void) { ++m_num_stalls; }
+
+  private:
+    trace_prefetcher_c(); // do not implement
+
+    /**
+     * Prefetch thread main loop
+     */
+    void run(void);
+
+  private:
+    macsim_c*             m_simBase; /**< macsim_c base class for simulation globals */
+    mutex                 m_mutex; /**< protects m_files */
+    condition_variable    m_cond; /**< wakes up the prefetch thread */
+    vector<trace_file_c*> m_files; /**< trace files being prefetched */
+    unsigned              m_work; /**< work generation */
+    bool                  m_shutdown; /**< terminate the prefetch thread */
+    atomic<uint64_t>      m_num_stalls; /**< chunks decompressed by their consumer */
+    thread                m_thread; /**< prefetch thread */
+};
+
+#endif
@@ -41,6 +41,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "assert_macros.h"
 #include "trace_read.h"
+#include "sampling.h"
 #include "uop.h"
 #include "global_types.h"
 #include "core.h"
@@ -56,6 +57,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "sw_managed_cache.h"
 #include "memory.h"
 #include "inst_info.h"
+#include "parallel_engine.h"
+#include "trace_prefetch.h"
+#include "decode_cache.h"
 
 #include "trace_read_cpu.h"
 #include "trace_read_a64.h"
@@ -209,8 +213,44 @@ void trace_read_c::setup_trace(int core_id, int sim_thread_id)
   // will be read ahead to get next pc address
   if (core->m_running_thread_num) {
 #ifndef USING_QSIM
-    gzread(thread_trace_info->m_trace_file, thread_trace_info->m_prev_trace_info, 
-        m_trace_size);
+    trace_file_c* trace_file = thread_trace_info->m_trace_file;
+    ASSERTM(trace_file->get_record_size() == 0 || trace_file->get_record_size() == m_trace_size,
+        "trace record size %d does not match the simulated record size %d\n",
+        trace_file->get_record_size(), m_trace_size);
+
+    // resume from a checkpoint : skip retired instructions. A thread that had been
+    // terminated keeps its last instruction, so that it terminates normally.
+    if (thread_trace_info->m_skip_inst_count) {
+      Counter skipped = skip_trace(core_id, sim_thread_id, thread_trace_info->m_skip_inst_count);
+
+      thread_trace_info->m_skip_inst_count = skipped;
+      thread_trace_info->m_inst_count      = skipped;
+    }
+    // skipped and warmed-up instructions count as skipped, so that checkpoint positions stay
+    // correct. A resumed thread has been warmed up already.
+    else {
+      // fast-forward (CPU threads)
+      if (*KNOB(KNOB_TRACE_SKIP_INST) && !thread_trace_info->m_ptx) {
+        Counter skipped = skip_trace(core_id, sim_thread_id, *KNOB(KNOB_TRACE_SKIP_INST));
+        thread_trace_info->m_skip_inst_count = skipped;
+        thread_trace_info->m_inst_count      = skipped;
+        STAT_EVENT_N(SKIP_INST, skipped);
+      }
+
+      // sampled simulation (CPU threads) : warm up to the first sample
+      Counter warmed = 0;
+      if (m_simBase->m_sampling->is_enabled() && !thread_trace_info->m_ptx)
+        warmed = warmup(core_id, sim_thread_id, m_simBase->m_sampling->get_skip(0));
+      // functional warmup
+      else if (*KNOB(KNOB_FUNCTIONAL_WARMUP_INST))
+        warmed = warmup(core_id, sim_thread_id, *KNOB(KNOB_FUNCTIONAL_WARMUP_INST));
+
+      thread_trace_info->m_skip_inst_count += warmed;
+      thread_trace_info->m_inst_count      += warmed;
+      STAT_EVENT_N(FUNC_WARMUP_INST, warmed);
+    }
+
+    trace_file->read(thread_trace_info->m_prev_trace_info, m_trace_size);
 #else
     m_tg->read_trace(core_id, (void *)(thread_trace_info->m_prev_trace_info), m_trace_size);
 #endif
@@ -218,9 +258,92 @@ void trace_read_c::setup_trace(int core_id, int sim_thread_id)
     if (*KNOB(KNOB_DEBUG_TRACE_READ)) {
       dprint_inst(thread_trace_info->m_prev_trace_info, core_id, sim_thread_id);
     }
+
+    if (m_simBase->m_sampling->is_enabled() && !thread_trace_info->m_ptx)
+      m_simBase->m_sampling->start_thread(core_id, sim_thread_id);
   }
 }
 
+
+Counter trace_read_c::skip_trace(int core_id, int sim_thread_id, Counter num_inst)
+{
+  Counter skipped = 0;
+#ifndef USING_QSIM
+  core_c* core = m_simBase->m_core_pointers[core_id];
+  thread_s* thread_trace_info = core->get_trace_info(sim_thread_id);
+  trace_file_c* trace_file = thread_trace_info->m_trace_file;
+
+  // memory-mapped or indexed trace : jump to the target record
+  Counter num_records = trace_file->get_num_records();
+  if (num_records) {
+    Counter pos    = trace_file->tell() / m_trace_size;
+    Counter remain = (num_records > pos) ? num_records - pos : 0;
+    Counter count  = MIN2(num_inst, remain ? remain - 1 : 0);
+    if (trace_file->seek((pos + count) * m_trace_size))
+      return count;
+  }
+
+  while (skipped < num_inst && 
+      trace_file->read(thread_trace_info->m_prev_trace_info, m_trace_size) == m_trace_size) {
+    ++skipped;
+  }
+  if (skipped < num_inst && skipped > 0) {
+    trace_file->unread(m_trace_size);
+    --skipped;
+  }
+#endif
+
+  return skipped;
+}
+
+
+// The current instruction (m_prev_trace_info) has not been decoded yet, and up to a chunk of
+// instructions is buffered : both are pushed back to the trace file before warming up.
+void trace_read_c::sample(int core_id, int sim_thread_id)
+{
+#ifndef USING_QSIM
+  sampling_c* sampling = m_simBase->m_sampling.get();
+  core_c* core = m_simBase->m_core_pointers[core_id];
+  thread_s* thread_trace_info = core->get_trace_info(sim_thread_id);
+
+  if (!sampling->is_enabled() || thread_trace_info->m_trace_ended || 
+      core->m_inst_fetched[sim_thread_id] != 
+      (thread_trace_info->m_sample_id + 1) * sampling->get_detail_inst())
+    return;
+
+  Counter skip = sampling->get_skip(++thread_trace_info->m_sample_id);
+  if (skip == 0)
+    return;
+
+  trace_file_c* trace_file = thread_trace_info->m_trace_file;
+  int buffered = 0;
+  if (thread_trace_info->m_buffer_index != 0)
+    buffered = thread_trace_info->m_buffer_index_max - thread_trace_info->m_buffer_index;
+
+  bool success = trace_file->unread((buffered + 1) * m_trace_size);
+  ASSERTM(success, "core_id:%d thread_id:%d cannot rewind the trace for sampling\n", 
+      core_id, sim_thread_id);
+
+  thread_trace_info->m_buffer_index     = 0;
+  thread_trace_info->m_buffer_exhausted = false;
+
+  // after the last simpoint, the rest of the trace is skipped
+  Counter skipped;
+  if (skip == MAX_CTR) {
+    skipped = skip_trace(core_id, sim_thread_id, skip);
+  }
+  else {
+    skipped = warmup(core_id, sim_thread_id, skip);
+    STAT_EVENT_N(FUNC_WARMUP_INST, skipped);
+  }
+
+  thread_trace_info->m_skip_inst_count += skipped;
+  thread_trace_info->m_inst_count      += skipped;
+
+  trace_file->read(thread_trace_info->m_prev_trace_info, m_trace_size);
+#endif
+}
+
 /**
  * @param core_id - core id
  * @param trace_info - trace information
@@ -247,7 +370,7 @@ bool trace_read_c::read_trace(int core_id, void *trace_info, int sim_thread_id,
       ///
       if (thread_trace_info->m_buffer_index == 0) {
 #ifndef USING_QSIM
-        thread_trace_info->m_buffer_index_max  = gzread(thread_trace_info->m_trace_file,
+        thread_trace_info->m_buffer_index_max  = thread_trace_info->m_trace_file->read(
                                                         thread_trace_info->m_buffer,
                                                         m_trace_size*k_trace_buffer_size);
 #else
@@ -262,7 +385,7 @@ bool trace_read_c::read_trace(int core_id, void *trace_info, int sim_thread_id,
 
         /*
         if (thread_trace_info->m_buffer_index_max < k_trace_buffer_size) {
-          gzclose(thread_trace_info->m_trace_file);
+          thread_trace_info->m_trace_file->close();
         }
         */
       }
@@ -298,17 +421,28 @@ bool trace_read_c::read_trace(int core_id, void *trace_info, int sim_thread_id,
         process = thread_trace_info->m_process;
         int no_created_thread = process->m_no_of_threads_created;
 
-        // create other threads which are not main-thread.
+        // create other threads which are not main-thread. (a main thread that resumes 
+        // from a checkpoint may have passed the start of several threads)
         while((process->m_no_of_threads_created < process->m_no_of_threads &&
-              thread_trace_info->m_inst_count == 
+              thread_trace_info->m_inst_count >= 
               process->m_thread_start_info[no_created_thread].m_inst_count) || 
             (process->m_no_of_threads_created < process->m_no_of_threads &&
              process->m_thread_start_info[no_created_thread].m_inst_count == 0)) {
 
           // create non-main threads here
-          m_simBase->m_process_manager->create_thread_node(process, process->m_no_of_threads_created++, 
-              false);
-          m_simBase->m_process_manager->sim_thread_schedule(false);
+          int thread_id = process->m_no_of_threads_created++;
+          if (parallel_engine_c::is_deferring()) {
+            // other cores are running : the process manager is called after the quantum
+            process_manager_c* process_manager = m_simBase->m_process_manager;
+            parallel_engine_c::defer([process_manager, process, thread_id] () {
+                process_manager->create_thread_node(process, thread_id, false);
+                process_manager->sim_thread_schedule(false);
+            });
+          }
+          else {
+            m_simBase->m_process_manager->create_thread_node(process, thread_id, false);
+            m_simBase->m_process_manager->sim_thread_schedule(false);
+          }
         }
       }
 
@@ -425,6 +559,59 @@ void trace_read_c::convert_t_uop_to_info(trace_uop_s *t_uop, inst_info_s *info)
 }
 
 
+/**
+ * Store the uops of a newly decoded instruction in the decode cache of its application
+ * @param cache - decode cache
+ * @param addr - instruction address
+ * @param opcode - trace opcode
+ * @param trace_uop - decoded uops
+ * @param num_uop - number of uops
+ */
+void trace_read_c::cache_decoded_inst(decode_cache_c *cache, Addr addr, uint16_t opcode, 
+    trace_uop_s **trace_uop, int num_uop)
+{
+  if (!cache->is_enabled())
+    return;
+
+  decode_entry_s *entry = cache->create_entry(addr, num_uop);
+
+  // templates hold what later instances would get from the hash table (convert_info_uop)
+  for (int ii = 0; ii < num_uop; ++ii) {
+    trace_uop_s *uop = &entry->m_uop[ii];
+    convert_info_uop(trace_uop[ii]->m_info, uop);
+    uop->m_info   = trace_uop[ii]->m_info;
+    uop->m_opcode = opcode;
+    uop->m_eom    = 0;
+  }
+
+  cache->insert(entry);
+}
+
+
+/**
+ * Copy the uops of an instruction from the decode cache and add dynamic information
+ * @param entry - decode cache entry
+ * @param pi - raw trace information
+ * @param trace_uop - MacSim trace format
+ * @param core_id - core id
+ * @return number of uops
+ */
+int trace_read_c::copy_decoded_inst(const decode_entry_s *entry, void *pi, 
+    trace_uop_s **trace_uop, int core_id)
+{
+  int num_uop = entry->m_num_uop;
+  for (int ii = 0; ii < num_uop; ++ii) {
+    *trace_uop[ii] = entry->m_uop[ii];
+    convert_dyn_uop(entry->m_uop[ii].m_info, pi, trace_uop[ii], 0, core_id);
+  }
+
+  // set end of macro flag to the last uop
+  trace_uop[num_uop-1]->m_eom = 1;
+
+  return num_uop;
+}
+
+
 
 
 
@@ -808,4 +995,10 @@ void trace_reader_wrapper_c::pre_read_trace(thread_s* trace_info)
 }
 
 
+void trace_reader_wrapper_c::checkpoint(checkpoint_c* ckpt)
+{
+  m_cpu_decoder->checkpoint(ckpt);
+}
+
+
 
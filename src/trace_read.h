@@ -681,6 +681,22 @@ class trace_read_c
      */
     void setup_trace(int core_id, int sim_thread_id);
 
+    /**
+     * Save or restore decoder state that outlives a thread (e.g. page mapping)
+     */
+    virtual void checkpoint(checkpoint_c* ckpt) {}
+
+    /**
+     * Functional warmup : consume the first instructions of a thread and update caches,
+     * TLBs, branch predictors and prefetchers without timing. The last instruction of the
+     * trace is never consumed.
+     * @param core_id - core id
+     * @param sim_thread_id - thread id
+     * @param num_inst - number of instructions to consume
+     * @return number of instructions consumed
+     */
+    virtual Counter warmup(int core_id, int sim_thread_id, Counter num_inst) { return 0; }
+
       /**
        * Initialize the mapping between trace opcode and uop type
        */
@@ -717,6 +733,28 @@ class trace_read_c
      */
     void convert_info_uop(inst_info_s *info, trace_uop_s *trace_uop);
 
+    /**
+     * Store the uops of a newly decoded instruction in the decode cache of its application
+     * @param cache - decode cache
+     * @param addr - instruction address
+     * @param opcode - trace opcode
+     * @param trace_uop - decoded uops
+     * @param num_uop - number of uops
+     */
+    void cache_decoded_inst(decode_cache_c *cache, Addr addr, uint16_t opcode, 
+        trace_uop_s **trace_uop, int num_uop);
+
+    /**
+     * Copy the uops of an instruction from the decode cache and add dynamic information
+     * @param entry - decode cache entry
+     * @param pi - raw trace information
+     * @param trace_uop - MacSim trace format
+     * @param core_id - core id
+     * @return number of uops
+     */
+    int copy_decoded_inst(const decode_entry_s *entry, void *pi, trace_uop_s **trace_uop, 
+        int core_id);
+
     /**
      * From statis instruction, add dynamic information such as load address, branch target, ...
      * @param info - instruction information from the hash table
@@ -745,6 +783,25 @@ class trace_read_c
      */
     bool read_trace(int core_id, void *trace_info, int sim_thread_id, bool *inst_read);
 
+    /**
+     * Skip instructions without simulating them. The last instruction of the trace is
+     * never consumed.
+     * @param core_id - core id
+     * @param sim_thread_id - thread id
+     * @param num_inst - number of instructions to skip
+     * @return number of instructions skipped
+     */
+    Counter skip_trace(int core_id, int sim_thread_id, Counter num_inst);
+
+    /**
+     * Sampled simulation : called at the beginning of each instruction. Once all detailed
+     * instructions of a sample have been fetched, warm up (or skip) the instructions up to
+     * the next sample and continue from there.
+     * @param core_id - core id
+     * @param sim_thread_id - thread id
+     */
+    void sample(int core_id, int sim_thread_id);
+
     /**
      * After peeking trace, in case of failture, we need to rewind trace file.
      * @param core_id - core id
@@ -790,6 +847,7 @@ class trace_reader_wrapper_c {
     void setup_trace(int core_id, int sim_thread_id, bool gpu_sim);
     bool get_uops_from_traces(int core_id, uop_c *uop, int sim_thread_id, bool gpu_sim);
     void pre_read_trace(thread_s* trace_info);
+    void checkpoint(checkpoint_c* ckpt);
 
   private:
     trace_reader_wrapper_c();
@@ -1,8 +1,11 @@
 #include "trace_read_a64.h"
 #include "process_manager.h"
+#include "decode_cache.h"
 #include "assert_macros.h"
 #include "debug_macros.h"
 #include "utils.h"
+#include "statistics.h"
+#include "parallel_engine.h"
 #include "all_knobs.h"
 
 #define DEBUG(args...)   _DEBUG(*KNOB(KNOB_DEBUG_TRACE_READ), ## args)
@@ -963,8 +966,8 @@ inst_info_s* a64_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
 
   // simulator maintains a cache of decoded instructions (uop) for each process, 
   // this avoids decoding of instructions everytime an instruction is executed
-  int process_id = core->get_trace_info(sim_thread_id)->m_process->m_process_id;
-  hash_c<inst_info_s>* htable = m_simBase->m_inst_info_hash[process_id];
+  process_s* process = core->get_trace_info(sim_thread_id)->m_process;
+  hash_c<inst_info_s>* htable = m_simBase->m_inst_info_hash[process->m_process_id];
 
   // since each instruction can be decoded into multiple uops, the key to the 
   // hashtable has to be (instruction addr + something else)
@@ -973,9 +976,20 @@ inst_info_s* a64_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
   bool new_entry = false;
   Addr key_addr = (pi->m_instruction_addr << 3);
 
+  // instructions decoded before are copied from the decode cache without locking
+  const decode_entry_s* entry = process->m_decode_cache->lookup(pi->m_instruction_addr);
+  if (entry) {
+    STAT_CORE_EVENT(core_id, DECODE_CACHE_HIT);
+  }
+  else {
+    STAT_CORE_EVENT(core_id, DECODE_CACHE_MISS);
+  }
+
   // Get instruction information from the hash table if exists. 
   // Else create a new entry
-  inst_info_s *info = htable->hash_table_access_create(key_addr, &new_entry);
+  decode_lock_c decode_lock(entry ? NULL : htable, key_addr);
+  inst_info_s *info = entry ? entry->m_uop[0].m_info : 
+    htable->hash_table_access_create(key_addr, &new_entry);
 
   inst_info_s *first_info = info;
   int  num_uop = 0;
@@ -1418,7 +1432,17 @@ inst_info_s* a64_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
     trace_uop[num_uop - 1]->m_eom = 1;
 
     ASSERT(num_uop > 0);
+
+    // share the decoded uops with later instances of this instruction
+    cache_decoded_inst(process->m_decode_cache, pi->m_instruction_addr, pi->m_opcode, 
+        trace_uop, num_uop);
   } // NEW_ENTRY
+    ///
+    /// Instruction found in the decode cache
+    ///
+  else if (entry) {
+    num_uop = copy_decoded_inst(entry, pi, trace_uop, core_id);
+  }
     ///
     /// Hash table already has matching instruction, we can skip above decoding process
     ///
@@ -1465,7 +1489,9 @@ inst_info_s* a64_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
   trace_uop[dyn_uop_counter-1]->m_npc = pi->m_instruction_next_addr;
 
   ASSERT(num_uop > 0);
-  first_info->m_trace_info.m_num_uop = num_uop;
+  // decoded entries are shared by all cores : store only when decoded for the first time
+  if (first_info->m_trace_info.m_num_uop != num_uop)
+    first_info->m_trace_info.m_num_uop = num_uop;
 
   DEBUG("%s: read: %d write: %d\n", a64_opcode_names[pi->m_opcode], pi->m_num_read_regs, pi->m_num_dest_regs);
 
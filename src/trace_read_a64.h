@@ -12,6 +12,11 @@ class a64_decoder_c : public cpu_decoder_c
       m_trace_size = sizeof(trace_info_a64_s) - sizeof(uint64_t);
     }
 
+    Counter warmup(int core_id, int sim_thread_id, Counter num_inst)
+    {
+      return warmup_trace<trace_info_a64_s>(core_id, sim_thread_id, num_inst, false);
+    }
+
   private:
 
     void init_pin_convert();
@@ -47,6 +47,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "core.h"
 #include "knob.h"
 #include "process_manager.h"
+#include "decode_cache.h"
 #include "debug_macros.h"
 #include "statistics.h"
 #include "frontend.h"
@@ -57,6 +58,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "sw_managed_cache.h"
 #include "memory.h"
 #include "inst_info.h"
+#include "parallel_engine.h"
+#include "trace_prefetch.h"
 #include "page_mapping.h"
 
 #include "all_knobs.h"
@@ -200,6 +203,93 @@ void cpu_decoder_c::pre_read_trace(thread_s* trace_info)
 }
 
 
+void cpu_decoder_c::checkpoint(checkpoint_c* ckpt)
+{
+  if (m_enable_physical_mapping)
+    m_page_mapper->checkpoint(ckpt);
+}
+
+
+Counter cpu_decoder_c::warmup(int core_id, int sim_thread_id, Counter num_inst)
+{
+  return warmup_trace<trace_info_cpu_s>(core_id, sim_thread_id, num_inst, true);
+}
+
+
+// the raw trace is read directly : no uop is decoded and the instruction hash table is not
+// touched. Addresses are computed as in convert_dyn_uop and get_uops_from_traces.
+template <typename T>
+Counter cpu_decoder_c::warmup_trace(int core_id, int sim_thread_id, Counter num_inst, 
+    bool amplify)
+{
+  core_c* core = m_simBase->m_core_pointers[core_id];
+  thread_s* thread_trace_info = core->get_trace_info(sim_thread_id);
+  trace_file_c* trace_file = thread_trace_info->m_trace_file;
+  Addr base = m_simBase->m_memory->base_addr(core_id, (unsigned long)UINT_MAX * 
+      (thread_trace_info->m_process->m_process_id) * 10ul);
+
+  // one instruction is always read ahead, so that the last instruction of the trace is
+  // left to the detailed simulation (the thread then terminates normally)
+  T cur, next;
+  int pending = trace_file->read(&cur, m_trace_size);
+  Counter warmed = 0;
+  while (pending == m_trace_size && warmed < num_inst) {
+    int bytes = trace_file->read(&next, m_trace_size);
+    if (bytes != m_trace_size) {
+      pending += bytes;
+      break;
+    }
+
+    Addr pc = cur.m_instruction_addr;
+    core->warmup_fetch(sim_thread_id, pc, warmed);
+
+    if (cur.m_cf_type) {
+      Cf_Type cf_type = (Cf_Type)((cur.m_cf_type >= PIN_CF_SYS) ? CF_ICO : cur.m_cf_type);
+      core->warmup_branch(sim_thread_id, pc, cf_type, cur.m_actually_taken, 
+          cur.m_branch_target);
+    }
+
+    Addr amp_val = 1;
+    if (amplify && cur.m_opcode != XED_CATEGORY_STRINGOP)
+      amp_val = *KNOB(KNOB_MEM_SIZE_AMP);
+
+    auto warmup_access = [&] (Addr va, Mem_Type type) {
+      if (va == 0)
+        return ;
+      Addr addr = MIN2(va * amp_val, MAX_ADDR) + base;
+      if (m_enable_physical_mapping)
+        addr = m_page_mapper->translate(addr);
+      core->warmup_access(sim_thread_id, pc, addr, type);
+    };
+
+    if (cur.m_num_ld) {
+      warmup_access(cur.m_ld_vaddr1, MEM_LD);
+      if (cur.m_num_ld == 2)
+        warmup_access(cur.m_ld_vaddr2, MEM_LD);
+    }
+    if (cur.m_has_st)
+      warmup_access(cur.m_st_vaddr, MEM_ST);
+
+    ++warmed;
+    cur = next;
+  }
+
+  // push back what has been read but not consumed
+  if (pending > 0) {
+    bool success = trace_file->unread(pending);
+    ASSERTM(success, "core_id:%d thread_id:%d cannot rewind the trace after warmup\n", 
+        core_id, sim_thread_id);
+  }
+
+  return warmed;
+}
+
+template Counter cpu_decoder_c::warmup_trace<trace_info_a64_s>(int core_id, 
+    int sim_thread_id, Counter num_inst, bool amplify);
+template Counter cpu_decoder_c::warmup_trace<trace_info_igpu_s>(int core_id, 
+    int sim_thread_id, Counter num_inst, bool amplify);
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -273,8 +363,8 @@ inst_info_s* cpu_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
 
   // simulator maintains a cache of decoded instructions (uop) for each process, 
   // this avoids decoding of instructions everytime an instruction is executed
-  int process_id = core->get_trace_info(sim_thread_id)->m_process->m_process_id;
-  hash_c<inst_info_s>* htable = m_simBase->m_inst_info_hash[process_id];
+  process_s* process = core->get_trace_info(sim_thread_id)->m_process;
+  hash_c<inst_info_s>* htable = m_simBase->m_inst_info_hash[process->m_process_id];
 
 
   // since each instruction can be decoded into multiple uops, the key to the 
@@ -285,9 +375,22 @@ inst_info_s* cpu_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
   Addr key_addr = (pi->m_instruction_addr << 3);
 
 
+  // instructions decoded before are copied from the decode cache without locking
+  // (string operations update their hash table entries, so they are not cached)
+  const decode_entry_s* entry = (pi->m_opcode == XED_CATEGORY_STRINGOP) ? NULL : 
+    process->m_decode_cache->lookup(pi->m_instruction_addr);
+  if (entry) {
+    STAT_CORE_EVENT(core_id, DECODE_CACHE_HIT);
+  }
+  else {
+    STAT_CORE_EVENT(core_id, DECODE_CACHE_MISS);
+  }
+
   // Get instruction information from the hash table if exists. 
   // Else create a new entry
-  inst_info_s *info = htable->hash_table_access_create(key_addr, &new_entry);
+  decode_lock_c decode_lock(entry ? NULL : htable, key_addr);
+  inst_info_s *info = entry ? entry->m_uop[0].m_info : 
+    htable->hash_table_access_create(key_addr, &new_entry);
 
   inst_info_s *first_info = info;
   int  num_uop = 0;
@@ -699,8 +802,19 @@ inst_info_s* cpu_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
     trace_uop[num_uop - 1]->m_eom = 1;
 
     ASSERT(num_uop > 0);
+
+    // share the decoded uops with later instances of this instruction
+    if (pi->m_opcode != XED_CATEGORY_STRINGOP)
+      cache_decoded_inst(process->m_decode_cache, pi->m_instruction_addr, pi->m_opcode, 
+          trace_uop, num_uop);
   } // NEW_ENTRY
   ///
+  /// Instruction found in the decode cache
+  ///
+  else if (entry) {
+    num_uop = copy_decoded_inst(entry, pi, trace_uop, core_id);
+  }
+  ///
   /// Hash table already has matching instruction, we can skip above decoding process
   ///
   else {
@@ -854,7 +968,9 @@ inst_info_s* cpu_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
   }
 
   ASSERT(num_uop > 0);
-  first_info->m_trace_info.m_num_uop = num_uop;
+  // decoded entries are shared by all cores : store only when decoded for the first time
+  if (first_info->m_trace_info.m_num_uop != num_uop)
+    first_info->m_trace_info.m_num_uop = num_uop;
 
   return first_info;
 }
@@ -954,6 +1070,9 @@ bool cpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
   ///
   if (thread_trace_info->m_bom) {
     bool inst_read; // indicate new instruction has been read from a trace file
+
+    // sampled simulation : jump to the next sample
+    sample(core_id, sim_thread_id);
     
     if (core->m_inst_fetched[sim_thread_id] < *KNOB(KNOB_MAX_INSTS)) {
       // read next instruction
@@ -86,6 +86,16 @@ class cpu_decoder_c : public trace_read_c
      */
     void pre_read_trace(thread_s* trace_info);
 
+    /**
+     * Save or restore the virtual-to-physical page mapping
+     */
+    void checkpoint(checkpoint_c* ckpt);
+
+    /**
+     * Functional warmup from the raw trace (see trace_read_c::warmup)
+     */
+    virtual Counter warmup(int core_id, int sim_thread_id, Counter num_inst);
+
     static const char *g_tr_reg_names[MAX_TR_REG]; /**< register name string */
     static const char* g_tr_opcode_names[MAX_TR_OPCODE_NAME]; /**< opcode name string */
     static const char* g_tr_cf_names[10]; /**< cf type string */
@@ -148,6 +158,18 @@ class cpu_decoder_c : public trace_read_c
      */
     bool peek_trace(int core_id, void *trace_info, int sim_thread_id, bool *inst_read);
 
+  protected:
+    /**
+     * Functional warmup from raw trace records of type T (x86 and a64 layouts)
+     * @param core_id - core id
+     * @param sim_thread_id - thread id
+     * @param num_inst - number of instructions to consume
+     * @param amplify - scale data addresses by MEM_SIZE_AMP as the x86 decoder does
+     * @return number of instructions consumed
+     */
+    template <typename T>
+    Counter warmup_trace(int core_id, int sim_thread_id, Counter num_inst, bool amplify);
+
 
     //changed by Lifeng
     //HMC_Type generate_hmc_inst(const hmc_inst_s & inst_info, uint64_t hmc_vaddr, trace_info_cpu_s & ret_trace_info);
@@ -38,6 +38,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include <iostream>
 #include <set>
+#include <algorithm>
 
 #include "assert_macros.h"
 #include "trace_read.h"
@@ -47,6 +48,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "core.h"
 #include "knob.h"
 #include "process_manager.h"
+#include "decode_cache.h"
 #include "debug_macros.h"
 #include "statistics.h"
 #include "frontend.h"
@@ -57,6 +59,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "sw_managed_cache.h"
 #include "memory.h"
 #include "inst_info.h"
+#include "parallel_engine.h"
+#include "trace_prefetch.h"
 
 #include "all_knobs.h"
 
@@ -134,7 +138,7 @@ bool gpu_decoder_c::peek_trace(int core_id, void *t_info, int sim_thread_id,
   }
   // read one instruction each
   else {
-    bytes_read = gzread(thread_trace_info->m_trace_file, trace_info, m_trace_size);
+    bytes_read = thread_trace_info->m_trace_file->read(trace_info, m_trace_size);
   }
 
   if (m_trace_size == bytes_read) {
@@ -179,12 +183,7 @@ bool gpu_decoder_c::ungetch_trace(int core_id, int sim_thread_id, int num_inst)
 
 
   // rewind trace file
-  off_t offset = gzseek(thread_trace_info->m_trace_file, -1*num_inst*m_trace_size, SEEK_CUR);
-
-  if (offset == -1) {
-    return false;
-  }
-  return true;
+  return thread_trace_info->m_trace_file->unread(num_inst*m_trace_size);
 }
 
 
@@ -266,15 +265,160 @@ void gpu_decoder_c::pre_read_trace(thread_s* trace_info)
     int bytes_read;
     trace_info_gpu_s inst_info;
 
-    while ((bytes_read = gzread(trace_info->m_trace_file, &inst_info, m_trace_size)) == m_trace_size) {
+    while ((bytes_read = trace_info->m_trace_file->read(&inst_info, m_trace_size)) == m_trace_size) {
       //do something
     }
-    gzrewind(trace_info->m_trace_file);
+    trace_info->m_trace_file->restart();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 
+// memory type of a raw instruction (see convert_pinuop_to_t_uop)
+static Mem_Type gpu_mem_type(trace_info_gpu_s* pi)
+{
+  if (pi->m_is_load) {
+    switch (pi->m_opcode) {
+      case GPU_MEM_LD_LM:
+      case GPU_DATA_XFER_LM:
+        return MEM_LD_LM;
+      case GPU_MEM_LD_SM:
+      case GPU_DATA_XFER_SM:
+      case GPU_MEM_LD_PM:
+      case GPU_ATOM_SM:
+      case GPU_ATOM64_SM:
+      case GPU_RED_SM:
+      case GPU_RED64_SM:
+        return MEM_LD_SM;
+      case GPU_MEM_LD_CM:
+        return MEM_LD_CM;
+      case GPU_MEM_LD_TM:
+        return MEM_LD_TM;
+      default:
+        return MEM_LD;
+    }
+  }
+
+  switch (pi->m_opcode) {
+    case GPU_MEM_ST_GM:
+      return MEM_ST;
+    case GPU_MEM_ST_LM:
+      return MEM_ST_LM;
+    case GPU_MEM_ST_SM:
+      return MEM_ST_SM;
+    default:
+      return NOT_MEM;
+  }
+}
+
+
+// the raw trace is read directly : no uop is decoded and the instruction hash table is not
+// touched. Each memory instruction is followed by the addresses of the other threads of the
+// warp, which are coalesced into cache lines as in get_uops_from_traces.
+Counter gpu_decoder_c::warmup(int core_id, int sim_thread_id, Counter num_inst)
+{
+  core_c* core = m_simBase->m_core_pointers[core_id];
+  thread_s* thread_trace_info = core->get_trace_info(sim_thread_id);
+  trace_file_c* trace_file = thread_trace_info->m_trace_file;
+  Addr base = m_simBase->m_memory->base_addr(core_id, (unsigned long)UINT_MAX * 
+      (thread_trace_info->m_process->m_process_id) * 10ul);
+
+  int warp_size = *KNOB(KNOB_GPU_WARP_SIZE);
+  int addr_per_trace_inst = *KNOB(KNOB_TRACE_USES_64_BIT_ADDR) ? (m_trace_size / 8) : 
+    (m_trace_size / 4);
+  int amp_val = *KNOB(KNOB_MEM_SIZE_AMP);
+
+  trace_info_gpu_s inst_info;
+  trace_info_gpu_s addr_info;
+  vector<Addr> lines;
+  Counter warmed = 0;
+  while (warmed < num_inst) {
+    int pending = trace_file->read(&inst_info, m_trace_size);
+    if (pending != m_trace_size || 
+        inst_info.m_opcode == GPU_BAR_SYNC || inst_info.m_opcode == GPU_BAR_ARRIVE || 
+        inst_info.m_opcode == GPU_BAR_RED) {
+      if (pending > 0)
+        trace_file->unread(pending);
+      break;
+    }
+
+    Mem_Type mem_type = gpu_mem_type(&inst_info);
+    int access_size = inst_info.m_mem_access_size * amp_val;
+    auto add_line = [&] (Addr addr) {
+      Addr line_addr, end_line_addr;
+      if (mem_type == MEM_LD_CM || mem_type == MEM_LD_TM) {
+        readonly_cache_c* cache = (mem_type == MEM_LD_CM) ? core->get_const_cache() : 
+          core->get_texture_cache();
+        line_addr     = cache->base_cache_line(addr);
+        end_line_addr = cache->base_cache_line(addr + access_size - 1);
+      }
+      else {
+        line_addr     = m_simBase->m_memory->base_addr(core_id, addr);
+        end_line_addr = m_simBase->m_memory->base_addr(core_id, addr + access_size - 1);
+      }
+      if (find(lines.begin(), lines.end(), line_addr) == lines.end())
+        lines.push_back(line_addr);
+      if (find(lines.begin(), lines.end(), end_line_addr) == lines.end())
+        lines.push_back(end_line_addr);
+    };
+
+    lines.clear();
+    if (mem_type != NOT_MEM) {
+      // the first address is in the instruction itself
+      if (inst_info.m_mem_addr && access_size) 
+        add_line(MIN2(inst_info.m_mem_addr * amp_val, MAX_ADDR) + base);
+
+      for (int read_addr = 1; read_addr < warp_size; ++read_addr) {
+        int index = (read_addr - 1) % addr_per_trace_inst;
+        if (index == 0) {
+          int bytes = trace_file->read(&addr_info, m_trace_size);
+          pending += bytes;
+          ASSERTM(bytes == m_trace_size, "reached end without reading all addresses\n");
+        }
+
+        Addr addr = 0;
+        if (*KNOB(KNOB_TRACE_USES_64_BIT_ADDR))
+          memcpy(&addr, ((uint8_t*)&addr_info) + index * 8, 8);
+        else
+          memcpy(&addr, ((uint8_t*)&addr_info) + index * 4, 4);
+
+        if (addr && access_size)
+          add_line(addr + base);
+      }
+    }
+
+    // the last instruction of the warp is left to the detailed simulation
+    int bytes = trace_file->read(&addr_info, m_trace_size);
+    if (bytes > 0)
+      trace_file->unread(bytes);
+    if (bytes != m_trace_size) {
+      trace_file->unread(pending);
+      break;
+    }
+
+    Addr pc = inst_info.m_inst_addr;
+    core->warmup_fetch(sim_thread_id, pc, warmed);
+
+    if (inst_info.m_cf_type) {
+      Cf_Type cf_type = (Cf_Type)((inst_info.m_cf_type >= PIN_CF_SYS) ? 
+          CF_ICO : inst_info.m_cf_type);
+      core->warmup_branch(sim_thread_id, pc, cf_type, inst_info.m_br_taken_mask ? true : false, 
+          inst_info.m_br_target_addr);
+    }
+
+    for (auto I = lines.begin(), E = lines.end(); I != E; ++I) 
+      core->warmup_access(sim_thread_id, pc, *I, mem_type);
+
+    ++warmed;
+  }
+
+  return warmed;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+
 
 /**
  * From statis instruction, add dynamic information such as load address, branch target, ...
@@ -350,8 +494,8 @@ inst_info_s* gpu_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
 
   // simulator maintains a cache of decoded instructions (uop) for each process, 
   // this avoids decoding of instructions everytime an instruction is executed
-  int process_id = core->get_trace_info(sim_thread_id)->m_process->m_process_id;
-  hash_c<inst_info_s>* htable = m_simBase->m_inst_info_hash[process_id];
+  process_s* process = core->get_trace_info(sim_thread_id)->m_process;
+  hash_c<inst_info_s>* htable = m_simBase->m_inst_info_hash[process->m_process_id];
 
 
   // since each instruction can be decoded into multiple uops, the key to the 
@@ -362,9 +506,20 @@ inst_info_s* gpu_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
   Addr key_addr = (pi->m_inst_addr << 3);
 
 
+  // instructions decoded before are copied from the decode cache without locking
+  const decode_entry_s* entry = process->m_decode_cache->lookup(pi->m_inst_addr);
+  if (entry) {
+    STAT_CORE_EVENT(core_id, DECODE_CACHE_HIT);
+  }
+  else {
+    STAT_CORE_EVENT(core_id, DECODE_CACHE_MISS);
+  }
+
   // Get instruction information from the hash table if exists. 
   // Else create a new entry
-  inst_info_s *info = htable->hash_table_access_create(key_addr, &new_entry);
+  decode_lock_c decode_lock(entry ? NULL : htable, key_addr);
+  inst_info_s *info = entry ? entry->m_uop[0].m_info : 
+    htable->hash_table_access_create(key_addr, &new_entry);
 
   inst_info_s *first_info = info;
   int  num_uop = 0;
@@ -688,8 +843,18 @@ inst_info_s* gpu_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
     trace_uop[num_uop - 1]->m_eom = 1;
 
     ASSERT(num_uop > 0);
+
+    // share the decoded uops with later instances of this instruction
+    cache_decoded_inst(process->m_decode_cache, pi->m_inst_addr, pi->m_opcode, 
+        trace_uop, num_uop);
   } // NEW_ENTRY
   ///
+  /// Instruction found in the decode cache
+  ///
+  else if (entry) {
+    num_uop = copy_decoded_inst(entry, pi, trace_uop, core_id);
+  }
+  ///
   /// Hash table already has matching instruction, we can skip above decoding process
   ///
   else {
@@ -754,7 +919,9 @@ inst_info_s* gpu_decoder_c::convert_pinuop_to_t_uop(void *trace_info, trace_uop_
 #endif
 
   ASSERT(num_uop > 0);
-  first_info->m_trace_info.m_num_uop = num_uop;
+  // decoded entries are shared by all cores : store only when decoded for the first time
+  if (first_info->m_trace_info.m_num_uop != num_uop)
+    first_info->m_trace_info.m_num_uop = num_uop;
 
   return first_info;
 }
@@ -1088,9 +1255,9 @@ bool gpu_decoder_c::get_uops_from_traces(int core_id, uop_c *uop, int sim_thread
 
       ASSERTM(ungetch_trace(core_id, sim_thread_id, 1), "mention why\n");
 
-      static set<Addr> seen_block_addr;  // to efficiently track seen cache blocks
-      static list<Addr> seen_block_list; // to maintain the order of seen cache blocks - is it necessary?
-      static map<int, Addr> accessed_addr;
+      thread_local static set<Addr> seen_block_addr;  // to efficiently track seen cache blocks
+      thread_local static list<Addr> seen_block_list; // to maintain the order of seen cache blocks - is it necessary?
+      thread_local static map<int, Addr> accessed_addr;
 
       seen_block_addr.clear();
       seen_block_list.clear();
@@ -80,6 +80,12 @@ class gpu_decoder_c : public trace_read_c
      */
     void pre_read_trace(thread_s* trace_info);
 
+    /**
+     * Functional warmup from the raw trace (see trace_read_c::warmup). A warp stops at its
+     * first barrier, since barriers are counted per block in the frontend.
+     */
+    Counter warmup(int core_id, int sim_thread_id, Counter num_inst);
+
     static const char *g_tr_reg_names[MAX_TR_REG]; /**< register name string */
     static const char* g_tr_opcode_names[MAX_TR_OPCODE_NAME]; /**< opcode name string */
     static const char* g_tr_cf_names[10]; /**< cf type string */
@@ -93,6 +93,11 @@ class igpu_decoder_c : public cpu_decoder_c
       m_trace_size = sizeof(trace_info_igpu_s) - sizeof(uint64_t);
     }
 
+    Counter warmup(int core_id, int sim_thread_id, Counter num_inst)
+    {
+      return warmup_trace<trace_info_igpu_s>(core_id, sim_thread_id, num_inst, false);
+    }
+
     static const char* g_tr_opcode_names[GED_OPCODE_LAST]; /**< opcode name string */
 
   private:
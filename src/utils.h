@@ -42,10 +42,15 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <cstring>
+#include <cstdlib>
 #include <stdio.h>
 #include <time.h>
 #include <string>
 #include <list>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <fstream>
@@ -110,46 +115,73 @@ using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief pool class
+///
+/// Entries are constructed once, in chunks of contiguous slots, and recycled through a free
+/// list embedded in the slots. Entries are handed out in LIFO order, the most recently
+/// released entry first. With a thread cache, each host thread keeps a private free list
+/// and moves slots to and from the shared free list in batches. Debug builds detect an entry
+/// released twice.
 ///////////////////////////////////////////////////////////////////////////////////////////////
 template <class T>
 class pool_c
 {
+  private:
+    /**
+     * Pool slot
+     */
+    typedef struct slot_s {
+      typename aligned_storage<sizeof(T), alignof(T)>::type m_entry; /**< entry (first member) */
+      slot_s* m_next; /**< next free slot */
+      bool    m_free; /**< slot is in a free list */
+    } slot_s;
+
+    /**
+     * Free slots cached by a host thread
+     */
+    typedef struct cache_s {
+      slot_s* m_head; /**< first free slot */
+      int     m_size; /**< number of free slots */
+    } cache_s;
+
   public:
     /**
      * Constructor
      */
     pool_c()
     {
-      m_pool            = new list<T*>;
-      m_poolsize        = 0;
-      m_poolexpand_unit = 1;
-      m_name            = "none";
+      init(1, "none", 0);
     }
 
     /**
      * Constructor
      * @param pool_expand_unit number of entries when pool expands
      * @param name pool name
+     * @param thread_cache number of entries moved between a thread cache and the pool at a
+     *                     time (0 disables thread caches)
      */
-    pool_c(int pool_expand_unit, string name)
+    pool_c(int pool_expand_unit, string name, int thread_cache = 0)
     {
-      m_pool            = new list<T*>;
-      m_poolsize        = 0;
-      m_poolexpand_unit = pool_expand_unit;
-      m_name            = name;
+      init(pool_expand_unit, name, thread_cache);
     }
 
     /**
      * Destructor
+     *   Entries still in use are not destructed, and their chunks are not released.
      */
     ~pool_c()
     {
-      while (!m_pool->empty()) {
-        T* entry = m_pool->front();
-        m_pool->pop_front();
-        delete entry;
+      for (auto chunk : m_chunk) {
+        bool all_free = true;
+        for (int ii = 0; ii < m_poolexpand_unit; ++ii) {
+          if (chunk[ii].m_free)
+            reinterpret_cast<T*>(&chunk[ii].m_entry)->~T();
+          else
+            all_free = false;
+        }
+
+        if (all_free)
+          ::operator delete(chunk);
       }
-      delete m_pool;
     }
 
     /**
@@ -157,12 +189,11 @@ class pool_c
      */
     T* acquire_entry(void)
     {
-      if (m_pool->empty()) {
+      slot_s* slot;
+      while ((slot = pop_slot()) == NULL) {
         expand_pool();
       }
-      T* entry = m_pool->front();
-      m_pool->pop_front();
-      return entry;
+      return reinterpret_cast<T*>(&slot->m_entry);
     }
     
     /**
@@ -171,12 +202,11 @@ class pool_c
      */
     T* acquire_entry(macsim_c* m_simBase) 
     {
-      if (m_pool->empty()) {
+      slot_s* slot;
+      while ((slot = pop_slot()) == NULL) {
         expand_pool(m_simBase);
       }
-      T* entry = m_pool->front();
-      m_pool->pop_front();
-      return entry;
+      return reinterpret_cast<T*>(&slot->m_entry);
     }
 
     /**
@@ -184,7 +214,22 @@ class pool_c
      */
     void release_entry(T* entry)
     {
-      m_pool->push_front(entry);
+      slot_s* slot = reinterpret_cast<slot_s*>(entry);
+#ifndef NO_DEBUG
+      if (slot->m_free) {
+        fprintf(stderr, "pool %s: entry %p released twice\n", m_name.c_str(), (void*)entry);
+        abort();
+      }
+#endif
+      slot->m_free = true;
+
+      if (m_thread_cache) {
+        push_cached(slot);
+        return;
+      }
+
+      slot->m_next = m_free;
+      m_free = slot;
     }
 
     /**
@@ -192,11 +237,11 @@ class pool_c
      */
     void expand_pool(void)
     {
+      slot_s* chunk = new_chunk();
       for (int ii = 0; ii < m_poolexpand_unit; ++ii) {
-        T* entries = new T;
-        m_pool->push_back(entries);
+        new (&chunk[ii].m_entry) T;
       }
-      m_poolsize += m_poolexpand_unit;
+      add_chunk(chunk);
     }
 
    /**
@@ -205,11 +250,11 @@ class pool_c
      */
     void expand_pool(macsim_c* m_simBase)
     {
+      slot_s* chunk = new_chunk();
       for (int ii = 0; ii < m_poolexpand_unit; ++ii) {
-        T* entries = new T(m_simBase);
-        m_pool->push_back(entries);
+        new (&chunk[ii].m_entry) T(m_simBase);
       }
-      m_poolsize += m_poolexpand_unit;
+      add_chunk(chunk);
     }
 
     /**
@@ -221,13 +266,139 @@ class pool_c
     }
 
   private:
-    list<T*>* m_pool; /**< pool */
-    int       m_poolsize; /**< pool size */
-    int       m_poolexpand_unit; /**< pool expand unit */
-    string    m_name; /**< pool name */
+    /**
+     * Initialize the pool
+     */
+    void init(int pool_expand_unit, string name, int thread_cache)
+    {
+      m_free            = NULL;
+      m_poolsize        = 0;
+      m_poolexpand_unit = pool_expand_unit;
+      m_name            = name;
+      m_thread_cache    = thread_cache;
+      m_id              = thread_cache ? m_num_cached_pool++ : -1;
+    }
+
+    /**
+     * Allocate storage for a chunk of slots
+     */
+    slot_s* new_chunk(void)
+    {
+      return static_cast<slot_s*>(::operator new(sizeof(slot_s) * m_poolexpand_unit));
+    }
+
+    /**
+     * Add a chunk of constructed entries to the free list
+     */
+    void add_chunk(slot_s* chunk)
+    {
+      unique_lock<mutex> lock(m_mutex, defer_lock);
+      if (m_thread_cache)
+        lock.lock();
+
+      // the first slot of the chunk is acquired first
+      for (int ii = m_poolexpand_unit - 1; ii >= 0; --ii) {
+        chunk[ii].m_free = true;
+        chunk[ii].m_next = m_free;
+        m_free = &chunk[ii];
+      }
+      m_chunk.push_back(chunk);
+      m_poolsize += m_poolexpand_unit;
+    }
+
+    /**
+     * Take a slot from the free list (NULL if empty)
+     */
+    slot_s* pop_slot(void)
+    {
+      if (m_thread_cache)
+        return pop_cached();
+
+      slot_s* slot = m_free;
+      if (slot != NULL) {
+        m_free = slot->m_next;
+        slot->m_free = false;
+      }
+      return slot;
+    }
+
+    /**
+     * Thread cache of the pool for the current host thread
+     */
+    cache_s& get_cache(void)
+    {
+      static thread_local vector<cache_s> caches;
+      if (static_cast<int>(caches.size()) <= m_id)
+        caches.resize(m_id + 1, cache_s{NULL, 0});
+      return caches[m_id];
+    }
+
+    /**
+     * Take a slot from the thread cache, refilling it from the pool
+     */
+    slot_s* pop_cached(void)
+    {
+      cache_s& cache = get_cache();
+      if (cache.m_head == NULL) {
+        lock_guard<mutex> lock(m_mutex);
+        while (m_free != NULL && cache.m_size < m_thread_cache) {
+          slot_s* slot = m_free;
+          m_free = slot->m_next;
+          slot->m_next = cache.m_head;
+          cache.m_head = slot;
+          ++cache.m_size;
+        }
+      }
+
+      slot_s* slot = cache.m_head;
+      if (slot != NULL) {
+        cache.m_head = slot->m_next;
+        --cache.m_size;
+        slot->m_free = false;
+      }
+      return slot;
+    }
+
+    /**
+     * Put a slot into the thread cache, returning a batch to the pool when it grows
+     */
+    void push_cached(slot_s* slot)
+    {
+      cache_s& cache = get_cache();
+      slot->m_next = cache.m_head;
+      cache.m_head = slot;
+      ++cache.m_size;
+
+      if (cache.m_size > 2 * m_thread_cache) {
+        lock_guard<mutex> lock(m_mutex);
+        for (int ii = 0; ii < m_thread_cache; ++ii) {
+          slot_s* free_slot = cache.m_head;
+          cache.m_head = free_slot->m_next;
+          free_slot->m_next = m_free;
+          m_free = free_slot;
+        }
+        cache.m_size -= m_thread_cache;
+      }
+    }
+
+  private:
+    slot_s*         m_free; /**< free list */
+    vector<slot_s*> m_chunk; /**< chunks of slots */
+    int             m_poolsize; /**< pool size */
+    int             m_poolexpand_unit; /**< pool expand unit (slots per chunk) */
+    string          m_name; /**< pool name */
+    int             m_thread_cache; /**< thread cache batch size (0: no thread caches) */
+    int             m_id; /**< thread cache index */
+    mutex           m_mutex; /**< protects the free list when thread caches are used */
+
+    static atomic<int> m_num_cached_pool; /**< number of pools with thread caches */
 };
 
 
+template <class T>
+atomic<int> pool_c<T>::m_num_cached_pool(0);
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief hash table class
 ///////////////////////////////////////////////////////////////////////////////////////////////
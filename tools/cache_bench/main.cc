@@ -0,0 +1,121 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : main.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : cache tag lookup microbenchmark
+ *********************************************************************************************/
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "cache.h"
+
+
+// probe a set by walking the cache_entry_c array (original lookup)
+int find_tag_aos(cache_set_c* set, Addr tag)
+{
+  for (int ii = 0; ii < set->m_assoc; ++ii) {
+    cache_entry_c* line = &(set->m_entry[ii]);
+    if (line->m_valid && line->m_tag == tag)
+      return ii;
+  }
+  return -1;
+}
+
+
+int main(int argc, char* argv[])
+{
+  int num_sets   = (argc > 1) ? atoi(argv[1]) : 1024;
+  int assoc      = (argc > 2) ? atoi(argv[2]) : 16;
+  double hit     = (argc > 3) ? atof(argv[3]) : 0.9;
+  int num_probes = (argc > 4) ? atoi(argv[4]) : 10000000;
+
+  if (argc > 5 || num_sets <= 0 || assoc <= 0 || num_probes <= 0) {
+    cout << "usage: cache_bench [num_sets] [assoc] [hit ratio] [probes]\n";
+    exit(0);
+  }
+
+  // fill every way with a distinct tag, leaving one way in eight invalid
+  mt19937_64 rng(0);
+  vector<cache_set_c*> sets;
+  for (int ii = 0; ii < num_sets; ++ii) {
+    cache_set_c* set = new cache_set_c(assoc);
+    for (int jj = 0; jj < assoc; ++jj) {
+      if (rng() % 8)
+        set->set_tag(jj, (static_cast<Addr>(jj) << 20) | ii);
+      else
+        set->clear_tag(jj);
+    }
+    sets.push_back(set);
+  }
+
+  // probe sequence
+  vector<int> probe_set(num_probes);
+  vector<Addr> probe_tag(num_probes);
+  for (int ii = 0; ii < num_probes; ++ii) {
+    probe_set[ii] = rng() % num_sets;
+    Addr way = rng() % assoc;
+    probe_tag[ii] = (static_cast<double>(rng() % 1000) < hit * 1000) ?
+      ((way << 20) | probe_set[ii]) : ((way << 20) | (probe_set[ii] + num_sets));
+  }
+
+  cout << "> sets: " << num_sets << " assoc: " << assoc << " hit ratio: " << hit
+    << " probes: " << num_probes << "\n";
+
+  long checksum[2] = {0, 0};
+  for (int version = 0; version < 2; ++version) {
+    auto start = chrono::steady_clock::now();
+    for (int ii = 0; ii < num_probes; ++ii) {
+      cache_set_c* set = sets[probe_set[ii]];
+      checksum[version] += (version == 0) ? find_tag_aos(set, probe_tag[ii]) :
+        set->find_tag(probe_tag[ii]);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    cout << "> " << ((version == 0) ? "cache_entry_c walk  " : "packed tags (simd)  ")
+      << num_probes / elapsed.count() / 1e6 << " Mprobes/s\n";
+  }
+
+  if (checksum[0] != checksum[1]) {
+    cout << "> error: lookups disagree\n";
+    return 1;
+  }
+
+  for (auto itr = sets.begin(); itr != sets.end(); ++itr)
+    delete *itr;
+
+  return 0;
+}
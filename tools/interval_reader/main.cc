@@ -0,0 +1,122 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : main.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : convert an interval stat file to CSV
+ *********************************************************************************************/
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "interval_stats.h"
+
+
+#define ASSERTM(cond, args...)                                    \
+do {                                                              \
+  if (!(cond)) {                                                  \
+    fprintf(stderr, "%s:%d: ASSERT FAILED ", __FILE__, __LINE__); \
+    fprintf(stderr, "%s\n", #cond);                               \
+    fprintf(stderr, "%s:%d: ASSERT FAILED ", __FILE__, __LINE__); \
+    fprintf(stderr, ## args);                                     \
+    fprintf(stderr, "\n");                                        \
+    exit(15);                                                     \
+  }                                                               \
+} while (0)
+
+
+int main(int argc, char* argv[])
+{
+  bool delta = (argc > 1 && !strcmp(argv[1], "-d"));
+  int arg = delta ? 2 : 1;
+
+  if (argc - arg < 1 || argc - arg > 2) {
+    fprintf(stderr, "usage: interval_reader [-d] <interval stat file> [csv file]\n");
+    exit(0);
+  }
+
+  FILE* in = fopen(argv[arg], "rb");
+  ASSERTM(in, "cannot open %s", argv[arg]);
+
+  FILE* out = (argc - arg == 2) ? fopen(argv[arg + 1], "w") : stdout;
+  ASSERTM(out, "cannot open %s", argv[arg + 1]);
+
+  // schema header
+  char magic[8];
+  uns32 version, num_column;
+  Counter interval;
+  ASSERTM(fread(magic, 1, 8, in) == 8 && !memcmp(magic, INTERVAL_STATS_MAGIC, 8),
+      "%s is not an interval stat file", argv[arg]);
+  ASSERTM(fread(&version, sizeof(version), 1, in) == 1 && version == INTERVAL_STATS_VERSION,
+      "unsupported version");
+  ASSERTM(fread(&num_column, sizeof(num_column), 1, in) == 1 && num_column > 0,
+      "corrupted header");
+  ASSERTM(fread(&interval, sizeof(interval), 1, in) == 1, "corrupted header");
+
+  for (uns32 ii = 0; ii < num_column; ++ii) {
+    uns32 length;
+    ASSERTM(fread(&length, sizeof(length), 1, in) == 1, "corrupted header");
+    string name(length, ' ');
+    ASSERTM(fread(&name[0], 1, length, in) == length, "corrupted header");
+    fprintf(out, "%s%s", ii ? "," : "", name.c_str());
+  }
+  fprintf(out, "\n");
+
+  // blocks of snapshots, column by column
+  vector<Counter> block;
+  vector<Counter> prev(num_column, 0);
+  uns32 num_row;
+  while (fread(&num_row, sizeof(num_row), 1, in) == 1) {
+    block.resize(static_cast<size_t>(num_row) * num_column);
+    ASSERTM(fread(block.data(), sizeof(Counter), block.size(), in) == block.size(),
+        "truncated block");
+
+    for (uns32 row = 0; row < num_row; ++row) {
+      for (uns32 col = 0; col < num_column; ++col) {
+        Counter value = block[col * num_row + row];
+        fprintf(out, "%s%llu", col ? "," : "",
+            static_cast<unsigned long long>(delta ? value - prev[col] : value));
+        prev[col] = value;
+      }
+      fprintf(out, "\n");
+    }
+  }
+
+  fclose(in);
+  if (out != stdout)
+    fclose(out);
+
+  return 0;
+}
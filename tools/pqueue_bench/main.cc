@@ -0,0 +1,228 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of
+conditions and the following disclaimer in the documentation and/or other materials provided
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors
+may be used to endorse or promote products derived from this software without specific prior
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : main.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : priority queue microbenchmark
+ *********************************************************************************************/
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+
+#include "pqueue.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Original pqueue_c: each slot is a std::list sorted by priority
+///////////////////////////////////////////////////////////////////////////////////////////////
+template <class T>
+class list_pqueue_c
+{
+  typedef struct pqueue_entry_s {
+    int64_t m_priority;
+    T m_data;
+  } pqueue_entry_s;
+
+  public:
+    list_pqueue_c(int size, int latency)
+    {
+      m_capacity      = size;
+      m_last_index    = latency;
+      m_current_index = 0;
+      m_num_entry     = 0;
+      m_size          = latency + 1;
+
+      m_entry = new list<pqueue_entry_s*>[m_size];
+      m_entry_pool = new pool_c<pqueue_entry_s>(100, "list_pqueue_entry_pool");
+    }
+
+    bool ready()
+    {
+      return !m_entry[m_current_index].empty();
+    }
+
+    bool enqueue(int64_t priority, const T& data)
+    {
+      m_num_entry++;
+
+      pqueue_entry_s* new_entry = m_entry_pool->acquire_entry();
+      new_entry->m_data     = data;
+      new_entry->m_priority = priority;
+
+      for (auto I = m_entry[m_last_index].begin(), E = m_entry[m_last_index].end(); 
+          I != E; ++I) {
+        if ((*I)->m_priority < priority) {
+          m_entry[m_last_index].insert(I, new_entry);
+          return true;
+        }
+      }
+
+      m_entry[m_last_index].push_back(new_entry);
+      return true;
+    }
+
+    T dequeue(void)
+    {
+      pqueue_entry_s* entry = m_entry[m_current_index].front();
+      T data = entry->m_data;
+
+      m_entry[m_current_index].pop_front();
+      m_entry_pool->release_entry(entry);
+      --m_num_entry;
+
+      return data;
+    }
+
+    bool advance()
+    {
+      if (m_num_entry == 0)
+        return true;
+
+      if (!m_entry[m_current_index].empty())
+        return true;
+
+      m_last_index    = m_current_index;
+      m_current_index = (m_current_index + 1) % m_size;
+
+      return true;
+    }
+
+    int space()
+    {
+      return m_capacity - m_num_entry;
+    }
+
+  private:
+    list<pqueue_entry_s*>* m_entry;
+    pool_c<pqueue_entry_s>* m_entry_pool;
+    int m_size;
+    int m_capacity;
+    int m_num_entry;
+    int m_last_index;
+    int m_current_index;
+};
+
+
+/**
+ * Queue configuration from a MacSim parameter file
+ */
+typedef struct bench_config_s {
+  const char* m_name; /**< queue name */
+  int m_capacity; /**< queue capacity */
+  int m_latency; /**< queue latency */
+  int m_width; /**< pipeline width */
+} bench_config_s;
+
+
+// step a queue for a number of cycles; the checksum depends on the dequeue order
+template <class Q>
+unsigned long run(Q* queue, const bench_config_s& config, long num_cycles, double stall,
+    int num_priority)
+{
+  unsigned long checksum = 0;
+  unsigned long rng = 88172645463325252ULL;
+  int value = 0;
+  int stall_threshold = static_cast<int>(stall * 1024);
+
+  for (long cycle = 0; cycle < num_cycles; ++cycle) {
+    // xorshift, same sequence for every queue implementation
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+
+    for (int ii = 0; ii < config.m_width && queue->space() > 0; ++ii)
+      queue->enqueue((rng >> (8 * ii)) % num_priority, value++);
+
+    if (static_cast<int>((rng >> 40) % 1024) >= stall_threshold) {
+      for (int ii = 0; ii < config.m_width && queue->ready(); ++ii)
+        checksum = checksum * 31 + queue->dequeue();
+    }
+
+    queue->advance();
+  }
+
+  return checksum;
+}
+
+
+int main(int argc, char* argv[])
+{
+  long num_cycles  = (argc > 1) ? atol(argv[1]) : 10000000;
+  double stall     = (argc > 2) ? atof(argv[2]) : 0.5;
+  int num_priority = (argc > 3) ? atoi(argv[3]) : 1;
+
+  if (argc > 4 || num_cycles <= 0 || stall < 0 || stall > 1 || num_priority <= 0) {
+    cout << "usage: pqueue_bench [cycles] [stall ratio] [priorities]\n";
+    exit(0);
+  }
+
+  // params_x86 (large core) and params_gtx580 with the default queue sizes
+  bench_config_s configs[] = {
+    {"x86 q_frontend   ", 256, 15, 4},
+    {"x86 q_iaq        ",  32,  0, 4},
+    {"gtx580 q_frontend", 256, 10, 1},
+    {"gtx580 q_iaq     ",  32,  0, 1},
+  };
+
+  cout << "> cycles: " << num_cycles << " stall ratio: " << stall
+    << " priorities: " << num_priority << "\n";
+
+  for (auto& config : configs) {
+    double mcycles[2];
+    unsigned long checksum[2];
+    for (int version = 0; version < 2; ++version) {
+      auto start = chrono::steady_clock::now();
+      if (version == 0) {
+        list_pqueue_c<int> queue(config.m_capacity, config.m_latency);
+        checksum[version] = run(&queue, config, num_cycles, stall, num_priority);
+      }
+      else {
+        pqueue_c<int> queue(config.m_capacity, config.m_latency, "bench", NULL);
+        checksum[version] = run(&queue, config, num_cycles, stall, num_priority);
+      }
+      chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+      mcycles[version] = num_cycles / elapsed.count() / 1e6;
+    }
+
+    cout << "> " << config.m_name << "  list: " << mcycles[0] << " Mcycles/s  bucketed: "
+      << mcycles[1] << " Mcycles/s\n";
+
+    if (checksum[0] != checksum[1]) {
+      cout << "> error: dequeue order differs\n";
+      return 1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : main.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : convert gzip traces to memory-mapped (uncompressed) traces
+ *********************************************************************************************/
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <zlib.h>
+
+#include "trace_read.h"
+#include "trace_prefetch.h"
+
+
+#define ASSERTM(cond, args...)                                    \
+do {                                                              \
+  if (!(cond)) {                                                  \
+    fprintf(stderr, "%s:%d: ASSERT FAILED ", __FILE__, __LINE__); \
+    fprintf(stderr, "%s\n", #cond);                               \
+    fprintf(stderr, "%s:%d: ASSERT FAILED ", __FILE__, __LINE__); \
+    fprintf(stderr, ## args);                                     \
+    fprintf(stderr, "\n");                                        \
+    exit(15);                                                     \
+  }                                                               \
+} while (0)
+
+
+// record size of a trace type (see trace_read_c::m_trace_size)
+int get_record_size(const string& type)
+{
+  if (type == "x86" || type == "a64" || type == "igpu")
+    return CPU_TRACE_SIZE;
+  else if (type == "ptx" || type == "newptx")
+    return GPU_TRACE_SIZE;
+
+  return 0;
+}
+
+
+// check whether a file has already been converted
+bool is_converted(const string& filename)
+{
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (file == NULL)
+    return false;
+
+  trace_file_header_s header;
+  bool converted = fread(&header, sizeof(header), 1, file) == 1 &&
+    memcmp(header.m_magic, TRACE_FILE_MAGIC, sizeof(header.m_magic)) == 0;
+  fclose(file);
+
+  return converted;
+}
+
+
+uint64_t convert(const string& in_filename, const string& out_filename, int record_size)
+{
+  gzFile gztrace = gzopen(in_filename.c_str(), "r");
+  ASSERTM(gztrace != NULL, "cannot open %s", in_filename.c_str());
+
+  FILE* out = fopen(out_filename.c_str(), "wb");
+  ASSERTM(out != NULL, "cannot create %s", out_filename.c_str());
+
+  // the header is rewritten once the number of records is known
+  trace_file_header_s header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.m_magic, TRACE_FILE_MAGIC, sizeof(header.m_magic));
+  header.m_version     = TRACE_FILE_VERSION;
+  header.m_record_size = record_size;
+  ASSERTM(fwrite(&header, sizeof(header), 1, out) == 1, "cannot write %s", out_filename.c_str());
+
+  const int trace_buffer_size = 100000;
+  char* trace_buffer = new char[trace_buffer_size * record_size];
+  uint64_t num_records = 0;
+  int remain = 0;
+  while (1) {
+    int bytes_read = gzread(gztrace, trace_buffer, trace_buffer_size * record_size);
+    ASSERTM(bytes_read >= 0, "error reading %s", in_filename.c_str());
+
+    int count = bytes_read / record_size;
+    remain = bytes_read % record_size;
+    ASSERTM(fwrite(trace_buffer, record_size, count, out) == static_cast<size_t>(count),
+        "cannot write %s", out_filename.c_str());
+    num_records += count;
+
+    if (bytes_read != trace_buffer_size * record_size)
+      break;
+  }
+
+  if (remain)
+    cout << "> warning: " << in_filename << " ends with a partial record (" << remain
+      << " bytes dropped)\n";
+
+  header.m_num_records = num_records;
+  ASSERTM(fseek(out, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, out) == 1,
+      "cannot write %s", out_filename.c_str());
+
+  delete[] trace_buffer;
+  gzclose(gztrace);
+  ASSERTM(fclose(out) == 0, "cannot write %s", out_filename.c_str());
+
+  return num_records;
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3) {
+    cout << "usage: trace_converter <x86|a64|igpu|ptx|newptx> <trace .raw> [output file]\n";
+    cout << "  without an output file, the trace is converted in place\n";
+    exit(0);
+  }
+
+  string type(argv[1]);
+  string in_filename(argv[2]);
+
+  int record_size = get_record_size(type);
+  ASSERTM(record_size != 0, "unknown trace type %s", type.c_str());
+
+  if (is_converted(in_filename)) {
+    cout << "> " << in_filename << " is already converted\n";
+    return 0;
+  }
+
+  string out_filename = (argc > 3) ? string(argv[3]) : in_filename + ".tmp";
+  uint64_t num_records = convert(in_filename, out_filename, record_size);
+
+  if (argc == 3) {
+    ASSERTM(rename(out_filename.c_str(), in_filename.c_str()) == 0, "cannot replace %s",
+        in_filename.c_str());
+    out_filename = in_filename;
+  }
+
+  cout << "> " << out_filename << " : " << num_records << " records of " << record_size
+    << " bytes\n";
+
+  return 0;
+}
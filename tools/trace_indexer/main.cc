@@ -0,0 +1,222 @@
+/*
+Copyright (c) <2012>, <Georgia Institute of Technology> All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted 
+provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list of conditions 
+and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this list of 
+conditions and the following disclaimer in the documentation and/or other materials provided 
+with the distribution.
+
+Neither the name of the <Georgia Institue of Technology> nor the names of its contributors 
+may be used to endorse or promote products derived from this software without specific prior 
+written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY 
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR 
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/**********************************************************************************************
+ * File         : main.cc
+ * Author       : HPArch Research Group
+ * Date         : 10/17/2026
+ * Description  : build a random-access index of a gzip trace
+ *********************************************************************************************/
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#include "trace_read.h"
+#include "trace_prefetch.h"
+
+
+#define ASSERTM(cond, args...)                                    \
+do {                                                              \
+  if (!(cond)) {                                                  \
+    fprintf(stderr, "%s:%d: ASSERT FAILED ", __FILE__, __LINE__); \
+    fprintf(stderr, "%s\n", #cond);                               \
+    fprintf(stderr, "%s:%d: ASSERT FAILED ", __FILE__, __LINE__); \
+    fprintf(stderr, ## args);                                     \
+    fprintf(stderr, "\n");                                        \
+    exit(15);                                                     \
+  }                                                               \
+} while (0)
+
+
+// default distance between access points in records
+#define DEFAULT_SPAN 100000
+
+
+// record size of a trace type (see trace_read_c::m_trace_size)
+int get_record_size(const string& type)
+{
+  if (type == "x86" || type == "a64" || type == "igpu")
+    return CPU_TRACE_SIZE;
+  else if (type == "ptx" || type == "newptx")
+    return GPU_TRACE_SIZE;
+
+  return 0;
+}
+
+
+// Decompress the whole trace and add an access point at the first deflate block boundary
+// after every span bytes of output. Each point keeps the last 32KB of output (the window)
+// that decompression needs to restart there.
+uint64_t build_index(const string& filename, vector<trace_index_point_s>& points, 
+    vector<char>& windows, uint64_t span)
+{
+  FILE* in = fopen(filename.c_str(), "rb");
+  ASSERTM(in != NULL, "cannot open %s", filename.c_str());
+
+  // gzip or zlib header
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  ASSERTM(inflateInit2(&strm, 47) == Z_OK, "cannot initialize zlib");
+
+  const int input_size = 1 << 16;
+  unsigned char* input = new unsigned char[input_size];
+  unsigned char* window = new unsigned char[TRACE_INDEX_WINDOW];
+
+  uint64_t total_in = 0;
+  uint64_t total_out = 0;
+  uint64_t last = 0;
+  int result = Z_OK;
+  strm.avail_out = 0;
+  do {
+    strm.avail_in = fread(input, 1, input_size, in);
+    ASSERTM(strm.avail_in > 0 && !ferror(in), "%s is truncated or unreadable", 
+        filename.c_str());
+    strm.next_in = input;
+
+    do {
+      // output goes to a circular window
+      if (strm.avail_out == 0) {
+        strm.avail_out = TRACE_INDEX_WINDOW;
+        strm.next_out  = window;
+      }
+
+      total_in  += strm.avail_in;
+      total_out += strm.avail_out;
+      result = inflate(&strm, Z_BLOCK);
+      total_in  -= strm.avail_in;
+      total_out -= strm.avail_out;
+      ASSERTM(result == Z_OK || result == Z_STREAM_END, "%s is corrupted (%d)", 
+          filename.c_str(), result);
+      if (result == Z_STREAM_END)
+        break;
+
+      // end of a deflate block that is not the last one (or end of the header)
+      if ((strm.data_type & 128) && !(strm.data_type & 64) && 
+          (total_out == 0 || total_out - last > span)) {
+        trace_index_point_s point;
+        memset(&point, 0, sizeof(point));
+        point.m_out  = total_out;
+        point.m_in   = total_in;
+        point.m_bits = strm.data_type & 7;
+        points.push_back(point);
+
+        size_t offset = windows.size();
+        windows.resize(offset + TRACE_INDEX_WINDOW);
+        unsigned left = strm.avail_out;
+        if (left)
+          memcpy(&windows[offset], window + TRACE_INDEX_WINDOW - left, left);
+        if (left < TRACE_INDEX_WINDOW)
+          memcpy(&windows[offset + left], window, TRACE_INDEX_WINDOW - left);
+
+        last = total_out;
+      }
+    } while (strm.avail_in != 0);
+  } while (result != Z_STREAM_END);
+
+  // the simulator stops at the end of the first gzip member as well
+  if (strm.avail_in != 0 || fgetc(in) != EOF)
+    cout << "> warning: " << filename << " has data after the first gzip member (not indexed)\n";
+
+  inflateEnd(&strm);
+  delete[] input;
+  delete[] window;
+  fclose(in);
+
+  return total_out;
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3) {
+    cout << "usage: trace_indexer <x86|a64|igpu|ptx|newptx> <trace .raw> [span]\n";
+    cout << "  writes <trace .raw>.idx with an access point every span records (default "
+      << DEFAULT_SPAN << ")\n";
+    exit(0);
+  }
+
+  string type(argv[1]);
+  string filename(argv[2]);
+  uint64_t span = (argc > 3) ? strtoull(argv[3], NULL, 10) : DEFAULT_SPAN;
+
+  int record_size = get_record_size(type);
+  ASSERTM(record_size != 0, "unknown trace type %s", type.c_str());
+  ASSERTM(span > 0, "invalid span %s", argv[3]);
+
+  FILE* file = fopen(filename.c_str(), "rb");
+  ASSERTM(file != NULL, "cannot open %s", filename.c_str());
+  trace_file_header_s trace_header;
+  bool converted = fread(&trace_header, sizeof(trace_header), 1, file) == 1 &&
+    memcmp(trace_header.m_magic, TRACE_FILE_MAGIC, sizeof(trace_header.m_magic)) == 0;
+  fclose(file);
+  if (converted) {
+    cout << "> " << filename << " is an uncompressed trace and needs no index\n";
+    return 0;
+  }
+
+  vector<trace_index_point_s> points;
+  vector<char> windows;
+  uint64_t size = build_index(filename, points, windows, span * record_size);
+
+  struct stat file_stat;
+  ASSERTM(stat(filename.c_str(), &file_stat) == 0, "cannot stat %s", filename.c_str());
+
+  trace_index_header_s header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.m_magic, TRACE_INDEX_MAGIC, sizeof(header.m_magic));
+  header.m_version     = TRACE_INDEX_VERSION;
+  header.m_record_size = record_size;
+  header.m_num_points  = points.size();
+  header.m_num_records = size / record_size;
+  header.m_file_size   = file_stat.st_size;
+
+  string index_filename = filename + ".idx";
+  FILE* out = fopen(index_filename.c_str(), "wb");
+  ASSERTM(out != NULL, "cannot create %s", index_filename.c_str());
+  ASSERTM(fwrite(&header, sizeof(header), 1, out) == 1 &&
+      fwrite(&points[0], sizeof(trace_index_point_s), points.size(), out) == points.size() &&
+      fwrite(&windows[0], 1, windows.size(), out) == windows.size(),
+      "cannot write %s", index_filename.c_str());
+  ASSERTM(fclose(out) == 0, "cannot write %s", index_filename.c_str());
+
+  if (size % record_size)
+    cout << "> warning: " << filename << " ends with a partial record\n";
+
+  cout << "> " << index_filename << " : " << header.m_num_records << " records, "
+    << points.size() << " access points\n";
+
+  return 0;
+}